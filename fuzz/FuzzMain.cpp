@@ -0,0 +1,62 @@
+/*
+ * Stand-in for the libFuzzer driver: runs LLVMFuzzerTestOneInput once per
+ * file (or per file in each directory) named on the command line, or once on
+ * standard input when there are none. Lets GCC builds replay a corpus or a
+ * crash file, and serves as the target for AFL (afl-fuzz ... -- program @@).
+ */
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static std::vector<uint8_t> readAll(FILE* f) {
+    std::vector<uint8_t> bytes;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) bytes.insert(bytes.end(), chunk, chunk + n);
+    return bytes;
+}
+
+static int runFile(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        fprintf(stderr, "cannot open %s\n", path.c_str());
+        return 1;
+    }
+    std::vector<uint8_t> bytes = readAll(f);
+    fclose(f);
+    LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::vector<uint8_t> bytes = readAll(stdin);
+        LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+        return 0;
+    }
+
+    int failures = 0;
+    size_t runs = 0;
+    for (int i = 1; i < argc; i++) {
+        struct stat st;
+        if (stat(argv[i], &st) == 0 && S_ISDIR(st.st_mode)) {
+            DIR* dir = opendir(argv[i]);
+            while (dirent* entry = dir ? readdir(dir) : nullptr) {
+                if (entry->d_name[0] == '.') continue;
+                failures += runFile(std::string(argv[i]) + "/" + entry->d_name);
+                runs++;
+            }
+            if (dir) closedir(dir);
+        } else {
+            failures += runFile(argv[i]);
+            runs++;
+        }
+    }
+    printf("Executed %zu inputs\n", runs);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * libFuzzer harness for E131Handler::parsePacket(). Each input is one UDP
+ * datagram, delivered through the fake W5500 exactly as the network task
+ * would receive it.
+ *
+ * Besides ASan/UBSan findings, the harness aborts if the parser reports more
+ * slots than a universe holds, writes past the length it returned, or returns
+ * bytes other than the ones that followed the header.
+ */
+#include <Arduino.h>
+#include <HostShims.h>
+#include <string.h>
+#include "E131Handler.h"
+
+#define GUARD_BYTE 0xEE
+#define GUARD_SIZE 64
+
+static E131Handler* eth;
+
+static void init() {
+    HostSerial::setEcho(0, false);
+    static byte mac[] = DEFAULT_MAC;
+    eth = new E131Handler();
+    eth->begin(mac, IPAddress(DEFAULT_IP));
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (!eth) init();
+
+    // Follow the universe in the input, so mutations get past the filter
+    // and reach the length handling; the filter itself is a single compare.
+    if (size >= E131_UNIVERSE_OFFSET + 2) {
+        eth->setUniverse((data[E131_UNIVERSE_OFFSET] << 8) | data[E131_UNIVERSE_OFFSET + 1]);
+    }
+
+    static uint8_t dmx[DMX_MAX_CHANNELS + GUARD_SIZE];
+    memset(dmx, GUARD_BYTE, sizeof(dmx));
+
+    HostNet::inject(E131_PORT, data, size);
+    int len = eth->parsePacket(dmx);
+
+    if (len < 0 || len > DMX_MAX_CHANNELS) abort();
+    if ((size_t)len > 0 && (size < E131_HEADER_SIZE + (size_t)len ||
+                            memcmp(dmx, data + E131_HEADER_SIZE, len) != 0)) {
+        abort();
+    }
+    for (size_t i = len; i < sizeof(dmx); i++) {
+        if (dmx[i] != GUARD_BYTE) abort();
+    }
+
+    // Nothing may be left queued for the next input
+    if (HostNet::pending(E131_PORT) != 0) abort();
+    return 0;
+}
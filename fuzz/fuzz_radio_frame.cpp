@@ -0,0 +1,100 @@
+/*
+ * libFuzzer harness for the HC-12 frame codec.
+ *
+ * The input is used two ways:
+ *  - as a payload: encode() then decode() must give it back unchanged, and
+ *    any single corrupted data byte must fail the checksum;
+ *  - as a received frame: decode() must never read or write out of bounds,
+ *    and anything it accepts must re-encode to the identical bytes;
+ *  - as a UART stream: a full-size and a small RadioFrameDecoder must stay
+ *    in step, agree on every frame, and agree with decode() on the input as
+ *    a whole.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "RadioFrame.h"
+
+#define FRAME_MAX (RADIO_FRAME_MAX_PAYLOAD + RADIO_FRAME_OVERHEAD)
+
+template <typename T> static T min(T a, T b) { return a < b ? a : b; }
+
+static void roundTrip(const uint8_t* data, size_t size) {
+    uint8_t frame[FRAME_MAX];
+    uint8_t payload[RADIO_FRAME_MAX_PAYLOAD];
+
+    size_t frameSize = RadioFrame::encode(data, (uint16_t)min<size_t>(size, 0xFFFF), frame, sizeof(frame));
+    if (size > RADIO_FRAME_MAX_PAYLOAD) {
+        if (frameSize != 0) abort();
+        return;
+    }
+    if (frameSize != size + RADIO_FRAME_OVERHEAD) abort();
+
+    int len = RadioFrame::decode(frame, frameSize, payload, sizeof(payload));
+    if (len != (int)size || (size > 0 && memcmp(payload, data, size) != 0)) abort();
+
+    // Undersized output buffers are refused, not overrun
+    if (RadioFrame::encode(data, size, frame, frameSize - 1) != 0) abort();
+    if (size > 0 && RadioFrame::decode(frame, frameSize, payload, size - 1) != -1) abort();
+
+    // XOR catches every single-byte data error
+    if (size > 0) {
+        size_t at = data[0] % size;
+        frame[2 + at] ^= 0x5A;
+        if (RadioFrame::decode(frame, frameSize, payload, sizeof(payload)) != -1) abort();
+    }
+}
+
+static void decodeRaw(const uint8_t* data, size_t size) {
+    // Exact-size heap copy so ASan sees any read past the frame
+    uint8_t* frame = (uint8_t*)malloc(size ? size : 1);
+    if (size > 0) memcpy(frame, data, size);
+
+    uint8_t payload[RADIO_FRAME_MAX_PAYLOAD];
+    int len = RadioFrame::decode(frame, size, payload, sizeof(payload));
+    if (len >= 0) {
+        uint8_t reencoded[FRAME_MAX];
+        size_t n = RadioFrame::encode(payload, len, reencoded, sizeof(reencoded));
+        if (n != size || memcmp(reencoded, frame, size) != 0) abort();
+    }
+    free(frame);
+}
+
+static void decodeStream(const uint8_t* data, size_t size) {
+    RadioFrameDecoder<> full;
+    RadioFrameDecoder<16> small;
+    RadioFrameResult last = RADIO_FRAME_NONE;
+
+    for (size_t i = 0; i < size; i++) {
+        last = full.feed(data[i]);
+        RadioFrameResult s = small.feed(data[i]);
+        if (full.inFrame() != small.inFrame()) abort();
+
+        if (last == RADIO_FRAME_OK) {
+            if (full.length() <= 16) {
+                if (s != RADIO_FRAME_OK || small.length() != full.length()) abort();
+                if (full.length() > 0 && memcmp(small.payload(), full.payload(), full.length()) != 0) abort();
+            } else if (s != RADIO_FRAME_TOO_LONG) {
+                abort();
+            }
+        } else if (last == RADIO_FRAME_BAD_CHECKSUM) {
+            if (s != RADIO_FRAME_BAD_CHECKSUM && s != RADIO_FRAME_TOO_LONG) abort();
+        } else if (s != RADIO_FRAME_NONE) {
+            abort();
+        }
+    }
+
+    // A stream that is exactly one valid frame decodes to the same payload
+    uint8_t payload[RADIO_FRAME_MAX_PAYLOAD];
+    int len = RadioFrame::decode(data, size, payload, sizeof(payload));
+    if (len >= 0) {
+        if (last != RADIO_FRAME_OK || full.length() != len) abort();
+        if (len > 0 && memcmp(full.payload(), payload, len) != 0) abort();
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    roundTrip(data, size);
+    decodeRaw(data, size);
+    decodeStream(data, size);
+    return 0;
+}
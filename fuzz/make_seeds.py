@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""
+Write the seed corpora for the fuzz harnesses.
+
+  fuzz/make_seeds.py                    regenerate fuzz/corpus/{e131,radio_frame}
+  fuzz/make_seeds.py --pcap show.pcap   also import every UDP/5568 payload
+                                        from a capture (classic pcap, Ethernet
+                                        or Linux cooked link type)
+
+The synthetic E1.31 seeds follow the packets that common consoles and
+sACN tools put on the wire: full and partial universes, preview and
+terminated options, sync addresses, per-address priority (0xDD) and the
+E1.31 sync and universe discovery packets the firmware has to ignore.
+"""
+import argparse
+import hashlib
+import os
+import struct
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+E131_PORT = 5568
+ACN_ID = b"ASC-E1.17\x00\x00\x00"
+CID = bytes.fromhex("5c1e3a9076d24a0bb4f3c2a1d0e9f8a7")
+
+
+def flags_length(length):
+    return struct.pack(">H", 0x7000 | length)
+
+
+def data_packet(universe, slots, start_code=0, sequence=1, priority=100,
+                options=0, sync=0, source=b"CrowdLight seed"):
+    dmp = (b"\x02\xa1" + struct.pack(">HHH", 0, 1, len(slots) + 1)
+           + bytes([start_code]) + bytes(slots))
+    dmp = flags_length(len(dmp) + 2) + dmp
+    framing = (struct.pack(">I", 0x00000002) + source.ljust(64, b"\x00")
+               + bytes([priority]) + struct.pack(">H", sync)
+               + bytes([sequence & 0xFF, options]) + struct.pack(">H", universe) + dmp)
+    framing = flags_length(len(framing) + 2) + framing
+    root = struct.pack(">I", 0x00000004) + CID + framing
+    return struct.pack(">HH", 0x0010, 0) + ACN_ID + flags_length(len(root) + 2) + root
+
+
+def sync_packet(sync_universe, sequence=1):
+    framing = struct.pack(">I", 0x00000001) + bytes([sequence]) + struct.pack(">H", sync_universe) + b"\x00\x00"
+    framing = flags_length(len(framing) + 2) + framing
+    root = struct.pack(">I", 0x00000008) + CID + framing
+    return struct.pack(">HH", 0x0010, 0) + ACN_ID + flags_length(len(root) + 2) + root
+
+
+def discovery_packet(universes):
+    body = struct.pack(">I", 0x00000001) + b"\x00\x00" + b"".join(struct.pack(">H", u) for u in universes)
+    body = flags_length(len(body) + 2) + body
+    framing = (struct.pack(">I", 0x00000002) + b"CrowdLight seed".ljust(64, b"\x00")
+               + b"\x00\x00\x00\x00" + body)
+    framing = flags_length(len(framing) + 2) + framing
+    root = struct.pack(">I", 0x00000008) + CID + framing
+    return struct.pack(">HH", 0x0010, 0) + ACN_ID + flags_length(len(root) + 2) + root
+
+
+def e131_seeds():
+    ramp = [i & 0xFF for i in range(512)]
+    rgb = [v for i in range(50) for v in (255, i * 5, 0)]
+    return {
+        "full_universe": data_packet(1, ramp),
+        "fifty_rgb": data_packet(1, rgb, sequence=42),
+        "blackout": data_packet(1, [0] * 512),
+        "single_slot": data_packet(1, [255]),
+        "start_code_only": data_packet(1, []),
+        "universe_300": data_packet(300, rgb),
+        "preview": data_packet(1, rgb, options=0x80),
+        "terminated": data_packet(1, rgb, options=0x40, sequence=255),
+        "synchronized": data_packet(1, rgb, sync=7000),
+        "per_address_priority": data_packet(1, [100] * 512, start_code=0xDD),
+        "sync": sync_packet(7000),
+        "discovery": discovery_packet([1, 2, 300]),
+    }
+
+
+def radio_seeds():
+    rgb = bytes(v for i in range(50) for v in (255, i * 5, 0))
+    payloads = {
+        "payload_empty": b"",
+        "payload_rgb": rgb,
+        "payload_max": bytes(range(255)),
+        "payload_start_bytes": b"\xaa" * 16,
+    }
+    seeds = dict(payloads)
+    for name, payload in payloads.items():
+        checksum = 0xAA
+        for b in payload:
+            checksum ^= b
+        seeds[name.replace("payload", "frame")] = b"\xaa" + bytes([len(payload)]) + payload + bytes([checksum])
+    return seeds
+
+
+def pcap_payloads(path):
+    """UDP payloads sent to E131_PORT, from a classic little/big-endian pcap."""
+    with open(path, "rb") as f:
+        data = f.read()
+    magic = data[:4]
+    if magic in (b"\xd4\xc3\xb2\xa1", b"\x4d\x3c\xb2\xa1"):
+        endian = "<"
+    elif magic in (b"\xa1\xb2\xc3\xd4", b"\xa1\xb2\x3c\x4d"):
+        endian = ">"
+    else:
+        raise SystemExit(f"{path}: not a classic pcap file (pcapng is not supported)")
+    linktype = struct.unpack(endian + "I", data[20:24])[0]
+    link_header = {1: 14, 113: 16}.get(linktype)
+    if link_header is None:
+        raise SystemExit(f"{path}: unsupported link type {linktype}")
+
+    offset = 24
+    while offset + 16 <= len(data):
+        incl = struct.unpack(endian + "I", data[offset + 8:offset + 12])[0]
+        frame = data[offset + 16:offset + 16 + incl]
+        offset += 16 + incl
+        ethertype = frame[link_header - 2:link_header]
+        ip = frame[link_header:]
+        if ethertype != b"\x08\x00" or len(ip) < 20 or ip[9] != 17:
+            continue
+        udp = ip[(ip[0] & 0x0F) * 4:]
+        if len(udp) < 8 or struct.unpack(">H", udp[2:4])[0] != E131_PORT:
+            continue
+        yield udp[8:struct.unpack(">H", udp[4:6])[0]]
+
+
+def write(corpus, name, data):
+    os.makedirs(corpus, exist_ok=True)
+    with open(os.path.join(corpus, name), "wb") as f:
+        f.write(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--pcap", action="append", default=[], help="capture to import into the E1.31 corpus")
+    args = parser.parse_args()
+
+    e131 = os.path.join(HERE, "corpus", "e131")
+    for name, data in e131_seeds().items():
+        write(e131, name, data)
+    for name, data in radio_seeds().items():
+        write(os.path.join(HERE, "corpus", "radio_frame"), name, data)
+
+    for path in args.pcap:
+        count = 0
+        for payload in pcap_payloads(path):
+            # Content-named, so re-importing a capture adds no duplicates
+            write(e131, "pcap_" + hashlib.sha1(payload).hexdigest()[:16], payload)
+            count += 1
+        print(f"{path}: {count} sACN datagrams")
+
+
+if __name__ == "__main__":
+    main()
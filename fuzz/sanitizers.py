@@ -0,0 +1,10 @@
+# PlatformIO pre-script for the fuzz_* environments: build everything with
+# clang, libFuzzer coverage and ASan/UBSan. build_flags alone would leave the
+# sanitizers off the link line.
+Import("env")
+
+flags = ["-fsanitize=fuzzer,address,undefined", "-fno-sanitize-recover=undefined",
+         "-fno-omit-frame-pointer"]
+
+env.Replace(CC="clang", CXX="clang++", LINK="clang++", AR="llvm-ar", RANLIB="llvm-ranlib")
+env.Append(CCFLAGS=flags, LINKFLAGS=flags)
@@ -1,7 +1,7 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
-#include <Arduino.h>
+#include <stdint.h>
 
 // ============================================================================
 // LOGGING CONFIGURATION
@@ -22,6 +22,62 @@
 // Uncomment to run logger self-tests on boot
 // #define DEBUG_TESTS
 
+// ============================================================================
+// DIAGNOSTICS
+// ============================================================================
+
+#define LATENCY_TRACE_ENABLE true    // Per-frame UDP -> radio latency tracing
+#define LATENCY_TRACE_RING_SIZE 256  // Frames kept for percentile reports
+#define CONSOLE_MAX_COMMANDS 16      // Serial console command table size
+#define CONSOLE_LINE_LENGTH 64       // Max console input line
+#define TASK_MONITOR_PERIOD_MS 2000  // Core load and task stack sampling interval
+#define TASK_MONITOR_MAX_TASKS 24    // Tasks tracked per sample
+#define TASK_MONITOR_STACK_WARN_BYTES 512  // Warn when a stack has less headroom
+#define TASK_MONITOR_CPU_WARN_PCT 90 // Warn when a core is busier than this
+#define TASK_MONITOR_IDLE_GAP_US 20  // Longer gaps between idle-hook passes count as busy
+#ifndef TASK_MONITOR_CORE_LOAD
+#define TASK_MONITOR_CORE_LOAD false // Per-core load via idle hooks; keeps the cores out of WAITI
+#endif
+#define BENCH_MAX_CASES 24           // Registered microbenchmarks
+#define BENCH_MIN_TIME_US 100000     // Each repetition runs at least this long
+#define BENCH_REPETITIONS 3          // Fastest repetition is reported
+#define BENCH_MEM_INTERNAL_BYTES 16384   // Internal RAM span for the memory cases
+#define BENCH_MEM_PSRAM_BYTES 1048576    // PSRAM span, well past the data cache
+#define BENCH_NVS_STACK 3072         // Flash writer task of the packet/path_nvs case
+#define HEAP_GUARD_MAX_TASKS 4       // Tasks whose steady-state allocations are counted
+#define HEAP_GUARD_ASSERT false      // Abort on the first one (HEAP_GUARD builds, see HeapGuard.h)
+#define MEM_PLACEMENT_MAX_BLOCKS 8   // Boot-time allocations tracked by MemPlacement
+#define MEM_COLD_INTERNAL_MAX 16384  // Largest cold block that may fall back to internal RAM
+#define FRAME_HISTORY_SECONDS 300    // Sent frames kept for replay and diagnostics
+#define FRAME_HISTORY_MAX_FPS 44     // Frame rate the history is sized for (DMX refresh ceiling)
+#define FRAME_HISTORY_FALLBACK_FRAMES 64  // History length without PSRAM
+
+// ============================================================================
+// TASKS (stack sizes in bytes)
+// ============================================================================
+
+#define NET_TASK_STACK 10000
+#define DISP_TASK_STACK 10000
+#define INPUT_TASK_STACK 4096
+#define MON_TASK_STACK 3072
+#define DISP_FLUSH_TASK_STACK 3072
+#define CONFIG_TASK_STACK 4096       // Config write-behind: NVS commit plus a log line
+
+// Hot path placement, see HotPath.h (env:hotpath_baseline builds without)
+#ifndef HOT_PATH_IRAM
+#define HOT_PATH_IRAM true           // Per-packet functions in IRAM
+#endif
+#ifndef HOT_BUFFER_ALIGN
+#define HOT_BUFFER_ALIGN 64          // Per-packet buffers start on a cache line
+#endif
+
+// Config persistence
+#define CONFIG_COMMIT_QUIET_MS 2000  // Write-behind delay after the last config change
+#define CONFIG_SCHEMA_VERSION 2      // Bump together with a migration in ConfigSchema.cpp
+#define CONFIG_RECORD_MAX_PAYLOAD 64 // Largest payload any schema version may use
+#define PROFILE_COUNT 4              // Named show profiles kept in NVS
+#define PROFILE_NAME_LENGTH 12       // Profile name buffer, including terminator
+
 // E1.31 Settings
 #define DEFAULT_IP 192,168,0,100
 #define DEFAULT_MAC { 0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED }
@@ -36,10 +92,31 @@
 #define HEADER_SIZE 126
 #define DMX_STARTCODE 0
 #define DMX_MAX_CHANNELS 512
+#define E131_ACN_ID_OFFSET 4
+#define E131_ROOT_VECTOR_OFFSET 18
+#define E131_CID_OFFSET 22
+#define E131_FRAMING_VECTOR_OFFSET 40
+#define E131_PRIORITY_OFFSET 108
+#define E131_SEQUENCE_OFFSET 111
 #define E131_UNIVERSE_OFFSET 113
+#define E131_DMP_VECTOR_OFFSET 117
 #define E131_LENGTH_OFFSET 123
 #define E131_HEADER_SIZE 126
 #define E131_MAX_PACKET_SIZE E131_HEADER_SIZE + DMX_MAX_CHANNELS
+#define E131_ACTIVE_TIMEOUT_MS 2500     // Status drops from RECEIVING to IDLE after this silence
+#define CONTROL_UDP_PORT 5570           // Text control datagrams, e.g. "PROFILE 2"
+#define CONTROL_MAX_PACKET 64           // Longest control datagram accepted
+#define CONTROL_POLL_MS 50              // Control socket poll interval
+#define E131_STATS_SOURCES 4            // Sources (CIDs) tracked for sequence gaps
+#define E131_SEQUENCE_WINDOW 20         // Sequence steps back still treated as late, not a restart
+
+// Network self-healing
+#define ETH_STATUS_POLL_MS 250          // W5500 hardware/link register poll interval
+#define NET_WDT_TIMEOUT_S 3             // Task watchdog timeout for NetTask
+#define E131_RX_STALL_MS 5000           // Silence (with link up) that gets the socket checked
+#define E131_RECOVERY_BACKOFF_MS 1000   // Minimum time between recovery attempts
+#define E131_RECOVERY_BUDGET_US 500000  // Recovery slower than this is logged as a warning
+#define E131_RECOVERY_LOG_SIZE 8        // Recovery events kept for the console
 
 // Ethernet SPI Pins (ESP32-S3)
 #define ETH_MISO 13
@@ -52,6 +129,14 @@
 #define HC12_TX 17
 #define HC12_SET 16
 #define HC12_BAUD 9600
+#define HC12_UART_NUM 2 // Serial2
+#define HC12_AT_ENTER_MS 40     // SET low to AT mode ready
+#define HC12_AT_REPLY_MS 100    // Wait for an AT command reply
+#define HC12_AT_EXIT_MS 80      // SET high to transparent mode ready
+#define MIN_RADIO_CHANNEL 1
+#define DEFAULT_RADIO_CHANNEL 1
+#define MAX_RADIO_CHANNEL 100
+// Frame format: lib/RadioFrame/RadioFrame.h
 
 // Display
 #define SCREEN_WIDTH 128
@@ -60,6 +145,16 @@
 #define DISPLAY_SDA 8
 #define DISPLAY_SCL 9
 #define STATUS_SCREEN_LENGTH_MS 3000
+#define PREVIEW_REFRESH_MS 200       // Live preview page redraw interval
+#define DISPLAY_REPAINT_RETRY_MS 500 // Full repaint retry interval while OLED transfers fail
+#define PREVIEW_HISTORY_LEN 40       // Seconds of packet-rate / radio-FPS history
+// SSD1306 is rated for 400 kHz. Raise it (e.g. -D DISPLAY_I2C_CLOCK_HZ=1000000)
+// only for a module and pull-ups checked on hardware.
+#ifndef DISPLAY_I2C_CLOCK_HZ
+#define DISPLAY_I2C_CLOCK_HZ 400000  // Fast mode
+#endif
+#define DISPLAY_I2C_PORT 0            // Port Wire installs the IDF driver on
+#define DISPLAY_I2C_TIMEOUT_MS 50
 
 // LED Settings
 #define NEOPIXEL 48
@@ -72,5 +167,12 @@
 #define BTN_LEFT  22
 #define BTN_RIGHT 23
 #define BTN_SEL   24
+#define BTN_COUNT 5
+#define BTN_EDGE_QUEUE_LEN 16
+#define BTN_DEBOUNCE_MS 20          // Level must be stable this long after the last edge
+#define BTN_REPEAT_DELAY_MS 500     // Hold time before UP/DOWN start repeating
+#define BTN_REPEAT_INTERVAL_MS 100  // Auto-repeat period
+#define BTN_ACCEL_X10_AFTER 10      // Repeats before steps grow to x10
+#define BTN_ACCEL_X100_AFTER 25     // Repeats before steps grow to x100
 
 #endif
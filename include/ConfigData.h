@@ -1,13 +1,16 @@
 #ifndef CONFIG_DATA_H
 #define CONFIG_DATA_H
 
-#include <Arduino.h>
+#include <stdint.h>
 
+// Current persisted layout. Any change here needs a new CONFIG_SCHEMA_VERSION,
+// a migration step in ConfigSchema.cpp and a line in ConfigSchema::equal().
 struct DeviceConfig {
     uint16_t universe;              // DMX Universe (e.g., 1)
     uint16_t numLeds;               // Number of pixels/LEDs
     uint32_t ipAddress;             // IP Address stored as a 32-bit integer
     bool useDhcp;                   // DHCP Mode
+    uint8_t radioChannel;           // HC-12 channel (v2)
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+/*
+ * Placement for the per-packet path: E1.31 parse, pipeline, radio framing
+ * and the hand-off to the display and history.
+ *
+ * HOT_PATH_ATTR puts a function in IRAM, so a packet never waits on an
+ * instruction cache miss refilled from flash over SPI. Only the code that
+ * runs for every packet carries it; IRAM is shared with the WiFi/BT stacks
+ * and ISRs. The W5500 driver and HardwareSerial stay in flash, as they come
+ * with the Arduino core. IRAM does not help during a flash write (an NVS
+ * commit): the cache is disabled for both cores and any task not pinned to
+ * IRAM entirely still stalls, so the gain is against cache misses only.
+ *
+ * HOT_BUFFER_ATTR puts a buffer on a HOT_BUFFER_ALIGN boundary, so a frame
+ * spans the fewest cache lines and never shares one with unrelated data.
+ * Statics in .bss are already in internal RAM. DMA_ATTR would move them to
+ * .dram1 and store their zeros in the image; keep it for buffers handed to
+ * a DMA engine, and none of these are (the W5500 goes through Arduino SPI
+ * transfers, the UART driver copies into its own ring). Members use
+ * alignas(HOT_BUFFER_ALIGN) and inherit the placement of their object.
+ *
+ * Build with -D HOT_PATH_IRAM=false -D HOT_BUFFER_ALIGN=4 (env:hotpath_baseline)
+ * to compare against the plain layout with the "packet/" bench cases.
+ */
+#if HOT_PATH_IRAM
+#define HOT_PATH_ATTR IRAM_ATTR
+#else
+#define HOT_PATH_ATTR
+#endif
+
+#define HOT_BUFFER_ATTR __attribute__((aligned(HOT_BUFFER_ALIGN)))
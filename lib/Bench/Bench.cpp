@@ -0,0 +1,87 @@
+#include "Bench.h"
+#include <esp_timer.h>
+
+Bench::Case Bench::_cases[BENCH_MAX_CASES];
+uint8_t Bench::_caseCount = 0;
+BenchResult Bench::_results[BENCH_MAX_CASES];
+uint8_t Bench::_resultCount = 0;
+volatile uint32_t Bench::_sink = 0;
+
+bool Bench::add(const char* name, BenchFunction function, uint32_t bytesPerOp, BenchHook setup, BenchHook teardown) {
+    for (uint8_t i = 0; i < _caseCount; i++) {
+        if (strcmp(_cases[i].name, name) == 0) return true;
+    }
+    if (_caseCount >= BENCH_MAX_CASES) return false;
+    _cases[_caseCount++] = {name, function, bytesPerOp, setup, teardown};
+    return true;
+}
+
+uint32_t Bench::_timeUs(BenchFunction function, uint32_t iterations) {
+    int64_t start = esp_timer_get_time();
+    function(iterations);
+    return (uint32_t)(esp_timer_get_time() - start);
+}
+
+uint8_t Bench::run(const char* filter) {
+    _resultCount = 0;
+
+    for (uint8_t i = 0; i < _caseCount; i++) {
+        const Case& c = _cases[i];
+        if (filter && filter[0] && !strstr(c.name, filter)) continue;
+        if (c.setup) c.setup();
+
+        // Grow the batch until it is long enough to time reliably
+        uint32_t iterations = 1;
+        uint32_t elapsed = _timeUs(c.function, iterations);
+        while (elapsed < BENCH_MIN_TIME_US && iterations < UINT32_MAX / 10) {
+            uint32_t scale = elapsed > 0 ? (BENCH_MIN_TIME_US * 12 / 10) / elapsed + 1 : 10;
+            if (scale > 10) scale = 10;
+            if (scale < 2) scale = 2;
+            iterations *= scale;
+            elapsed = _timeUs(c.function, iterations);
+        }
+
+        float best = (float)elapsed * 1000.0f / iterations;
+        for (uint8_t rep = 0; rep < BENCH_REPETITIONS; rep++) {
+            // Let equal-priority tasks run between repetitions
+            delay(1);
+            float ns = (float)_timeUs(c.function, iterations) * 1000.0f / iterations;
+            if (ns < best) best = ns;
+        }
+
+        if (c.teardown) c.teardown();
+        _results[_resultCount++] = {c.name, iterations, best, best * getCpuFrequencyMhz() / 1000.0f, c.bytesPerOp};
+    }
+    return _resultCount;
+}
+
+void Bench::printReport() {
+    Serial.println(F("\r\n=== Benchmarks ==="));
+    Serial.printf("%-24s %12s %12s %12s %10s\r\n", "Case", "ns/op", "cycles/op", "iterations", "MB/s");
+    for (uint8_t i = 0; i < _resultCount; i++) {
+        const BenchResult& r = _results[i];
+        Serial.printf("%-24s %12.1f %12.0f %12lu ", r.name, r.nsPerOp, r.cyclesPerOp, (unsigned long)r.iterations);
+        if (r.bytesPerOp > 0 && r.nsPerOp > 0) {
+            Serial.printf("%10.1f\r\n", r.bytesPerOp * 1000.0f / r.nsPerOp);
+        } else {
+            Serial.printf("%10s\r\n", "-");
+        }
+    }
+    Serial.println(F("==================\r\n"));
+}
+
+void Bench::printJson(Print& out, const char* target) {
+    out.printf("{\"context\": {\"target\": \"%s\", \"cpu_mhz\": %lu, \"hot_path_iram\": %s, "
+               "\"hot_buffer_align\": %u, \"min_time_us\": %lu, \"repetitions\": %u},\n",
+               target, (unsigned long)getCpuFrequencyMhz(), HOT_PATH_IRAM ? "true" : "false",
+               (unsigned)HOT_BUFFER_ALIGN, (unsigned long)BENCH_MIN_TIME_US, (unsigned)BENCH_REPETITIONS);
+    out.print("\"benchmarks\": [\n");
+    for (uint8_t i = 0; i < _resultCount; i++) {
+        const BenchResult& r = _results[i];
+        out.printf("  {\"name\": \"%s\", \"ns_per_op\": %.2f, \"iterations\": %lu, \"bytes_per_op\": %lu, "
+                   "\"cycles_per_op\": %.0f}%s\n",
+                   r.name, r.nsPerOp, (unsigned long)r.iterations, (unsigned long)r.bytesPerOp, r.cyclesPerOp,
+                   i + 1 < _resultCount ? "," : "");
+    }
+    out.print("]}\n");
+}
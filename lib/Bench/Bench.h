@@ -0,0 +1,78 @@
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+// Runs `iterations` operations of one benchmark case
+typedef void (*BenchFunction)(uint32_t iterations);
+// Brackets a case's runs, outside the timed batches
+typedef void (*BenchHook)();
+
+struct BenchResult {
+    const char* name;
+    uint32_t iterations;      // Of the fastest repetition
+    float nsPerOp;
+    float cyclesPerOp;        // At the CPU clock the case ran at
+    uint32_t bytesPerOp;      // 0 = not a throughput benchmark
+};
+
+/*
+ * Microbenchmarks for the packet-to-radio hot path, shared by the host
+ * runner (tools/bench) and the on-target "bench" console command, so both
+ * measure exactly the same code.
+ *
+ * Each case is calibrated until one repetition takes BENCH_MIN_TIME_US, then
+ * run BENCH_REPETITIONS times; the fastest repetition is reported, which
+ * filters out preemption by other tasks. Timing uses esp_timer on both
+ * target and host.
+ *
+ * Bench::run() blocks the calling task for roughly
+ * cases * (BENCH_REPETITIONS + 1) * BENCH_MIN_TIME_US.
+ */
+class Bench {
+public:
+    // Returns false if the table is full
+    static bool add(const char* name, BenchFunction function, uint32_t bytesPerOp = 0,
+                    BenchHook setup = nullptr, BenchHook teardown = nullptr);
+    // The hot path cases in BenchCases.cpp; safe to call more than once
+    static void addCoreCases();
+    // Frame-sized reads and writes in internal RAM and PSRAM (BenchMemory.cpp).
+    // Places its buffers through MemPlacement on the first call.
+    static void addMemoryCases();
+    // Whole per-packet path with warm and cold instruction cache and under
+    // concurrent NVS commits (BenchHotPath.cpp)
+    static void addHotPathCases();
+
+    // E1.31 data packet header for the fixtures
+    static void buildE131Header(uint8_t* header, uint16_t universe, uint16_t slots);
+
+    // Run every case whose name contains `filter` (all if null or empty).
+    // Returns the number of cases run.
+    static uint8_t run(const char* filter);
+
+    static uint8_t getResultCount() { return _resultCount; }
+    static const BenchResult& getResult(uint8_t index) { return _results[index]; }
+
+    static void printReport();
+    // One benchmark per line, so results diff and grep cleanly
+    static void printJson(Print& out, const char* target);
+
+    // Keeps the compiler from discarding a benchmarked result
+    static void consume(uint32_t value) { _sink = _sink + value; }
+
+private:
+    struct Case {
+        const char* name;
+        BenchFunction function;
+        uint32_t bytesPerOp;
+        BenchHook setup;
+        BenchHook teardown;
+    };
+
+    static Case _cases[BENCH_MAX_CASES];
+    static uint8_t _caseCount;
+    static BenchResult _results[BENCH_MAX_CASES];
+    static uint8_t _resultCount;
+    static volatile uint32_t _sink;
+
+    static uint32_t _timeUs(BenchFunction function, uint32_t iterations);
+};
@@ -0,0 +1,139 @@
+#include "Bench.h"
+#include "ConfigSchema.h"
+#include "DisplayMgr.h"
+#include "E131Handler.h"
+#include "Logger.h"
+#include "Pipeline.h"
+#include "RadioFrame.h"
+
+// Inputs shared by the cases, built once by addCoreCases()
+static uint8_t header[E131_HEADER_SIZE];
+static uint8_t otherHeader[E131_HEADER_SIZE];
+static uint8_t dmx[DMX_MAX_CHANNELS];
+static uint8_t out[PIPELINE_MAX_PAYLOAD];
+static uint8_t radioFrame[RADIO_FRAME_MAX_PAYLOAD + RADIO_FRAME_OVERHEAD];
+static PipelineConfig identityPipe;
+static PipelineConfig lutPipe;
+static PipelineConfig gatherLutPipe;
+static uint8_t displayFrame[SSD1306_BUFFER_SIZE];
+static uint8_t displayShadow[SSD1306_BUFFER_SIZE];
+static bool fixturesReady = false;
+
+void Bench::buildE131Header(uint8_t* h, uint16_t universe, uint16_t slots) {
+    static const uint8_t acnId[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+    memset(h, 0, E131_HEADER_SIZE);
+    memcpy(h + E131_ACN_ID_OFFSET, acnId, sizeof(acnId));
+    h[E131_ROOT_VECTOR_OFFSET + 3] = 0x04;
+    h[E131_FRAMING_VECTOR_OFFSET + 3] = 0x02;
+    h[E131_UNIVERSE_OFFSET] = universe >> 8;
+    h[E131_UNIVERSE_OFFSET + 1] = universe & 0xFF;
+    h[E131_DMP_VECTOR_OFFSET] = 0x02;
+    h[E131_LENGTH_OFFSET] = (slots + 1) >> 8;
+    h[E131_LENGTH_OFFSET + 1] = (slots + 1) & 0xFF;
+    h[E131_HEADER_SIZE - 1] = DMX_STARTCODE;
+}
+
+static void buildFixtures() {
+    Bench::buildE131Header(header, DEFAULT_UNIVERSE, PIPELINE_MAX_PAYLOAD);
+    Bench::buildE131Header(otherHeader, DEFAULT_UNIVERSE + 1, PIPELINE_MAX_PAYLOAD);
+
+    for (uint16_t i = 0; i < sizeof(dmx); i++) dmx[i] = (uint8_t)(i * 7);
+
+    // Every LED of the largest supported strip
+    DeviceConfig config;
+    ConfigSchema::applyDefaults(config);
+    config.numLeds = MAX_NUM_LEDS;
+    Pipeline::build(config, 1, identityPipe);
+
+    // Gamma-style curve: exercises the per-byte lookup
+    lutPipe = identityPipe;
+    for (uint16_t v = 0; v < 256; v++) lutPipe.lut[v] = (uint8_t)(v * v / 255);
+    lutPipe.lutIdentity = false;
+
+    // RGB -> GRB reorder on top of the curve: the general gather path
+    gatherLutPipe = lutPipe;
+    for (uint16_t led = 0; led < MAX_NUM_LEDS; led++) {
+        gatherLutPipe.gather[led * CHAN_PER_LED] = led * CHAN_PER_LED + 1;
+        gatherLutPipe.gather[led * CHAN_PER_LED + 1] = led * CHAN_PER_LED;
+    }
+    gatherLutPipe.gatherIdentity = false;
+
+    // Typical status page update: a value changed on two text rows
+    for (uint16_t i = 0; i < sizeof(displayFrame); i++) displayFrame[i] = (uint8_t)(i * 13);
+    memcpy(displayShadow, displayFrame, sizeof(displayShadow));
+    for (uint8_t page = 2; page < 4; page++) {
+        for (uint8_t col = 60; col < 90; col++) displayShadow[page * SCREEN_WIDTH + col] ^= 0xFF;
+    }
+
+    fixturesReady = true;
+}
+
+static void benchParseHeader(uint32_t iterations) {
+    uint16_t slots = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        E131HeaderStatus status = E131Handler::parseHeader(header, DEFAULT_UNIVERSE, slots);
+        Bench::consume(status + slots);
+    }
+}
+
+static void benchUniverseFilter(uint32_t iterations) {
+    uint16_t slots = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        Bench::consume(E131Handler::parseHeader(otherHeader, DEFAULT_UNIVERSE, slots));
+    }
+}
+
+static void benchPipelineCopy(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        Bench::consume(Pipeline::process(identityPipe, dmx, DMX_MAX_CHANNELS, out) + out[i % PIPELINE_MAX_PAYLOAD]);
+    }
+}
+
+static void benchPipelineLut(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        Bench::consume(Pipeline::process(lutPipe, dmx, DMX_MAX_CHANNELS, out) + out[i % PIPELINE_MAX_PAYLOAD]);
+    }
+}
+
+static void benchPipelineGatherLut(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        Bench::consume(Pipeline::process(gatherLutPipe, dmx, DMX_MAX_CHANNELS, out) + out[i % PIPELINE_MAX_PAYLOAD]);
+    }
+}
+
+static void benchDirtySpans(uint32_t iterations) {
+    DisplayMgr::DirtySpan spans[SSD1306_PAGES];
+    for (uint32_t i = 0; i < iterations; i++) {
+        Bench::consume(DisplayMgr::findDirtySpans(displayFrame, displayShadow, spans) + spans[0].first);
+    }
+}
+
+static void benchRadioEncode(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        Bench::consume(RadioFrame::encode(dmx, PIPELINE_MAX_PAYLOAD, radioFrame, sizeof(radioFrame)));
+    }
+}
+
+static void benchLoggerFiltered(uint32_t iterations) {
+    // A call the runtime level rejects, as in the per-packet path
+    LogLevel saved = Logger::getLevel();
+    if (saved >= LOG_LEVEL_VERBOSE) Logger::setLevel(LOG_LEVEL_DEBUG);
+    for (uint32_t i = 0; i < iterations; i++) {
+        Logger::log(LOG_LEVEL_VERBOSE, "BENCH", "Packet received: %d channels", (int)i);
+    }
+    Logger::setLevel(saved);
+    Bench::consume(iterations);
+}
+
+void Bench::addCoreCases() {
+    if (!fixturesReady) buildFixtures();
+
+    add("e131/parse_header", benchParseHeader);
+    add("e131/universe_filter", benchUniverseFilter);
+    add("pipeline/copy", benchPipelineCopy, PIPELINE_MAX_PAYLOAD);
+    add("pipeline/lut", benchPipelineLut, PIPELINE_MAX_PAYLOAD);
+    add("pipeline/gather_lut", benchPipelineGatherLut, PIPELINE_MAX_PAYLOAD);
+    add("display/dirty_spans", benchDirtySpans, SSD1306_BUFFER_SIZE);
+    add("radio/encode", benchRadioEncode, PIPELINE_MAX_PAYLOAD);
+    add("logger/filtered", benchLoggerFiltered);
+}
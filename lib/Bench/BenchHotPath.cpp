@@ -0,0 +1,117 @@
+#include "Bench.h"
+#include <nvs.h>
+#include <esp32s3/rom/cache.h>
+#include "ConfigSchema.h"
+#include "E131Handler.h"
+#include "HotPath.h"
+#include "Pipeline.h"
+#include "RadioFrame.h"
+
+// One packet from the socket buffer to an encoded radio frame, laid out and
+// placed as the network task does it (HotPath.h). The W5500 read and the
+// UART write are bus time rather than code and are left out. Run the cases
+// on a default build and on env:hotpath_baseline to see what the placement
+// buys: with a warm cache little, with a cold one the flash refills.
+
+#define BENCH_NVS_NAMESPACE "bench"
+#define BENCH_NVS_BLOB_BYTES 64
+
+static uint8_t packet[E131_MAX_PACKET_SIZE] HOT_BUFFER_ATTR;
+static uint8_t dmx[DMX_MAX_CHANNELS] HOT_BUFFER_ATTR;
+static uint8_t payload[PIPELINE_MAX_PAYLOAD] HOT_BUFFER_ATTR;
+static PipelineConfig pipe HOT_BUFFER_ATTR;
+static RadioFrameEncoder<PIPELINE_MAX_PAYLOAD> frame;
+static bool fixturesReady = false;
+
+static volatile bool nvsWriterRun = false;
+static volatile bool nvsWriterDone = true;
+
+// Stands in for parsePacket() and sendDmxPacket(), so it gets their placement
+static size_t HOT_PATH_ATTR runPacket() {
+    uint16_t slots = 0;
+    if (E131Handler::parseHeader(packet, DEFAULT_UNIVERSE, slots) != E131_HEADER_OK) return 0;
+    memcpy(dmx, packet + E131_HEADER_SIZE, slots);
+    uint16_t length = Pipeline::process(pipe, dmx, slots, payload);
+    return frame.encode(payload, length);
+}
+
+static void benchPath(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        Bench::consume(runPacket());
+    }
+}
+
+// Every packet refetches its code: flash-resident code over SPI, IRAM code
+// unaffected. Subtract packet/icache_invalidate for the packet's share.
+// Only the instruction cache; invalidating the data cache drops dirty lines.
+static void benchPathColdIcache(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        Cache_Invalidate_ICache_All();
+        Bench::consume(runPacket());
+    }
+}
+
+static void benchIcacheInvalidate(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        Cache_Invalidate_ICache_All();
+    }
+    Bench::consume(iterations);
+}
+
+// Back-to-back NVS writes, as a config commit or profile save makes them.
+// Each write disables the cache on both cores for its duration.
+static void nvsWriter(void* parameter) {
+    nvs_handle_t handle;
+    if (nvs_open(BENCH_NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+        uint8_t blob[BENCH_NVS_BLOB_BYTES] = {};
+        while (nvsWriterRun) {
+            blob[0]++;   // A changed value is always written
+            nvs_set_blob(handle, "load", blob, sizeof(blob));
+            nvs_commit(handle);
+            vTaskDelay(1);
+        }
+        nvs_erase_all(handle);
+        nvs_commit(handle);
+        nvs_close(handle);
+    }
+    nvsWriterDone = true;
+    vTaskDelete(NULL);
+}
+
+// The writer runs on the other core for the whole case, a few hundred
+// flash writes per run; NVS wear-levels them across its partition.
+static void startNvsWriter() {
+    nvsWriterRun = true;
+    nvsWriterDone = false;
+    if (xTaskCreatePinnedToCore(nvsWriter, "BenchNvs", BENCH_NVS_STACK, NULL, 1, NULL, xPortGetCoreID() ^ 1) != pdPASS) {
+        nvsWriterDone = true;
+        return;
+    }
+    delay(10);   // First commits under way before timing starts
+}
+
+static void stopNvsWriter() {
+    nvsWriterRun = false;
+    while (!nvsWriterDone) delay(1);
+}
+
+static void buildFixtures() {
+    Bench::buildE131Header(packet, DEFAULT_UNIVERSE, DMX_MAX_CHANNELS);
+    for (uint16_t i = 0; i < DMX_MAX_CHANNELS; i++) packet[E131_HEADER_SIZE + i] = (uint8_t)(i * 7);
+
+    DeviceConfig config;
+    ConfigSchema::applyDefaults(config);
+    config.numLeds = MAX_NUM_LEDS;
+    Pipeline::build(config, 1, pipe);
+
+    fixturesReady = true;
+}
+
+void Bench::addHotPathCases() {
+    if (!fixturesReady) buildFixtures();
+
+    add("packet/path", benchPath, PIPELINE_MAX_PAYLOAD);
+    add("packet/path_cold_icache", benchPathColdIcache, PIPELINE_MAX_PAYLOAD);
+    add("packet/icache_invalidate", benchIcacheInvalidate);
+    add("packet/path_nvs", benchPath, PIPELINE_MAX_PAYLOAD, startNvsWriter, stopNvsWriter);
+}
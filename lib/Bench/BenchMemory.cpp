@@ -0,0 +1,84 @@
+#include "Bench.h"
+#include "FrameHistory.h"
+#include "MemPlacement.h"
+
+// What a buffer costs where MemPlacement puts it: frame-sized records, the
+// FrameHistory access pattern, written and read in internal RAM and in
+// PSRAM. The PSRAM span is far larger than the data cache, so sequential
+// cases pay the line fills and write-backs that recording and replay do;
+// the random case is the worst case of reading a reference frame.
+
+#define FRAME_BYTES sizeof(HistoryFrame)
+
+static uint8_t* internalBuffer = nullptr;
+static uint8_t* psramBuffer = nullptr;
+static uint8_t frame[FRAME_BYTES];
+static uint32_t internalSlot = 0;
+static uint32_t psramSlot = 0;
+static uint32_t rng = 1;
+
+static uint8_t* slotAt(uint8_t* buffer, size_t bytes, uint32_t& slot) {
+    uint8_t* p = buffer + (size_t)slot * FRAME_BYTES;
+    if (++slot == bytes / FRAME_BYTES) slot = 0;
+    return p;
+}
+
+static void benchInternalWrite(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        memcpy(slotAt(internalBuffer, BENCH_MEM_INTERNAL_BYTES, internalSlot), frame, FRAME_BYTES);
+    }
+    Bench::consume(internalBuffer[0]);
+}
+
+static void benchPsramWrite(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        memcpy(slotAt(psramBuffer, BENCH_MEM_PSRAM_BYTES, psramSlot), frame, FRAME_BYTES);
+    }
+    Bench::consume(psramBuffer[0]);
+}
+
+static void benchInternalRead(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        memcpy(frame, slotAt(internalBuffer, BENCH_MEM_INTERNAL_BYTES, internalSlot), FRAME_BYTES);
+    }
+    Bench::consume(frame[0]);
+}
+
+static void benchPsramRead(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        memcpy(frame, slotAt(psramBuffer, BENCH_MEM_PSRAM_BYTES, psramSlot), FRAME_BYTES);
+    }
+    Bench::consume(frame[0]);
+}
+
+static void benchPsramRandomRead(uint32_t iterations) {
+    const uint32_t slots = BENCH_MEM_PSRAM_BYTES / FRAME_BYTES;
+    for (uint32_t i = 0; i < iterations; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        memcpy(frame, psramBuffer + (size_t)(rng % slots) * FRAME_BYTES, FRAME_BYTES);
+    }
+    Bench::consume(frame[0]);
+}
+
+void Bench::addMemoryCases() {
+    if (internalBuffer == nullptr) {
+        internalBuffer = (uint8_t*)MemPlacement::allocate("Bench internal", BENCH_MEM_INTERNAL_BYTES, MEM_HOT);
+    }
+    if (psramBuffer == nullptr) {
+        psramBuffer = (uint8_t*)MemPlacement::allocate("Bench PSRAM", BENCH_MEM_PSRAM_BYTES, MEM_COLD);
+    }
+
+    if (internalBuffer != nullptr) {
+        memset(internalBuffer, 0, BENCH_MEM_INTERNAL_BYTES);
+        add("mem/internal_write", benchInternalWrite, FRAME_BYTES);
+        add("mem/internal_read", benchInternalRead, FRAME_BYTES);
+    }
+    if (psramBuffer != nullptr) {
+        memset(psramBuffer, 0, BENCH_MEM_PSRAM_BYTES);
+        add("mem/psram_write", benchPsramWrite, FRAME_BYTES);
+        add("mem/psram_read", benchPsramRead, FRAME_BYTES);
+        add("mem/psram_random_read", benchPsramRandomRead, FRAME_BYTES);
+    }
+}
@@ -0,0 +1,123 @@
+#include "ButtonInput.h"
+#include "Logger.h"
+
+ButtonInput::Button ButtonInput::_buttons[BTN_COUNT] = {
+    {BTN_UP,    true,  BTN_RELEASED, false, 0, 0, 0},
+    {BTN_DOWN,  true,  BTN_RELEASED, false, 0, 0, 0},
+    {BTN_LEFT,  false, BTN_RELEASED, false, 0, 0, 0},
+    {BTN_RIGHT, false, BTN_RELEASED, false, 0, 0, 0},
+    {BTN_SEL,   false, BTN_RELEASED, false, 0, 0, 0},
+};
+QueueHandle_t ButtonInput::_edgeQueue = nullptr;
+
+void ButtonInput::begin() {
+    _edgeQueue = xQueueCreate(BTN_EDGE_QUEUE_LEN, sizeof(uint8_t));
+    if (_edgeQueue == nullptr) {
+        LOG_ERROR_TAG("BUTTON", "Failed to create edge queue");
+        return;
+    }
+
+    for (uint8_t i = 0; i < BTN_COUNT; i++) {
+        pinMode(_buttons[i].pin, INPUT_PULLUP);
+        attachInterruptArg(digitalPinToInterrupt(_buttons[i].pin), onEdge, (void*)(uintptr_t)i, CHANGE);
+    }
+    LOG_INFO_TAG("BUTTON", "Button interrupts attached");
+}
+
+void IRAM_ATTR ButtonInput::onEdge(void* arg) {
+    uint8_t index = (uint8_t)(uintptr_t)arg;
+    BaseType_t woken = pdFALSE;
+    // A full queue only loses duplicate edges; the level is re-read after debounce
+    xQueueSendFromISR(_edgeQueue, &index, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+bool ButtonInput::waitForEvent(ButtonEvent& event) {
+    if (_edgeQueue == nullptr) return false;
+
+    for (;;) {
+        uint8_t index;
+        if (xQueueReceive(_edgeQueue, &index, ticksUntilNextDeadline()) == pdTRUE && index < BTN_COUNT) {
+            Button& b = _buttons[index];
+            // Every edge restarts the debounce window
+            b.state = BTN_DEBOUNCING;
+            b.debounceUntil = millis() + BTN_DEBOUNCE_MS;
+        }
+
+        if (service(event)) return true;
+    }
+}
+
+bool ButtonInput::service(ButtonEvent& event) {
+    unsigned long now = millis();
+
+    for (uint8_t i = 0; i < BTN_COUNT; i++) {
+        Button& b = _buttons[i];
+
+        switch (b.state) {
+            case BTN_DEBOUNCING: {
+                if ((long)(now - b.debounceUntil) < 0) break;
+
+                bool pressed = digitalRead(b.pin) == LOW;
+                if (pressed == b.pressed) {
+                    // Bounce that settled back to the previous level
+                    b.state = pressed ? BTN_HELD : BTN_RELEASED;
+                    break;
+                }
+
+                b.pressed = pressed;
+                if (!pressed) {
+                    b.state = BTN_RELEASED;
+                    break;
+                }
+
+                b.state = BTN_HELD;
+                b.repeatCount = 0;
+                b.nextRepeat = now + BTN_REPEAT_DELAY_MS;
+                event = {b.pin, 1, false};
+                return true;
+            }
+
+            case BTN_HELD:
+                if (b.repeatable && (long)(now - b.nextRepeat) >= 0) {
+                    b.repeatCount++;
+                    b.nextRepeat += BTN_REPEAT_INTERVAL_MS;
+                    event = {b.pin, accelStep(b.repeatCount), true};
+                    return true;
+                }
+                break;
+
+            case BTN_RELEASED:
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+TickType_t ButtonInput::ticksUntilNextDeadline() {
+    unsigned long now = millis();
+    long wait = -1;
+
+    for (uint8_t i = 0; i < BTN_COUNT; i++) {
+        const Button& b = _buttons[i];
+        long until;
+        if (b.state == BTN_DEBOUNCING) {
+            until = (long)(b.debounceUntil - now);
+        } else if (b.state == BTN_HELD && b.repeatable) {
+            until = (long)(b.nextRepeat - now);
+        } else {
+            continue;
+        }
+        if (until < 0) until = 0;
+        if (wait < 0 || until < wait) wait = until;
+    }
+
+    return wait < 0 ? portMAX_DELAY : pdMS_TO_TICKS(wait) + 1;
+}
+
+uint16_t ButtonInput::accelStep(uint16_t repeatCount) {
+    if (repeatCount >= BTN_ACCEL_X100_AFTER) return 100;
+    if (repeatCount >= BTN_ACCEL_X10_AFTER) return 10;
+    return 1;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "Config.h"
+
+struct ButtonEvent {
+    int pin;            // BTN_* pin that fired
+    uint16_t step;      // Acceleration multiplier: 1, 10 or 100
+    bool repeat;        // Generated by auto-repeat rather than the press itself
+};
+
+/*
+ * Interrupt-driven button input.
+ *
+ * GPIO edge interrupts push the button index into a queue. waitForEvent()
+ * runs a per-button debounce state machine on top of it: an edge starts a
+ * BTN_DEBOUNCE_MS window, after which the pin level is sampled and accepted
+ * if it differs from the debounced state. UP/DOWN auto-repeat while held,
+ * accelerating from x1 to x10 to x100.
+ */
+class ButtonInput {
+public:
+    static void begin();
+
+    // Block until the next press or repeat. Returns false only if the edge
+    // queue could not be created.
+    static bool waitForEvent(ButtonEvent& event);
+
+private:
+    enum State : uint8_t {
+        BTN_RELEASED,
+        BTN_DEBOUNCING,
+        BTN_HELD
+    };
+
+    struct Button {
+        int pin;
+        bool repeatable;
+        State state;
+        bool pressed;                   // Debounced level
+        unsigned long debounceUntil;
+        unsigned long nextRepeat;
+        uint16_t repeatCount;
+    };
+
+    static Button _buttons[BTN_COUNT];
+    static QueueHandle_t _edgeQueue;
+
+    static void IRAM_ATTR onEdge(void* arg);
+    static bool service(ButtonEvent& event);
+    static TickType_t ticksUntilNextDeadline();
+    static uint16_t accelStep(uint16_t repeatCount);
+};
@@ -1,9 +1,12 @@
 #include "ConfigManager.h"
 #include "Logger.h"
-#include <WiFi.h> // Include for IPAddress conversion
+#include "ConfigSchema.h"
 
 #define STORAGE_NAMESPACE "crowdlight"
-#define CONFIG_KEY "device_config"
+#define CONFIG_RECORD_KEY "cfg_record"     // Versioned record (ConfigSchema)
+#define LEGACY_CONFIG_KEY "device_config"  // Raw v1 blob from older firmware
+#define PROFILE_RECORD_KEY "prof%u"        // Profile record per slot
+#define PROFILE_NAME_KEY "pname%u"         // Profile name per slot
 
 ConfigManager::ConfigManager() {}
 
@@ -27,35 +30,147 @@ void ConfigManager::begin() {
 }
 
 void ConfigManager::loadConfig(DeviceConfig& config) {
-    size_t required_size = sizeof(DeviceConfig);
-    esp_err_t ret = nvs_get_blob(_nvsHandle, CONFIG_KEY, &config, &required_size);
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = sizeof(record);
+    esp_err_t ret = nvs_get_blob(_nvsHandle, CONFIG_RECORD_KEY, record, &size);
 
-    if (ret == ESP_ERR_NVS_NOT_FOUND) {
+    if (ret == ESP_OK) {
+        ConfigLoadStatus status = ConfigSchema::decode(record, size, config);
+        if (status == CONFIG_LOAD_OK) {
+            LOG_INFO_TAG("CONFIG", "Config loaded - Universe: %d, LEDs: %d", config.universe, config.numLeds);
+            return;
+        }
+        if (status == CONFIG_LOAD_MIGRATED) {
+            LOG_INFO_TAG("CONFIG", "Config upgraded to schema v%d", CONFIG_SCHEMA_VERSION);
+            saveConfig(config);
+            return;
+        }
+        if (status == CONFIG_LOAD_UNSUPPORTED_VERSION) {
+            // Written by newer firmware: run on defaults but keep the record
+            // so upgrading again gets it back
+            LOG_ERROR_TAG("CONFIG", "Config record rejected (%s), using defaults", ConfigSchema::statusName(status));
+            ConfigSchema::applyDefaults(config);
+            return;
+        }
+        LOG_ERROR_TAG("CONFIG", "Config record rejected (%s), loading defaults", ConfigSchema::statusName(status));
+    } else if (ret == ESP_ERR_NVS_NOT_FOUND && _loadLegacy(config)) {
+        return;
+    } else if (ret == ESP_ERR_NVS_NOT_FOUND) {
         LOG_WARN_TAG("CONFIG", "Config not found, loading defaults");
-        // --- Set Default Values (Only happens on first boot) ---
-        config.universe = DEFAULT_UNIVERSE; 
-        config.useDhcp = DEFAULT_DHCP_STATUS;
-        IPAddress defaultIP(DEFAULT_IP);
-        config.ipAddress = defaultIP;
-        // ----------------------------------------------------
-        saveConfig(config); // Save the defaults immediately
-    } else if (ret != ESP_OK) {
-        LOG_ERROR_TAG("CONFIG", "Error reading config blob: %s", esp_err_to_name(ret));
     } else {
-        LOG_INFO_TAG("CONFIG", "Config loaded - Universe: %d, LEDs: %d", config.universe, config.numLeds);
+        // Unreadable is not corrupt (e.g. a newer, larger record): leave it alone
+        LOG_ERROR_TAG("CONFIG", "Error reading config record: %s, using defaults", esp_err_to_name(ret));
+        ConfigSchema::applyDefaults(config);
+        return;
+    }
+
+    ConfigSchema::applyDefaults(config);
+    saveConfig(config); // Save the defaults immediately
+}
+
+bool ConfigManager::_loadLegacy(DeviceConfig& config) {
+    // Blob written before versioned records: raw DeviceConfig v1
+    uint8_t blob[sizeof(DeviceConfigV1)];
+    size_t size = sizeof(blob);
+    if (nvs_get_blob(_nvsHandle, LEGACY_CONFIG_KEY, blob, &size) != ESP_OK) {
+        return false;
+    }
+
+    ConfigLoadStatus status = ConfigSchema::decodeLegacy(blob, size, config);
+    if (status != CONFIG_LOAD_MIGRATED) {
+        LOG_ERROR_TAG("CONFIG", "Legacy config rejected (%s)", ConfigSchema::statusName(status));
+        return false;
     }
+
+    LOG_INFO_TAG("CONFIG", "Legacy config migrated to schema v%d", CONFIG_SCHEMA_VERSION);
+    saveConfig(config);
+    nvs_erase_key(_nvsHandle, LEGACY_CONFIG_KEY);
+    nvs_commit(_nvsHandle);
+    return true;
 }
 
-void ConfigManager::saveConfig(const DeviceConfig& config) {
-    esp_err_t ret = nvs_set_blob(_nvsHandle, CONFIG_KEY, &config, sizeof(DeviceConfig));
+bool ConfigManager::saveConfig(const DeviceConfig& config) {
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = ConfigSchema::encode(config, record, sizeof(record));
+
+    esp_err_t ret = nvs_set_blob(_nvsHandle, CONFIG_RECORD_KEY, record, size);
     if (ret != ESP_OK) {
-        LOG_ERROR_TAG("CONFIG", "Error saving config blob: %s", esp_err_to_name(ret));
-        return;
+        LOG_ERROR_TAG("CONFIG", "Error saving config record: %s", esp_err_to_name(ret));
+        return false;
     }
     ret = nvs_commit(_nvsHandle);
     if (ret != ESP_OK) {
         LOG_ERROR_TAG("CONFIG", "Error committing NVS: %s", esp_err_to_name(ret));
-    } else {
-        LOG_INFO_TAG("CONFIG", "Config saved - Universe: %d, LEDs: %d", config.universe, config.numLeds);
+        return false;
+    }
+    LOG_INFO_TAG("CONFIG", "Config saved - Universe: %d, LEDs: %d", config.universe, config.numLeds);
+    return true;
+}
+
+bool ConfigManager::loadProfile(uint8_t slot, char* name, size_t nameSize, DeviceConfig& config) {
+    char recordKey[12];
+    char nameKey[12];
+    snprintf(recordKey, sizeof(recordKey), PROFILE_RECORD_KEY, slot);
+    snprintf(nameKey, sizeof(nameKey), PROFILE_NAME_KEY, slot);
+
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = sizeof(record);
+    esp_err_t ret = nvs_get_blob(_nvsHandle, recordKey, record, &size);
+    if (ret != ESP_OK) {
+        if (ret != ESP_ERR_NVS_NOT_FOUND) {
+            LOG_ERROR_TAG("CONFIG", "Error reading profile %d: %s", slot + 1, esp_err_to_name(ret));
+        }
+        return false;
+    }
+
+    // Older records are migrated in memory; the slot is rewritten on its next save
+    ConfigLoadStatus status = ConfigSchema::decode(record, size, config);
+    if (status != CONFIG_LOAD_OK && status != CONFIG_LOAD_MIGRATED) {
+        LOG_ERROR_TAG("CONFIG", "Profile %d rejected (%s)", slot + 1, ConfigSchema::statusName(status));
+        return false;
+    }
+
+    size_t nameLen = nameSize;
+    if (nvs_get_str(_nvsHandle, nameKey, name, &nameLen) != ESP_OK) {
+        snprintf(name, nameSize, "Profile %u", slot + 1);
+    }
+    return true;
+}
+
+bool ConfigManager::saveProfile(uint8_t slot, const char* name, const DeviceConfig& config) {
+    char recordKey[12];
+    char nameKey[12];
+    snprintf(recordKey, sizeof(recordKey), PROFILE_RECORD_KEY, slot);
+    snprintf(nameKey, sizeof(nameKey), PROFILE_NAME_KEY, slot);
+
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = ConfigSchema::encode(config, record, sizeof(record));
+
+    esp_err_t ret = nvs_set_blob(_nvsHandle, recordKey, record, size);
+    if (ret == ESP_OK) ret = nvs_set_str(_nvsHandle, nameKey, name);
+    if (ret == ESP_OK) ret = nvs_commit(_nvsHandle);
+    if (ret != ESP_OK) {
+        LOG_ERROR_TAG("CONFIG", "Error saving profile %d: %s", slot + 1, esp_err_to_name(ret));
+        return false;
+    }
+    LOG_INFO_TAG("CONFIG", "Profile %d '%s' saved - Universe: %d, LEDs: %d, Channel: %d",
+                 slot + 1, name, config.universe, config.numLeds, config.radioChannel);
+    return true;
+}
+
+bool ConfigManager::eraseProfile(uint8_t slot) {
+    char recordKey[12];
+    char nameKey[12];
+    snprintf(recordKey, sizeof(recordKey), PROFILE_RECORD_KEY, slot);
+    snprintf(nameKey, sizeof(nameKey), PROFILE_NAME_KEY, slot);
+
+    nvs_erase_key(_nvsHandle, nameKey);
+    esp_err_t ret = nvs_erase_key(_nvsHandle, recordKey);
+    if (ret != ESP_OK && ret != ESP_ERR_NVS_NOT_FOUND) {
+        LOG_ERROR_TAG("CONFIG", "Error erasing profile %d: %s", slot + 1, esp_err_to_name(ret));
+        return false;
     }
+    nvs_commit(_nvsHandle);
+    LOG_INFO_TAG("CONFIG", "Profile %d erased", slot + 1);
+    return true;
 }
@@ -10,13 +10,24 @@ public:
     ConfigManager();
     void begin();
 
-    // Load data from NVS into the shared config structure
+    // Load data from NVS into the shared config structure. Older schema
+    // versions are migrated and rewritten; missing or corrupt records fall
+    // back to defaults, which are saved. A record from newer firmware or one
+    // that cannot be read is left in flash and defaults are used in RAM only.
     void loadConfig(DeviceConfig& config);
     
-    // Save the current config structure to NVS
-    void saveConfig(const DeviceConfig& config);
+    // Save the current config structure to NVS. False if the write or commit failed.
+    bool saveConfig(const DeviceConfig& config);
+
+    // Named show profiles, one versioned record per slot (0..PROFILE_COUNT-1).
+    // loadProfile() returns false for an empty or unreadable slot.
+    bool loadProfile(uint8_t slot, char* name, size_t nameSize, DeviceConfig& config);
+    bool saveProfile(uint8_t slot, const char* name, const DeviceConfig& config);
+    bool eraseProfile(uint8_t slot);
 
 private:
     // NVS handle for the partition we use
     nvs_handle_t _nvsHandle;
+
+    bool _loadLegacy(DeviceConfig& config);
 };
\ No newline at end of file
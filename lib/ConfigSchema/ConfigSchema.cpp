@@ -0,0 +1,153 @@
+#include "ConfigSchema.h"
+#include <string.h>
+
+static_assert(sizeof(DeviceConfig) == sizeof(DeviceConfigV2),
+              "DeviceConfig changed: add DeviceConfigV3, a migration and bump CONFIG_SCHEMA_VERSION");
+static_assert(sizeof(DeviceConfigV2) <= CONFIG_RECORD_MAX_PAYLOAD, "Payload exceeds CONFIG_RECORD_MAX_PAYLOAD");
+
+namespace {
+
+// Upgrade a payload in place from version N to N+1. `length` is updated to
+// the new payload size.
+typedef bool (*MigrationStep)(uint8_t* payload, uint16_t& length);
+
+bool migrateV1ToV2(uint8_t* payload, uint16_t& length) {
+    if (length != sizeof(DeviceConfigV1)) return false;
+
+    DeviceConfigV1 v1;
+    memcpy(&v1, payload, sizeof(v1));
+
+    DeviceConfigV2 v2;
+    memset(&v2, 0, sizeof(v2));
+    v2.universe = v1.universe;
+    v2.numLeds = v1.numLeds;
+    v2.ipAddress = v1.ipAddress;
+    v2.useDhcp = v1.useDhcp;
+    v2.radioChannel = DEFAULT_RADIO_CHANNEL;   // New in v2
+
+    memcpy(payload, &v2, sizeof(v2));
+    length = sizeof(v2);
+    return true;
+}
+
+// Indexed by the version being upgraded from
+const MigrationStep kMigrations[] = {
+    nullptr,            // 0: never persisted
+    migrateV1ToV2,      // 1 -> 2
+};
+
+static_assert(sizeof(kMigrations) / sizeof(kMigrations[0]) == CONFIG_SCHEMA_VERSION,
+              "Every schema version below the current one needs a migration step");
+
+// Bring a payload of `version` up to the current version and unpack it
+ConfigLoadStatus upgrade(uint16_t version, const uint8_t* data, uint16_t length, DeviceConfig& config) {
+    if (version == 0 || version > CONFIG_SCHEMA_VERSION) return CONFIG_LOAD_UNSUPPORTED_VERSION;
+    if (length > CONFIG_RECORD_MAX_PAYLOAD) return CONFIG_LOAD_BAD_LENGTH;
+
+    uint8_t payload[CONFIG_RECORD_MAX_PAYLOAD];
+    memcpy(payload, data, length);
+
+    for (uint16_t v = version; v < CONFIG_SCHEMA_VERSION; v++) {
+        if (!kMigrations[v](payload, length)) return CONFIG_LOAD_BAD_LENGTH;
+    }
+    if (length != sizeof(DeviceConfig)) return CONFIG_LOAD_BAD_LENGTH;
+
+    memcpy(&config, payload, sizeof(DeviceConfig));
+    ConfigSchema::sanitize(config);
+    return version == CONFIG_SCHEMA_VERSION ? CONFIG_LOAD_OK : CONFIG_LOAD_MIGRATED;
+}
+
+} // namespace
+
+namespace ConfigSchema {
+
+void applyDefaults(DeviceConfig& config) {
+    memset(&config, 0, sizeof(config));
+    config.universe = DEFAULT_UNIVERSE;
+    config.numLeds = DEFAULT_NUM_LEDS;
+    config.ipAddress = packIp(DEFAULT_IP);
+    config.useDhcp = DEFAULT_DHCP_STATUS;
+    config.radioChannel = DEFAULT_RADIO_CHANNEL;
+}
+
+bool sanitize(DeviceConfig& config) {
+    DeviceConfig before = config;
+
+    if (config.universe < MIN_UNIVERSE) config.universe = MIN_UNIVERSE;
+    if (config.universe > MAX_UNIVERSE) config.universe = MAX_UNIVERSE;
+    if (config.numLeds > MAX_NUM_LEDS) config.numLeds = MAX_NUM_LEDS;
+    if (config.radioChannel < MIN_RADIO_CHANNEL) config.radioChannel = MIN_RADIO_CHANNEL;
+    if (config.radioChannel > MAX_RADIO_CHANNEL) config.radioChannel = MAX_RADIO_CHANNEL;
+    config.useDhcp = config.useDhcp ? true : false;
+
+    return !equal(before, config);
+}
+
+bool equal(const DeviceConfig& a, const DeviceConfig& b) {
+    return a.universe == b.universe &&
+           a.numLeds == b.numLeds &&
+           a.ipAddress == b.ipAddress &&
+           a.useDhcp == b.useDhcp &&
+           a.radioChannel == b.radioChannel;
+}
+
+size_t encode(const DeviceConfig& config, uint8_t* out, size_t capacity) {
+    size_t total = sizeof(ConfigRecordHeader) + sizeof(DeviceConfig);
+    if (capacity < total) return 0;
+
+    ConfigRecordHeader header;
+    header.magic = CONFIG_RECORD_MAGIC;
+    header.version = CONFIG_SCHEMA_VERSION;
+    header.length = sizeof(DeviceConfig);
+    header.crc = crc32((const uint8_t*)&config, sizeof(DeviceConfig));
+
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), &config, sizeof(DeviceConfig));
+    return total;
+}
+
+ConfigLoadStatus decode(const uint8_t* data, size_t length, DeviceConfig& config) {
+    if (length < sizeof(ConfigRecordHeader)) return CONFIG_LOAD_BAD_LENGTH;
+
+    ConfigRecordHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != CONFIG_RECORD_MAGIC) return CONFIG_LOAD_BAD_MAGIC;
+    if (header.length != length - sizeof(header)) return CONFIG_LOAD_BAD_LENGTH;
+
+    const uint8_t* payload = data + sizeof(header);
+    if (crc32(payload, header.length) != header.crc) return CONFIG_LOAD_BAD_CRC;
+
+    return upgrade(header.version, payload, header.length, config);
+}
+
+ConfigLoadStatus decodeLegacy(const uint8_t* data, size_t length, DeviceConfig& config) {
+    if (length != sizeof(DeviceConfigV1)) return CONFIG_LOAD_BAD_LENGTH;
+    return upgrade(1, data, (uint16_t)length, config);
+}
+
+const char* statusName(ConfigLoadStatus status) {
+    switch (status) {
+        case CONFIG_LOAD_OK:                  return "ok";
+        case CONFIG_LOAD_MIGRATED:            return "migrated";
+        case CONFIG_LOAD_BAD_MAGIC:           return "bad magic";
+        case CONFIG_LOAD_BAD_LENGTH:          return "bad length";
+        case CONFIG_LOAD_BAD_CRC:             return "bad CRC";
+        case CONFIG_LOAD_UNSUPPORTED_VERSION: return "unsupported version";
+        default:                              return "unknown";
+    }
+}
+
+uint32_t crc32(const uint8_t* data, size_t length) {
+    // CRC-32 (IEEE 802.3), bitwise: config records are tiny and rarely read
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+} // namespace ConfigSchema
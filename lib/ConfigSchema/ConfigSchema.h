@@ -0,0 +1,87 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "Config.h"
+#include "ConfigData.h"
+
+/*
+ * Versioned, CRC-protected persistence format for DeviceConfig.
+ *
+ * A record is a fixed header followed by the payload of one schema version:
+ *
+ *   [magic u32] [version u16] [payload length u16] [CRC-32 of payload u32] [payload]
+ *
+ * decode() upgrades older payloads one version at a time through the
+ * migration table, filling defaults for fields the old version lacked.
+ * Version 1 is the legacy raw DeviceConfig blob written before records
+ * existed; decodeLegacy() accepts it.
+ *
+ * This module has no platform dependencies so it can be tested on the host.
+ */
+
+#define CONFIG_RECORD_MAGIC 0x58544C43u   // "CLTX"
+
+struct ConfigRecordHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t length;
+    uint32_t crc;
+};
+
+#define CONFIG_RECORD_MAX_SIZE (sizeof(ConfigRecordHeader) + CONFIG_RECORD_MAX_PAYLOAD)
+
+enum ConfigLoadStatus {
+    CONFIG_LOAD_OK,                 // Current version, intact
+    CONFIG_LOAD_MIGRATED,           // Older version, upgraded
+    CONFIG_LOAD_BAD_MAGIC,
+    CONFIG_LOAD_BAD_LENGTH,
+    CONFIG_LOAD_BAD_CRC,
+    CONFIG_LOAD_UNSUPPORTED_VERSION
+};
+
+// Payload layouts of every version ever persisted. Never edit these; add a
+// new one instead.
+struct DeviceConfigV1 {
+    uint16_t universe;
+    uint16_t numLeds;
+    uint32_t ipAddress;
+    bool useDhcp;
+};
+
+struct DeviceConfigV2 {
+    uint16_t universe;
+    uint16_t numLeds;
+    uint32_t ipAddress;
+    bool useDhcp;
+    uint8_t radioChannel;
+};
+
+namespace ConfigSchema {
+    // Factory defaults for every field
+    void applyDefaults(DeviceConfig& config);
+
+    // Clamp out-of-range fields to their limits. Returns true if anything changed.
+    bool sanitize(DeviceConfig& config);
+
+    // Field by field; memcmp would also compare padding, which copies
+    // needn't preserve
+    bool equal(const DeviceConfig& a, const DeviceConfig& b);
+
+    // Serialize at the current version. Returns bytes written, 0 if out is too small.
+    size_t encode(const DeviceConfig& config, uint8_t* out, size_t capacity);
+
+    // Parse a record of any supported version. On failure `config` is untouched.
+    ConfigLoadStatus decode(const uint8_t* data, size_t length, DeviceConfig& config);
+
+    // Parse a pre-record (version 1) raw blob
+    ConfigLoadStatus decodeLegacy(const uint8_t* data, size_t length, DeviceConfig& config);
+
+    const char* statusName(ConfigLoadStatus status);
+
+    uint32_t crc32(const uint8_t* data, size_t length);
+
+    // IPAddress-compatible packing (first octet in the low byte)
+    inline uint32_t packIp(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+        return (uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24);
+    }
+}
@@ -0,0 +1,117 @@
+#include "ConfigService.h"
+#include "ConfigSchema.h"
+#include "Logger.h"
+#include "TaskMonitor.h"
+
+ConfigService::ConfigService(ConfigManager& store) : _store(store) {}
+
+void ConfigService::begin(const DeviceConfig& loaded) {
+    _current = loaded;
+    _staged = loaded;
+    _persisted = loaded;
+
+    _flushMutex = xSemaphoreCreateMutex();
+    _editMutex = xSemaphoreCreateRecursiveMutex();
+
+    if (xTaskCreatePinnedToCore(commitLoop, "CfgTask", CONFIG_TASK_STACK, this, 1, &_commitTask, 1) == pdPASS) {
+        TaskMonitor::watch(_commitTask, CONFIG_TASK_STACK);
+        _commitTimer = xTimerCreate("CfgCommit", pdMS_TO_TICKS(CONFIG_COMMIT_QUIET_MS), pdFALSE, this, onCommitTimer);
+    }
+    if (_commitTimer == nullptr) {
+        LOG_ERROR_TAG("CONFIG", "Failed to create commit task or timer, saves will be synchronous");
+    }
+}
+
+DeviceConfig ConfigService::get() const {
+    portENTER_CRITICAL(&_mux);
+    DeviceConfig copy = _current;
+    portEXIT_CRITICAL(&_mux);
+    return copy;
+}
+
+DeviceConfig ConfigService::getStaged(uint32_t* generation) const {
+    portENTER_CRITICAL(&_mux);
+    DeviceConfig copy = _staged;
+    if (generation != nullptr) *generation = _stagedGeneration;
+    portEXIT_CRITICAL(&_mux);
+    return copy;
+}
+
+void ConfigService::stage(const DeviceConfig& config) {
+    portENTER_CRITICAL(&_mux);
+    _staged = config;
+    _stagedGeneration++;
+    portEXIT_CRITICAL(&_mux);
+}
+
+bool ConfigService::stageIf(const DeviceConfig& config, uint32_t generation) {
+    portENTER_CRITICAL(&_mux);
+    bool current = _stagedGeneration == generation;
+    if (current) {
+        _staged = config;
+        _stagedGeneration++;
+    }
+    portEXIT_CRITICAL(&_mux);
+    return current;
+}
+
+ConfigService::EditGuard::EditGuard(ConfigService& service) : _service(service) {
+    if (_service._editMutex != nullptr) xSemaphoreTakeRecursive(_service._editMutex, portMAX_DELAY);
+}
+
+ConfigService::EditGuard::~EditGuard() {
+    if (_service._editMutex != nullptr) xSemaphoreGiveRecursive(_service._editMutex);
+}
+
+void ConfigService::publish() {
+    portENTER_CRITICAL(&_mux);
+    _current = _staged;
+    DeviceConfig published = _current;
+    portEXIT_CRITICAL(&_mux);
+
+    LOG_INFO_TAG("CONFIG", "Config published - Universe: %d, LEDs: %d", published.universe, published.numLeds);
+
+    if (_applyCallback != nullptr) {
+        _applyCallback(published);
+    }
+
+    // Restart the quiet period; the commit happens once edits stop
+    if (_commitTimer == nullptr || xTimerReset(_commitTimer, 0) != pdPASS) {
+        flush();
+    }
+}
+
+void ConfigService::setApplyCallback(void (*callback)(const DeviceConfig&)) {
+    _applyCallback = callback;
+}
+
+void ConfigService::flush() {
+    if (_flushMutex != nullptr) xSemaphoreTake(_flushMutex, portMAX_DELAY);
+    DeviceConfig config = get();
+
+    if (ConfigSchema::equal(config, _persisted)) {
+        _skippedCount++;
+        LOG_DEBUG_TAG("CONFIG", "Config unchanged since last commit, skipping flash write");
+    } else if (_store.saveConfig(config)) {
+        _persisted = config;
+        _commitCount++;
+    } else {
+        // _persisted still differs, so the next flush writes it again
+        _failedCount++;
+        if (_commitTimer != nullptr) xTimerReset(_commitTimer, 0);
+    }
+    if (_flushMutex != nullptr) xSemaphoreGive(_flushMutex);
+}
+
+void ConfigService::onCommitTimer(TimerHandle_t timer) {
+    // Timer service task: only hand over to the commit task
+    xTaskNotifyGive(static_cast<ConfigService*>(pvTimerGetTimerID(timer))->_commitTask);
+}
+
+void ConfigService::commitLoop(void* parameter) {
+    ConfigService* service = static_cast<ConfigService*>(parameter);
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        service->flush();
+    }
+}
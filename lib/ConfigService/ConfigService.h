@@ -0,0 +1,90 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/timers.h>
+#include "ConfigData.h"
+#include "ConfigManager.h"
+
+/*
+ * Runtime owner of DeviceConfig.
+ *
+ * Edits go to a staged copy; publish() swaps it into the live config in one
+ * critical section, so readers on other cores never see a half-applied
+ * change. Flash writes are coalesced: each publish restarts a quiet-period
+ * timer, and when it expires the config is committed to NVS only if it
+ * differs from what was last persisted. A failed write restarts the timer,
+ * so it is retried until it lands.
+ *
+ * The commit runs in the service's own task (CONFIG_TASK_STACK); the timer
+ * callback only wakes it, as the timer service task's stack is too small
+ * for an NVS write and a log line. flush() is serialized, so the console
+ * can force a commit while the write-behind one runs.
+ *
+ * The menu, the console and the control port all edit. An editor that reads
+ * the staged copy, changes it and stages it back holds an EditGuard across
+ * the three steps, so a profile switch from another task can't land in
+ * between and be overwritten by the older copy.
+ */
+class ConfigService {
+public:
+    // Keeps other editors out for its lifetime. Recursive, so a publish or a
+    // profile switch can run inside a guarded edit.
+    class EditGuard {
+    public:
+        explicit EditGuard(ConfigService& service);
+        ~EditGuard();
+        EditGuard(const EditGuard&) = delete;
+        EditGuard& operator=(const EditGuard&) = delete;
+    private:
+        ConfigService& _service;
+    };
+
+    explicit ConfigService(ConfigManager& store);
+
+    // Adopt the config loaded at boot (already persisted)
+    void begin(const DeviceConfig& loaded);
+
+    // Published config, safe from any task
+    DeviceConfig get() const;
+
+    // Staged copy that the edit screens work on. `generation` changes with
+    // every stage().
+    DeviceConfig getStaged(uint32_t* generation = nullptr) const;
+    void stage(const DeviceConfig& config);
+    // stage() only if nothing was staged since getStaged() gave `generation`
+    bool stageIf(const DeviceConfig& config, uint32_t generation);
+
+    // Make the staged copy live and schedule a write-behind commit
+    void publish();
+
+    // Called (from the publishing task) after every publish
+    void setApplyCallback(void (*callback)(const DeviceConfig&));
+
+    // Commit pending changes now, e.g. before a restart. Any task.
+    void flush();
+
+    uint32_t getCommitCount() const { return _commitCount; }
+    uint32_t getSkippedCount() const { return _skippedCount; }
+    uint32_t getFailedCount() const { return _failedCount; }
+
+private:
+    ConfigManager& _store;
+    DeviceConfig _current;
+    DeviceConfig _staged;
+    DeviceConfig _persisted;
+    uint32_t _stagedGeneration = 0;
+    mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+    TimerHandle_t _commitTimer = nullptr;
+    TaskHandle_t _commitTask = nullptr;
+    SemaphoreHandle_t _flushMutex = nullptr;    // Guards _persisted and the NVS write
+    SemaphoreHandle_t _editMutex = nullptr;     // EditGuard, recursive
+    void (*_applyCallback)(const DeviceConfig&) = nullptr;
+
+    uint32_t _commitCount = 0;
+    uint32_t _skippedCount = 0;
+    uint32_t _failedCount = 0;
+
+    static void onCommitTimer(TimerHandle_t timer);
+    static void commitLoop(void* parameter);
+};
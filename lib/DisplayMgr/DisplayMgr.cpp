@@ -1,7 +1,11 @@
 #include "DisplayMgr.h"
 #include "Logger.h"
+#include "TaskMonitor.h"
+#include "LiveFrame.h"
+#include "ProfileStore.h"
+#include <driver/i2c.h>
 
-DisplayMgr::DisplayMgr() : _oled(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1), _currentState(SCREEN_BOOT) {}
+DisplayMgr::DisplayMgr() : _oled(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1, DISPLAY_I2C_CLOCK_HZ, DISPLAY_I2C_CLOCK_HZ), _currentState(SCREEN_BOOT) {}
 
 void DisplayMgr::begin() {
     LOG_INFO_TAG("DISPLAY", "Initializing OLED display...");
@@ -11,20 +15,50 @@ void DisplayMgr::begin() {
     } else {
         LOG_INFO_TAG("DISPLAY", "OLED initialized successfully");
     }
+    Wire.setClock(DISPLAY_I2C_CLOCK_HZ);
     _oled.clearDisplay();
+
+    // Frames are flushed by a separate task straight through the ESP-IDF I2C
+    // driver that Wire installed, so render() never waits on the bus
+    _txIdle = xSemaphoreCreateBinary();
+    xSemaphoreGive(_txIdle);
+    xTaskCreatePinnedToCore(_flushTaskEntry, "DispFlush", DISP_FLUSH_TASK_STACK, this, 1, &_flushTask, 1);
+    TaskMonitor::watch(_flushTask, DISP_FLUSH_TASK_STACK);
     
     _currentState = SCREEN_STATUS_IP;
 }
 
 void DisplayMgr::render(DeviceConfig& config, IPAddress currentIP, E131Status netStatus) {
-    _oled.clearDisplay();
-    _drawHeader();
+    _composeStart = micros();
+    _renderCalls++;
+    _renderTask = xTaskGetCurrentTaskHandle();
+
+    // A failed flush leaves the panel in an unknown state, so a static screen
+    // must be redrawn even though its model is unchanged. _flushDirty() then
+    // sends the whole frame.
+    if (_flushFailed && millis() - _lastRepaintTime >= DISPLAY_REPAINT_RETRY_MS) {
+        _lastRepaintTime = millis();
+        _modelValid = false;
+    }
 
     // Auto-cycle slideshow if in status mode
-    if (_currentState >= SCREEN_STATUS_IP && _currentState <= SCREEN_STATUS_SENSORS) {
+    if (_currentState >= SCREEN_STATUS_IP && _currentState <= SCREEN_STATUS_CPU) {
         _slideshowLogic(STATUS_SCREEN_LENGTH_MS);
     }
 
+    // Skip the frame entirely if nothing it depends on has changed
+    DisplayModel model;
+    _buildModel(model, config, currentIP, netStatus);
+    if (_modelValid && memcmp(&model, &_lastModel, sizeof(model)) == 0) {
+        _framesSkipped++;
+        return;
+    }
+    _lastModel = model;
+    _modelValid = true;
+
+    _oled.clearDisplay();
+    _drawHeader();
+
     switch(_currentState) {
         case SCREEN_STATUS_IP:
             _drawStatusIP(currentIP, config.useDhcp);
@@ -32,21 +66,206 @@ void DisplayMgr::render(DeviceConfig& config, IPAddress currentIP, E131Status ne
         case SCREEN_STATUS_E131:
             _drawStatusE131(config.universe, config.numLeds, netStatus);
             break;
+        case SCREEN_STATUS_PREVIEW:
+            _drawStatusPreview(config.numLeds);
+            break;
         case SCREEN_STATUS_SENSORS:
             _drawStatusSensors();
             break;
+        case SCREEN_STATUS_CPU:
+            _drawStatusCPU(model);
+            break;
         case SCREEN_MENU_MAIN:
             _drawMainMenu();
             break;
+        case SCREEN_MENU_PROFILES:
+            _drawProfileMenu();
+            break;
         case SCREEN_EDIT_UNIVERSE:
-            _drawEditScreen("SET UNIVERSE", config.universe);
+            _drawEditScreen("SET UNIVERSE", config.universe, UNIVERSE_DIGITS);
             break;
         case SCREEN_EDIT_NUM_LEDS:
-            _drawEditScreen("SET NUM LEDS", config.numLeds);
+            _drawEditScreen("SET NUM LEDS", config.numLeds, NUM_LEDS_DIGITS);
             break;
         default: break;
     }
-    _oled.display();
+    _flushDirty();
+}
+
+void DisplayMgr::_buildModel(DisplayModel& model, const DeviceConfig& config, IPAddress currentIP, E131Status netStatus) {
+    // Zero padding bytes so the model can be compared with memcmp
+    memset(&model, 0, sizeof(model));
+    model.state = _currentState;
+    model.menuIndex = _menuIndex;
+    model.editDigit = _editDigit;
+    model.universe = config.universe;
+    model.numLeds = config.numLeds;
+    model.ipAddress = currentIP;
+    model.useDhcp = config.useDhcp;
+    model.netStatus = netStatus;
+    model.activeProfile = ProfileStore::getActive();
+
+    // Only the CPU page depends on the monitor, so other pages don't redraw every sample
+    if (_currentState == SCREEN_STATUS_CPU) {
+        model.coreLoad[0] = TaskMonitor::getCoreLoad(0);
+        model.coreLoad[1] = TaskMonitor::getCoreLoad(1);
+        model.minStackFree = TaskMonitor::getMinStackFree();
+        TaskMonitor::getMinStackTask(model.minStackTask, sizeof(model.minStackTask));
+    }
+    if (_currentState == SCREEN_MENU_PROFILES) {
+        model.profileGeneration = ProfileStore::getGeneration();
+    }
+
+    // The preview is drawn from this one snapshot, so the strip and the
+    // sparklines always belong to the same instant
+    if (_currentState == SCREEN_STATUS_PREVIEW) {
+        _lastPreviewTime = millis();
+        _previewLen = LiveFrame::snapshot(_previewFrame, sizeof(_previewFrame));
+        LiveFrame::history(_previewPacketRate, _previewRadioFps, PREVIEW_HISTORY_LEN);
+
+        // FNV-1a over everything the page shows
+        uint32_t hash = 2166136261u;
+        auto mix = [&hash](const uint8_t* data, size_t len) {
+            for (size_t i = 0; i < len; i++) hash = (hash ^ data[i]) * 16777619u;
+        };
+        mix(_previewFrame, _previewLen);
+        mix((const uint8_t*)_previewPacketRate, sizeof(_previewPacketRate));
+        mix((const uint8_t*)_previewRadioFps, sizeof(_previewRadioFps));
+        model.previewHash = hash;
+    }
+}
+
+uint8_t DisplayMgr::findDirtySpans(const uint8_t* frame, const uint8_t* shadow, DirtySpan* spans) {
+    uint8_t spanCount = 0;
+
+    // The SSD1306 buffer is page-major: one byte covers 8 vertical pixels of
+    // one column. Find the changed column span of each page.
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        const uint8_t* row = frame + page * SCREEN_WIDTH;
+        const uint8_t* shadowRow = shadow + page * SCREEN_WIDTH;
+
+        int first = 0;
+        while (first < SCREEN_WIDTH && row[first] == shadowRow[first]) first++;
+        if (first == SCREEN_WIDTH) continue;
+        int last = SCREEN_WIDTH - 1;
+        while (row[last] == shadowRow[last]) last--;
+        spans[spanCount++] = {page, (uint8_t)first, (uint8_t)last};
+    }
+    return spanCount;
+}
+
+void DisplayMgr::_flushDirty() {
+    const uint8_t* frame = _oled.getBuffer();
+    DirtySpan spans[SSD1306_PAGES];
+    uint8_t spanCount = 0;
+
+    // A failed transfer leaves the panel in an unknown state: repaint fully
+    if (_flushFailed) {
+        _flushFailed = false;
+        _shadowValid = false;
+    }
+
+    if (_shadowValid) {
+        spanCount = findDirtySpans(frame, _shadow, spans);
+    } else {
+        for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+            spans[spanCount++] = {page, 0, SCREEN_WIDTH - 1};
+        }
+    }
+
+    if (spanCount == 0) {
+        _shadowValid = true;
+        _framesSkipped++;
+        _composeUs = micros() - _composeStart;
+        return;
+    }
+
+    // Hand the dirty spans to the flush task. Composing the next frame can
+    // start as soon as they are copied out of the draw buffer.
+    xSemaphoreTake(_txIdle, portMAX_DELAY);
+    for (uint8_t i = 0; i < spanCount; i++) {
+        uint16_t offset = spans[i].page * SCREEN_WIDTH + spans[i].first;
+        uint16_t len = spans[i].last - spans[i].first + 1;
+        memcpy(_txBuffer + offset, frame + offset, len);
+        memcpy(_shadow + offset, frame + offset, len);
+        _txSpans[i] = spans[i];
+    }
+    _txSpanCount = spanCount;
+    _shadowValid = true;
+    _framesPushed++;
+    _composeUs = micros() - _composeStart;
+    xTaskNotifyGive(_flushTask);
+}
+
+void DisplayMgr::_flushTaskEntry(void* parameter) {
+    static_cast<DisplayMgr*>(parameter)->_flushLoop();
+}
+
+void DisplayMgr::_flushLoop() {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        unsigned long start = micros();
+        bool ok = true;
+        for (uint8_t i = 0; i < _txSpanCount && ok; i++) {
+            ok = _sendSpan(_txSpans[i]);
+        }
+        if (!ok) {
+            if (_flushErrors++ == 0) {
+                LOG_ERROR_TAG("DISPLAY", "OLED I2C transfer failed");
+            }
+            _flushFailed = true;
+            if (_renderTask != nullptr) xTaskNotify(_renderTask, DISPLAY_EVT_REPAINT, eSetBits);
+        }
+        _flushUs = micros() - start;
+        if (_flushUs > _flushMaxUs) _flushMaxUs = _flushUs;
+
+        xSemaphoreGive(_txIdle);
+    }
+}
+
+bool DisplayMgr::_sendSpan(const DirtySpan& span) {
+    // Address window: one page, dirty columns only
+    const uint8_t window[] = {
+        SSD1306_COLUMNADDR, span.first, span.last,
+        SSD1306_PAGEADDR, span.page, span.page
+    };
+    uint16_t len = span.last - span.first + 1;
+
+    _pagesPushed++;
+    _bytesPushed += len;
+
+    return _i2cWrite(0x00, window, sizeof(window)) &&                          // Co = 0, D/C = 0: commands
+           _i2cWrite(0x40, _txBuffer + span.page * SCREEN_WIDTH + span.first, len); // D/C = 1: data
+}
+
+bool DisplayMgr::_i2cWrite(uint8_t control, const uint8_t* data, size_t len) {
+    // The IDF driver has no 32-byte Wire limit, so a whole span goes out in
+    // one transaction. The command link lives in a static buffer (no heap).
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(_i2cCmdBuffer, sizeof(_i2cCmdBuffer));
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (OLED_ADDR << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, control, true);
+    i2c_master_write(cmd, data, len, true);
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_master_cmd_begin((i2c_port_t)DISPLAY_I2C_PORT, cmd, pdMS_TO_TICKS(DISPLAY_I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    return ret == ESP_OK;
+}
+
+void DisplayMgr::printStats() {
+    Serial.println(F("\r\n=== DISPLAY ==="));
+    Serial.printf("Wakeups       : %lu\r\n", (unsigned long)_renderCalls);
+    Serial.printf("Frames pushed : %lu\r\n", (unsigned long)_framesPushed);
+    Serial.printf("Frames skipped: %lu\r\n", (unsigned long)_framesSkipped);
+    Serial.printf("Pages pushed  : %lu\r\n", (unsigned long)_pagesPushed);
+    Serial.printf("Bytes pushed  : %lu (full frames: %lu)\r\n", (unsigned long)_bytesPushed,
+                  (unsigned long)(_framesPushed * SSD1306_BUFFER_SIZE));
+    Serial.printf("Compose time  : %lu us\r\n", (unsigned long)_composeUs);
+    Serial.printf("Flush time    : %lu us (max %lu us)\r\n", (unsigned long)_flushUs, (unsigned long)_flushMaxUs);
+    Serial.printf("Flush errors  : %lu\r\n", (unsigned long)_flushErrors);
+    Serial.printf("I2C clock     : %lu Hz\r\n", (unsigned long)DISPLAY_I2C_CLOCK_HZ);
+    Serial.println(F("===============\r\n"));
 }
 
 void DisplayMgr::_drawHeader() {
@@ -77,6 +296,50 @@ void DisplayMgr::_drawStatusE131(uint16_t universe, uint16_t numLeds, E131Status
     }
 }
 
+void DisplayMgr::_drawStatusPreview(uint16_t numLeds) {
+    // Pixel strip: one bar per LED, height from its brightest channel
+    const int16_t stripTop = 11;
+    const int16_t stripHeight = 22;
+    uint16_t leds = min<uint16_t>(numLeds, _previewLen / CHAN_PER_LED);
+
+    if (leds == 0) {
+        _oled.setCursor(0, 18);
+        _oled.print(F("No frame data"));
+    } else {
+        int16_t pitch = max(1, SCREEN_WIDTH / leds);
+        int16_t barWidth = pitch >= 3 ? pitch - 1 : pitch;
+        for (uint16_t i = 0; i < leds; i++) {
+            const uint8_t* px = &_previewFrame[i * CHAN_PER_LED];
+            uint8_t level = max(px[0], max(px[1], px[2]));
+            int16_t h = (level * stripHeight + 254) / 255;
+            if (h > 0) {
+                _oled.fillRect(i * pitch, stripTop + stripHeight - h, barWidth, h, SSD1306_WHITE);
+            }
+        }
+    }
+
+    // Rolling one-second rates
+    _oled.setCursor(0, 38);
+    _oled.print(F("Pk ")); _oled.print(_previewPacketRate[PREVIEW_HISTORY_LEN - 1]);
+    _drawSparkline(SCREEN_WIDTH - PREVIEW_HISTORY_LEN * 2, 36, 11, _previewPacketRate, PREVIEW_HISTORY_LEN);
+    _oled.setCursor(0, 52);
+    _oled.print(F("TX ")); _oled.print(_previewRadioFps[PREVIEW_HISTORY_LEN - 1]);
+    _drawSparkline(SCREEN_WIDTH - PREVIEW_HISTORY_LEN * 2, 50, 11, _previewRadioFps, PREVIEW_HISTORY_LEN);
+}
+
+void DisplayMgr::_drawSparkline(int16_t x, int16_t y, int16_t h, const uint16_t* samples, uint8_t count) {
+    uint16_t peak = 1;
+    for (uint8_t i = 0; i < count; i++) peak = max(peak, samples[i]);
+
+    // Two pixels per sample, scaled to the window's peak
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t bar = ((uint32_t)samples[i] * h + peak - 1) / peak;
+        if (bar > 0) {
+            _oled.drawFastVLine(x + i * 2, y + h - bar, bar, SSD1306_WHITE);
+        }
+    }
+}
+
 void DisplayMgr::_drawStatusSensors() {
     _oled.setCursor(0, 15);
     _oled.println(F("Sensors:"));
@@ -86,41 +349,96 @@ void DisplayMgr::_drawStatusSensors() {
     _oled.print(F("Temperature: --.- F"));
 }
 
+// Drawn from the model, so the page shows exactly what the skip test compared
+void DisplayMgr::_drawStatusCPU(const DisplayModel& model) {
+    _oled.setCursor(0, 15);
+    _oled.println(F("CPU Load:"));
+    for (uint8_t core = 0; core < 2; core++) {
+        int8_t load = model.coreLoad[core];
+        _oled.print(F("  Core ")); _oled.print(core); _oled.print(F(": "));
+        if (load < 0) _oled.println(F("--"));
+        else { _oled.print(load); _oled.println(F("%")); }
+    }
+    _oled.setCursor(0, 45);
+    _oled.print(F("Min stk: "));
+    _oled.print(model.minStackTask);
+    _oled.setCursor(0, 55);
+    _oled.print(F("  ")); _oled.print(model.minStackFree); _oled.print(F(" B free"));
+}
+
 void DisplayMgr::_drawMainMenu() {
-    const char* items[] = {"Exit", "Set Universe", "Set Num LEDs"};
+    const char* items[] = {"Exit", "Set Universe", "Set Num LEDs", "Profiles"};
     _oled.setCursor(0, 15);
-    for(int i=0; i<3; i++) {
+    for(int i=0; i<4; i++) {
         if(i == _menuIndex) _oled.print(F("> "));
         else _oled.print(F("  "));
         _oled.println(items[i]);
     }
 }
 
-void DisplayMgr::_drawEditScreen(const char* title, int value) {
+void DisplayMgr::_drawProfileMenu() {
+    // Row 0 is Back, rows 1..PROFILE_COUNT are the slots
+    _oled.setCursor(0, 15);
+    _oled.println(_menuIndex == 0 ? F("> Back") : F("  Back"));
+    for (uint8_t slot = 0; slot < PROFILE_COUNT; slot++) {
+        char name[PROFILE_NAME_LENGTH];
+        if (!ProfileStore::getName(slot, name, sizeof(name))) {
+            strlcpy(name, "(empty)", sizeof(name));
+        }
+        _oled.print(_menuIndex == slot + 1 ? F("> ") : F("  "));
+        _oled.printf("%d %s%s\n", slot + 1, name, ProfileStore::getActive() == slot ? " *" : "");
+    }
+}
+
+void DisplayMgr::_drawEditScreen(const char* title, int value, uint8_t digits) {
     _oled.setCursor(0, 15);
     _oled.println(title);
     _oled.setCursor(10, 35);
     _oled.setTextSize(2);
-    _oled.print(value);
+    // Zero-padded so every digit has a fixed position to select
+    _oled.printf("%0*d", digits, value);
     _oled.setTextSize(1);
+    // Underline the digit UP/DOWN will change (12 px per size-2 character)
+    _oled.drawFastHLine(10 + (digits - 1 - _editDigit) * 12, 52, 10, SSD1306_WHITE);
     _oled.setCursor(110, 35);
     _oled.print(F("<>"));
 }
 
+uint32_t DisplayMgr::msUntilNextUpdate() const {
+    // Retry a failed flush on any screen
+    uint32_t repaint = UINT32_MAX;
+    if (_flushFailed) {
+        uint32_t sinceRepaint = millis() - _lastRepaintTime;
+        repaint = sinceRepaint < DISPLAY_REPAINT_RETRY_MS ? DISPLAY_REPAINT_RETRY_MS - sinceRepaint : 0;
+    }
+
+    if (_currentState < SCREEN_STATUS_IP || _currentState > SCREEN_STATUS_CPU) {
+        return repaint;
+    }
+    uint32_t elapsed = millis() - _lastSlideshowTime;
+    uint32_t wait = elapsed < STATUS_SCREEN_LENGTH_MS ? STATUS_SCREEN_LENGTH_MS - elapsed : 0;
+
+    if (_currentState == SCREEN_STATUS_PREVIEW) {
+        uint32_t sincePreview = millis() - _lastPreviewTime;
+        wait = min<uint32_t>(wait, sincePreview < PREVIEW_REFRESH_MS ? PREVIEW_REFRESH_MS - sincePreview : 0);
+    }
+    return min(wait, repaint);
+}
+
 void DisplayMgr::_slideshowLogic(uint16_t intervalMs) {
     if (millis() - _lastSlideshowTime > intervalMs) {
         _lastSlideshowTime = millis();
         int next = (int)_currentState + 1;
-        if (next > SCREEN_STATUS_SENSORS) next = SCREEN_STATUS_IP;
+        if (next > SCREEN_STATUS_CPU) next = SCREEN_STATUS_IP;
         _currentState = (ScreenState)next;
     }
 }
 
-void DisplayMgr::handleButtonPress(int button, DeviceConfig& config, void (*saveCallback)(const DeviceConfig&)) {
-    LOG_DEBUG_TAG("DISPLAY", "Button pressed: %d", button);
+void DisplayMgr::handleButtonPress(int button, uint16_t step, DeviceConfig& config, void (*saveCallback)(const DeviceConfig&)) {
+    LOG_DEBUG_TAG("DISPLAY", "Button pressed: %d (x%d)", button, step);
     
     // 1. Any button interrupts slideshow
-    if (_currentState <= SCREEN_STATUS_SENSORS) {
+    if (_currentState <= SCREEN_STATUS_CPU) {
         _currentState = SCREEN_MENU_MAIN;
         _menuIndex = 0;
         LOG_DEBUG_TAG("DISPLAY", "Entered menu mode");
@@ -130,7 +448,7 @@ void DisplayMgr::handleButtonPress(int button, DeviceConfig& config, void (*save
     // 2. Main Menu
     if (_currentState == SCREEN_MENU_MAIN) {
         if (button == BTN_UP)   _menuIndex = max(0, _menuIndex - 1);
-        if (button == BTN_DOWN) _menuIndex = min(2, _menuIndex + 1); 
+        if (button == BTN_DOWN) _menuIndex = min(3, _menuIndex + 1); 
         if (button == BTN_SEL) {
             switch(_menuIndex) {
                 case 0: 
@@ -139,42 +457,62 @@ void DisplayMgr::handleButtonPress(int button, DeviceConfig& config, void (*save
                     break; 
                 case 1: 
                     _currentState = SCREEN_EDIT_UNIVERSE;
+                    _editDigit = 0;
                     LOG_DEBUG_TAG("DISPLAY", "Editing universe");
                     break;
                 case 2: 
                     _currentState = SCREEN_EDIT_NUM_LEDS;
+                    _editDigit = 0;
                     LOG_DEBUG_TAG("DISPLAY", "Editing num LEDs");
                     break;
+                case 3:
+                    _currentState = SCREEN_MENU_PROFILES;
+                    _menuIndex = max(0, ProfileStore::getActive() + 1);
+                    break;
+            }
+        }
+    }
+
+    // Profile list: SEL on a slot publishes it straight away
+    else if (_currentState == SCREEN_MENU_PROFILES) {
+        if (button == BTN_UP)   _menuIndex = max(0, _menuIndex - 1);
+        if (button == BTN_DOWN) _menuIndex = min(PROFILE_COUNT, _menuIndex + 1);
+        if (button == BTN_SEL) {
+            if (_menuIndex == 0) {
+                _currentState = SCREEN_MENU_MAIN;
+                _menuIndex = 3;
+            } else if (ProfileStore::applyTo(_menuIndex - 1, config)) {
+                saveCallback(config);
+                _currentState = SCREEN_STATUS_E131;
+                _lastSlideshowTime = millis();
             }
         }
     }
 
     // 3. Edit Screens
     else if (_currentState == SCREEN_EDIT_UNIVERSE || _currentState == SCREEN_EDIT_NUM_LEDS) {
-        uint16_t* target = (_currentState == SCREEN_EDIT_UNIVERSE) ? &config.universe : &config.numLeds;
+        bool editingUniverse = (_currentState == SCREEN_EDIT_UNIVERSE);
+        uint16_t* target = editingUniverse ? &config.universe : &config.numLeds;
+        int32_t minValue = editingUniverse ? MIN_UNIVERSE : MIN_NUM_LEDS;
+        int32_t maxValue = editingUniverse ? MAX_UNIVERSE : MAX_NUM_LEDS;
+        uint8_t digits = editingUniverse ? UNIVERSE_DIGITS : NUM_LEDS_DIGITS;
+
+        // UP/DOWN change the selected digit; held buttons accelerate via step
+        int32_t delta = (int32_t)step;
+        for (uint8_t i = 0; i < _editDigit; i++) delta *= 10;
         
         switch (button) {
             case BTN_UP:
-                if (_currentState == SCREEN_EDIT_UNIVERSE) {
-                    if (*target < MAX_UNIVERSE) (*target)++;
-                } else if (_currentState == SCREEN_EDIT_NUM_LEDS) {
-                    if (*target < MAX_NUM_LEDS) (*target)++;
-                } else {
-                    (*target)++;
-                }
+                *target = (uint16_t)min(maxValue, (int32_t)*target + delta);
                 break;
             case BTN_DOWN:
-                if (_currentState == SCREEN_EDIT_UNIVERSE) {
-                    if (*target > MIN_UNIVERSE) (*target)--;
-                } else if (_currentState == SCREEN_EDIT_NUM_LEDS) {
-                    if (*target > MIN_NUM_LEDS) (*target)--;
-                } else {
-                    if (*target > 0) (*target)--;
-                }
+                *target = (uint16_t)max(minValue, (int32_t)*target - delta);
                 break;
             case BTN_LEFT:
+                if (_editDigit < digits - 1) _editDigit++;
                 break;
             case BTN_RIGHT:
+                if (_editDigit > 0) _editDigit--;
                 break;
             case BTN_SEL:
                 LOG_INFO_TAG("DISPLAY", "Saving configuration changes");
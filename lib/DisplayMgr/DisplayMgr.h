@@ -3,6 +3,8 @@
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
 #include "Config.h"
 #include "ConfigData.h"
 
@@ -11,9 +13,12 @@ enum ScreenState {
     // Slideshow States
     SCREEN_STATUS_IP,      
     SCREEN_STATUS_E131,    
+    SCREEN_STATUS_PREVIEW,
     SCREEN_STATUS_SENSORS, 
+    SCREEN_STATUS_CPU,
     // Menu States
     SCREEN_MENU_MAIN,
+    SCREEN_MENU_PROFILES,
     // Edit States
     SCREEN_EDIT_UNIVERSE,
     SCREEN_EDIT_NUM_LEDS,
@@ -27,29 +32,128 @@ enum E131Status {
     STATUS_IDLE          
 };
 
+// Reasons to wake the display task (task notification bits)
+enum DisplayEvent : uint32_t {
+    DISPLAY_EVT_BUTTON  = 1 << 0,
+    DISPLAY_EVT_STATUS  = 1 << 1,
+    DISPLAY_EVT_CONFIG  = 1 << 2,
+    DISPLAY_EVT_METRICS = 1 << 3,
+    DISPLAY_EVT_REPAINT = 1 << 4    // A flush failed; the panel needs a full repaint
+};
+
+#define UNIVERSE_DIGITS 5   // MAX_UNIVERSE = 63999
+#define NUM_LEDS_DIGITS 2   // MAX_NUM_LEDS = 50
+
+#define SSD1306_PAGES (SCREEN_HEIGHT / 8)
+#define SSD1306_BUFFER_SIZE (SCREEN_WIDTH * SSD1306_PAGES)
+
+// Everything a frame depends on. If it hasn't changed since the last frame
+// the frame is skipped without drawing.
+struct DisplayModel {
+    ScreenState state;
+    int menuIndex;
+    uint8_t editDigit;
+    uint16_t universe;
+    uint16_t numLeds;
+    uint32_t ipAddress;
+    bool useDhcp;
+    E131Status netStatus;
+    int8_t coreLoad[2];
+    uint32_t minStackFree;
+    char minStackTask[configMAX_TASK_NAME_LEN];
+    uint32_t previewHash;
+    int8_t activeProfile;
+    uint32_t profileGeneration;     // Slot names, which only the profile list shows
+};
+
 class DisplayMgr {
 public:
     DisplayMgr();
     void begin();
 
     void render(DeviceConfig& config, IPAddress currentIP, E131Status netStatus);
-    void handleButtonPress(int button, DeviceConfig& config, void (*saveCallback)(const DeviceConfig&));
+    // step is the auto-repeat acceleration (1, 10, 100) applied on top of the
+    // selected digit
+    void handleButtonPress(int button, uint16_t step, DeviceConfig& config, void (*saveCallback)(const DeviceConfig&));
+
+    // Time until the next timed redraw (slideshow advance, preview refresh
+    // or a repaint after a failed flush), UINT32_MAX if none is due
+    uint32_t msUntilNextUpdate() const;
+
+    void printStats();
+
+    struct DirtySpan {
+        uint8_t page;
+        uint8_t first;
+        uint8_t last;
+    };
+    // Change detection between a frame and the copy on the panel: the
+    // changed column range of every page that differs. Returns the span count.
+    static uint8_t findDirtySpans(const uint8_t* frame, const uint8_t* shadow, DirtySpan* spans);
 
 private:
+
     Adafruit_SSD1306 _oled;
+
+    // Retained-mode state: last model drawn and last frame sent to the panel
+    DisplayModel _lastModel;
+    bool _modelValid = false;
+    uint8_t _shadow[SSD1306_BUFFER_SIZE];
+    bool _shadowValid = false;
+
+    // Preview page data, snapshotted once per frame in _buildModel()
+    uint8_t _previewFrame[MAX_NUM_LEDS * CHAN_PER_LED];
+    uint16_t _previewLen = 0;
+    uint16_t _previewPacketRate[PREVIEW_HISTORY_LEN];
+    uint16_t _previewRadioFps[PREVIEW_HISTORY_LEN];
+    unsigned long _lastPreviewTime = 0;
+
+    // Second frame buffer owned by the flush task while _txIdle is taken
+    uint8_t _txBuffer[SSD1306_BUFFER_SIZE];
+    DirtySpan _txSpans[SSD1306_PAGES];
+    uint8_t _txSpanCount = 0;
+    SemaphoreHandle_t _txIdle = nullptr;
+    TaskHandle_t _flushTask = nullptr;
+    volatile bool _flushFailed = false;
+    TaskHandle_t _renderTask = nullptr;     // Woken with DISPLAY_EVT_REPAINT
+    unsigned long _lastRepaintTime = 0;
+    uint8_t _i2cCmdBuffer[I2C_LINK_RECOMMENDED_SIZE(4)];
+
+    // Render statistics
+    uint32_t _renderCalls = 0;
+    uint32_t _framesSkipped = 0;
+    uint32_t _framesPushed = 0;
+    volatile uint32_t _pagesPushed = 0;
+    volatile uint32_t _bytesPushed = 0;
+    unsigned long _composeStart = 0;
+    volatile uint32_t _composeUs = 0;
+    volatile uint32_t _flushUs = 0;
+    volatile uint32_t _flushMaxUs = 0;
+    volatile uint32_t _flushErrors = 0;
     ScreenState _currentState;
     unsigned long _lastSlideshowTime = 0;
     
     // Menu Navigation
     int _menuIndex = 0;
+    uint8_t _editDigit = 0;     // 0 = ones, 1 = tens, ...
 
     // Helpers
     void _drawHeader();
     void _drawStatusIP(IPAddress ip, bool dhcp);
     void _drawStatusE131(uint16_t universe, uint16_t numLeds, E131Status status);
+    void _drawStatusPreview(uint16_t numLeds);
+    void _drawSparkline(int16_t x, int16_t y, int16_t h, const uint16_t* samples, uint8_t count);
     void _drawStatusSensors();
+    void _drawStatusCPU(const DisplayModel& model);
     void _drawMainMenu();
-    void _drawEditScreen(const char* title, int value);
+    void _drawProfileMenu();
+    void _drawEditScreen(const char* title, int value, uint8_t digits);
     
     void _slideshowLogic(uint16_t intervalMs);
+    void _buildModel(DisplayModel& model, const DeviceConfig& config, IPAddress currentIP, E131Status netStatus);
+    void _flushDirty();
+    static void _flushTaskEntry(void* parameter);
+    void _flushLoop();
+    bool _sendSpan(const DirtySpan& span);
+    bool _i2cWrite(uint8_t control, const uint8_t* data, size_t len);
 };
\ No newline at end of file
@@ -1,19 +1,43 @@
 #include "E131Handler.h"
 #include "Logger.h"
+#include "LatencyTrace.h"
+#include "EthBus.h"
+#include "HotPath.h"
+#include <utility/w5100.h>
+
+#define W5500_MR_RST 0x80
+#define W5500_VERSION 0x04              // VERSIONR; a dead or unpowered chip reads 0x00 or 0xFF
+
+// Fixed E1.31 header fields (ANSI E1.31-2018, section 4)
+static const uint8_t ACN_PACKET_ID[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+#define VECTOR_ROOT_E131_DATA 0x00000004
+#define VECTOR_E131_DATA_PACKET 0x00000002
+#define VECTOR_DMP_SET_PROPERTY 0x02
+
+static uint32_t HOT_PATH_ATTR readU32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
 
 void E131Handler::begin(byte* mac, IPAddress ip) {
     LOG_INFO_TAG("E131", "Initializing Ethernet...");
+    memcpy(_mac, mac, sizeof(_mac));
+    _ip = ip;
+
+    EthBus::begin();
+    EthBus::Guard bus;
+
     SPI.begin(ETH_SCK, ETH_MISO, ETH_MOSI, ETH_CS);
     Ethernet.init(ETH_CS);
-    
-    if (Ethernet.hardwareStatus() == EthernetNoHardware) {
+    Ethernet.begin(mac, ip);
+
+    if (!_chipResponds()) {
         LOG_ERROR_TAG("E131", "W5500 hardware not detected!");
     } else {
         LOG_DEBUG_TAG("E131", "W5500 hardware detected");
     }
-    
-    Ethernet.begin(mac, ip);
+
     _udp.begin(E131_PORT);
+    _controlUdp.begin(CONTROL_UDP_PORT);
     
     LOG_INFO_TAG("E131", "Listening on port %d, IP: %d.%d.%d.%d", 
                  E131_PORT, ip[0], ip[1], ip[2], ip[3]);
@@ -27,66 +51,341 @@ void E131Handler::setUniverse(uint16_t universe) {
 }
 
 bool E131Handler::checkHardware() {
-    static bool lastHardwareOk = true;
-    static bool lastLinkOk = true;
+    unsigned long now = millis();
+
+    // Between polls the cached state is returned without touching SPI
+    if (_status.lastPollTime != 0 && now - _status.lastPollTime < ETH_STATUS_POLL_MS) {
+        return _status.hardwareOk && _status.linkUp;
+    }
+    _status.lastPollTime = now ? now : 1;
     
-    bool hardwareOk = (Ethernet.hardwareStatus() != EthernetNoHardware);
-    bool linkOk = (Ethernet.linkStatus() != LinkOFF);
+    bool hardwareOk;
+    bool linkOk;
+    {
+        EthBus::Guard bus;
+        // hardwareStatus() is cached from boot; a wedged or unpowered chip
+        // only shows in a register read, and its PHYCFGR reads as link down
+        hardwareOk = _chipResponds();
+        linkOk = hardwareOk && Ethernet.linkStatus() != LinkOFF;
+    }
     
     // Log status changes
-    if (hardwareOk != lastHardwareOk) {
+    if (hardwareOk != _status.hardwareOk) {
         if (!hardwareOk) {
             LOG_ERROR_TAG("E131", "Hardware failure detected");
         }
-        lastHardwareOk = hardwareOk;
     }
     
-    if (linkOk != lastLinkOk) {
+    if (linkOk != _status.linkUp) {
         if (linkOk) {
             LOG_INFO_TAG("E131", "Link UP - cable connected");
         } else {
             LOG_WARN_TAG("E131", "Link DOWN - cable disconnected");
         }
-        lastLinkOk = linkOk;
     }
+
+    // Self-healing: a chip that fails the read-back, or a silence with the
+    // E1.31 socket no longer open, means the W5500 has wedged. Silence on a
+    // healthy chip is a paused show and is only logged. Retries are rate
+    // limited so a dead chip doesn't starve the loop.
+    if (now - _lastRecoveryTime >= E131_RECOVERY_BACKOFF_MS) {
+        if (!hardwareOk) {
+            hardwareOk = recover("no hardware");
+            if (hardwareOk) {
+                EthBus::Guard bus;
+                linkOk = Ethernet.linkStatus() != LinkOFF;
+            }
+        } else if (linkOk && _stallArmed && now - _lastRxTime >= E131_RX_STALL_MS) {
+            _stallArmed = false;
+            bool socketOk;
+            {
+                EthBus::Guard bus;
+                socketOk = _socketOpen(E131_PORT);
+            }
+            if (socketOk) {
+                LOG_INFO_TAG("E131", "No E1.31 for %lu ms, W5500 healthy", now - _lastRxTime);
+            } else {
+                recover("socket lost");
+            }
+        }
+    }
+
+    _status.hardwareOk = hardwareOk;
+    _status.linkUp = linkOk;
     
     return hardwareOk && linkOk;
 }
 
-int E131Handler::parsePacket(uint8_t* dmxOutputBuffer) {
+// Caller holds the bus. A chip that browned out answers again with its
+// config lost, so the IP must read back too.
+bool E131Handler::_chipResponds() {
+    uint8_t ip[4];
+    SPI.beginTransaction(SPI_ETHERNET_SETTINGS);
+    uint8_t version = W5100.readVERSIONR_W5500();
+    W5100.getIPAddress(ip);
+    SPI.endTransaction();
+    return version == W5500_VERSION && IPAddress(ip[0], ip[1], ip[2], ip[3]) == _ip;
+}
+
+// Caller holds the bus
+bool E131Handler::_socketOpen(uint16_t port) {
+    bool open = false;
+    SPI.beginTransaction(SPI_ETHERNET_SETTINGS);
+    for (SOCKET s = 0; s < MAX_SOCK_NUM && !open; s++) {
+        open = W5100.readSnSR(s) == SnSR::UDP && W5100.readSnPORT(s) == port;
+    }
+    SPI.endTransaction();
+    return open;
+}
+
+bool E131Handler::recover(const char* reason) {
+    LOG_WARN_TAG("E131", "Recovering W5500 (%s)", reason);
+    EthBus::Guard bus;
+    unsigned long start = micros();
+    _lastRecoveryTime = millis();
+    _stallArmed = false;
+
+    _udp.stop();
+    _controlUdp.stop();
+
+    // Soft reset: the RST bit self-clears once the chip has reset
+    SPI.beginTransaction(SPI_ETHERNET_SETTINGS);
+    W5100.writeMR(W5500_MR_RST);
+    bool resetDone = false;
+    for (int i = 0; i < 20 && !resetDone; i++) {
+        delay(1);
+        resetDone = (W5100.readMR() & W5500_MR_RST) == 0;
+    }
+    SPI.endTransaction();
+
+    // Reapply MAC/IP (the chip is already initialized, so this skips the
+    // power-on delay) and reopen the socket
+    Ethernet.begin(_mac, _ip);
+    _udp.begin(E131_PORT);
+    _controlUdp.begin(CONTROL_UDP_PORT);
+
+    // The chip must answer and hold the config it was just given
+    bool success = resetDone && _chipResponds();
+
+    uint32_t duration = micros() - start;
+    RecoveryEvent& event = _recoveryLog[_recoveryLogIndex];
+    event.timestamp = _lastRecoveryTime;
+    event.durationUs = duration;
+    event.reason = reason;
+    event.success = success;
+    _recoveryLogIndex = (_recoveryLogIndex + 1) % E131_RECOVERY_LOG_SIZE;
+    _recoveryCount++;
+
+    if (!success) {
+        LOG_ERROR_TAG("E131", "W5500 recovery failed after %lu us", (unsigned long)duration);
+    } else if (duration > E131_RECOVERY_BUDGET_US) {
+        LOG_WARN_TAG("E131", "W5500 recovered in %lu us (over %d us budget)", (unsigned long)duration, E131_RECOVERY_BUDGET_US);
+    } else {
+        LOG_INFO_TAG("E131", "W5500 recovered in %lu us", (unsigned long)duration);
+    }
+    return success;
+}
+
+void E131Handler::printRecoveryLog() {
+    Serial.println(F("\r\n=== W5500 RECOVERIES ==="));
+    Serial.printf("Total: %lu\r\n", (unsigned long)_recoveryCount);
+    for (int i = 0; i < E131_RECOVERY_LOG_SIZE; i++) {
+        int idx = (_recoveryLogIndex + i) % E131_RECOVERY_LOG_SIZE;
+        const RecoveryEvent& event = _recoveryLog[idx];
+        if (event.reason == nullptr) continue;
+        Serial.printf("[%8lu] %-12s %8lu us %s\r\n", event.timestamp, event.reason,
+                      (unsigned long)event.durationUs, event.success ? "OK" : "FAILED");
+    }
+    Serial.println(F("========================\r\n"));
+}
+
+E131HeaderStatus HOT_PATH_ATTR E131Handler::parseHeader(const uint8_t* header, uint16_t universe, uint16_t& slotCount) {
+    // Only E1.31 data packets
+    if (memcmp(header + E131_ACN_ID_OFFSET, ACN_PACKET_ID, sizeof(ACN_PACKET_ID)) != 0 ||
+        readU32(header + E131_ROOT_VECTOR_OFFSET) != VECTOR_ROOT_E131_DATA ||
+        readU32(header + E131_FRAMING_VECTOR_OFFSET) != VECTOR_E131_DATA_PACKET ||
+        header[E131_DMP_VECTOR_OFFSET] != VECTOR_DMP_SET_PROPERTY) {
+        return E131_HEADER_NOT_DATA;
+    }
+
+    uint16_t rxUniverse = (header[E131_UNIVERSE_OFFSET] << 8) | header[E131_UNIVERSE_OFFSET+1];
+    if (rxUniverse != universe) return E131_HEADER_OTHER_UNIVERSE;
+
+    if (header[E131_LENGTH_OFFSET+2] != DMX_STARTCODE) return E131_HEADER_BAD_START_CODE;
+
+    // The property value count includes the start code, so 0 is malformed
+    uint16_t valueCount = (header[E131_LENGTH_OFFSET] << 8) | header[E131_LENGTH_OFFSET+1];
+    if (valueCount == 0) return E131_HEADER_BAD_VALUE_COUNT;
+
+    slotCount = valueCount - 1;
+    if (slotCount > DMX_MAX_CHANNELS) slotCount = DMX_MAX_CHANNELS;
+    return E131_HEADER_OK;
+}
+
+void E131Handler::printRxStats() {
+    E131RxStats stats = _rxStats;
+    float seconds = (millis() - stats.sinceMs) / 1000.0f;
+    if (seconds <= 0) seconds = 0.001f;
+    uint32_t expected = stats.frames + stats.sequenceLost;
+
+    Serial.println(F("\r\n=== E1.31 RX ==="));
+    Serial.printf("Window:     %.1f s\r\n", seconds);
+    Serial.printf("Datagrams:  %lu (%.1f/s)\r\n", (unsigned long)stats.datagrams, stats.datagrams / seconds);
+    Serial.printf("Frames:     %lu (%.1f/s)\r\n", (unsigned long)stats.frames, stats.frames / seconds);
+    Serial.printf("Lost:       %lu (%.2f%% of sequence)\r\n", (unsigned long)stats.sequenceLost,
+                  expected ? 100.0f * stats.sequenceLost / expected : 0.0f);
+    Serial.printf("Late/dup:   %lu\r\n", (unsigned long)stats.outOfOrder);
+    Serial.printf("Rejected:   short %lu, not data %lu, universe %lu, start code %lu, count %lu\r\n",
+                  (unsigned long)stats.tooShort, (unsigned long)stats.notData, (unsigned long)stats.otherUniverse,
+                  (unsigned long)stats.badStartCode, (unsigned long)stats.badValueCount);
+    Serial.printf("Sources:    %lu\r\n", (unsigned long)stats.sources);
+    Serial.println(F("================\r\n"));
+}
+
+// Sequence numbers are per source and universe (E1.31 section 6.7.2); only
+// our universe gets here. A step back within E131_SEQUENCE_WINDOW is a late
+// or repeated packet, anything further back a restarted source.
+void HOT_PATH_ATTR E131Handler::_trackSequence(const uint8_t* header) {
+    const uint8_t* cid = header + E131_CID_OFFSET;
+    uint8_t sequence = header[E131_SEQUENCE_OFFSET];
+    unsigned long now = millis();
+
+    SourceSequence* source = nullptr;
+    SourceSequence* victim = &_sources[0];
+    for (int i = 0; i < E131_STATS_SOURCES; i++) {
+        SourceSequence& s = _sources[i];
+        if (s.used && memcmp(s.cid, cid, sizeof(s.cid)) == 0) {
+            source = &s;
+            break;
+        }
+        // Free slot first, otherwise the least recently heard source
+        if (victim->used && (!s.used || s.lastSeen < victim->lastSeen)) victim = &s;
+    }
+
+    if (source == nullptr) {
+        memcpy(victim->cid, cid, sizeof(victim->cid));
+        victim->used = true;
+        victim->sequence = sequence;
+        victim->lastSeen = now;
+        _rxStats.sources++;
+        return;
+    }
+
+    source->lastSeen = now;
+    int8_t step = (int8_t)(sequence - source->sequence);
+    if (step <= 0 && step > -E131_SEQUENCE_WINDOW) {
+        _rxStats.outOfOrder++;
+        return;
+    }
+    if (step > 1) _rxStats.sequenceLost += step - 1;
+    source->sequence = sequence;
+}
+
+int HOT_PATH_ATTR E131Handler::parsePacket(uint8_t* dmxOutputBuffer) {
+    if (_rxStatsResetPending) {
+        _rxStatsResetPending = false;
+        memset(&_rxStats, 0, sizeof(_rxStats));
+        memset(_sources, 0, sizeof(_sources));
+        _rxStats.sinceMs = millis();
+    }
+
+    EthBus::Guard bus;
     int packetSize = _udp.parsePacket();
     
     if (packetSize > 0) {
-        _udp.read(_packetBuffer, min(packetSize, E131_MAX_PACKET_SIZE));
+        TRACE_BEGIN_FRAME();
+        _lastRxTime = millis();
+        _stallArmed = true;
+        _rxPackets++;
+        _rxStats.datagrams++;
 
         if (packetSize < E131_HEADER_SIZE) {
+            _rxStats.tooShort++;
             LOG_WARN_TAG("E131", "Packet too small: %d bytes", packetSize);
+            TRACE_ABORT_FRAME();
             return 0;
         }
 
-        // Check Universe
-        uint16_t rxUniverse = (_packetBuffer[E131_UNIVERSE_OFFSET] << 8) |
-            _packetBuffer[E131_UNIVERSE_OFFSET+1];
-        if (rxUniverse != _universe) {
-            LOG_DEBUG_TAG("E131", "Universe mismatch: got %d, expected %d", rxUniverse, _universe);
+        // Read only the header first; the payload is copied straight into
+        // the caller's buffer once the packet is known to be ours.
+        if (_udp.read(_packetBuffer, E131_HEADER_SIZE) != E131_HEADER_SIZE) {
+            _rxStats.tooShort++;
+            LOG_WARN_TAG("E131", "Short header read");
+            TRACE_ABORT_FRAME();
             return 0;
         }
+        TRACE_MARK(TRACE_HEADER_READ);
 
-        // Check DMX start code
-        if (_packetBuffer[E131_LENGTH_OFFSET+2] != DMX_STARTCODE) {
-            LOG_WARN_TAG("E131", "Invalid DMX start code: 0x%02X", _packetBuffer[E131_LENGTH_OFFSET+2]);
+        uint16_t dmxLen;
+        E131HeaderStatus status = parseHeader(_packetBuffer, _universe, dmxLen);
+        if (status != E131_HEADER_OK) {
+            switch (status) {
+                case E131_HEADER_NOT_DATA:
+                    _rxStats.notData++;
+                    LOG_DEBUG_TAG("E131", "Not an E1.31 data packet");
+                    break;
+                case E131_HEADER_OTHER_UNIVERSE:
+                    _rxStats.otherUniverse++;
+                    LOG_DEBUG_TAG("E131", "Universe mismatch: got %d, expected %d",
+                        (_packetBuffer[E131_UNIVERSE_OFFSET] << 8) | _packetBuffer[E131_UNIVERSE_OFFSET+1], _universe);
+                    break;
+                case E131_HEADER_BAD_START_CODE:
+                    _rxStats.badStartCode++;
+                    LOG_WARN_TAG("E131", "Invalid DMX start code: 0x%02X", _packetBuffer[E131_LENGTH_OFFSET+2]);
+                    break;
+                default:
+                    _rxStats.badValueCount++;
+                    LOG_WARN_TAG("E131", "Invalid property value count: 0");
+                    break;
+            }
+            TRACE_ABORT_FRAME();
             return 0;
         }
+        _trackSequence(_packetBuffer);
 
-        uint16_t dmxLen = ((_packetBuffer[E131_LENGTH_OFFSET] << 8) |
-            _packetBuffer[E131_LENGTH_OFFSET+1]) - 1;
-        uint8_t* dmxDataPtr = &_packetBuffer[E131_HEADER_SIZE];
+        // Never trust the count beyond what actually arrived
+        uint16_t received = packetSize - E131_HEADER_SIZE;
+        if (dmxLen > received) {
+            LOG_DEBUG_TAG("E131", "Value count %d exceeds %d received slots", dmxLen, received);
+            dmxLen = received;
+        }
 
-        if(dmxLen > DMX_MAX_CHANNELS) dmxLen = DMX_MAX_CHANNELS;
-        memcpy(dmxOutputBuffer, dmxDataPtr, dmxLen);
+        int got = dmxLen > 0 ? _udp.read(dmxOutputBuffer, dmxLen) : 0;
+        if (got <= 0) {
+            TRACE_ABORT_FRAME();
+            return 0;
+        }
+        dmxLen = (uint16_t)got;
+        _rxStats.frames++;
+        TRACE_MARK(TRACE_PAYLOAD_READ);
         
         LOG_VERBOSE_TAG("E131", "Packet received: %d channels", dmxLen);
         return dmxLen;
     }
     return 0;
 }
+
+int E131Handler::readControl(char* command, size_t size) {
+    EthBus::Guard bus;
+    int packetSize = _controlUdp.parsePacket();
+    if (packetSize <= 0) return 0;
+
+    // Oversized datagrams are dropped rather than acted on truncated; the
+    // next parsePacket() discards the unread bytes
+    if ((size_t)packetSize >= size) {
+        LOG_WARN_TAG("E131", "Control datagram too long (%d bytes)", packetSize);
+        return 0;
+    }
+
+    int len = _controlUdp.read((uint8_t*)command, packetSize);
+    if (len < 0) len = 0;
+    command[len] = '\0';
+    return len;
+}
+
+void E131Handler::replyControl(const char* text) {
+    EthBus::Guard bus;
+    _controlUdp.beginPacket(_controlUdp.remoteIP(), _controlUdp.remotePort());
+    _controlUdp.write((const uint8_t*)text, strlen(text));
+    _controlUdp.endPacket();
+}
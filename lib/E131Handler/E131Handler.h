@@ -4,15 +4,116 @@
 #include <EthernetUdp.h>
 #include "Config.h"
 
+// Hardware/link state owned by the network task. checkHardware() refreshes it
+// every ETH_STATUS_POLL_MS; everyone else reads the cached values and never
+// touches the SPI bus.
+struct EthStatus {
+    volatile bool hardwareOk = true;
+    volatile bool linkUp = true;
+    volatile unsigned long lastPollTime = 0;   // 0 = never polled
+};
+
+// Outcome of checking a received E1.31 header
+enum E131HeaderStatus {
+    E131_HEADER_OK,
+    E131_HEADER_NOT_DATA,           // Sync, discovery or other ACN traffic
+    E131_HEADER_OTHER_UNIVERSE,
+    E131_HEADER_BAD_START_CODE,     // Alternate start code, e.g. 0xDD priority
+    E131_HEADER_BAD_VALUE_COUNT     // Property value count of 0
+};
+
+// Receive counters for load testing, reset together. Lost frames are gaps in
+// each source's sequence numbers on our universe, so they include datagrams
+// the W5500 dropped before the firmware saw them.
+struct E131RxStats {
+    uint32_t datagrams;             // Everything the socket delivered
+    uint32_t frames;                // Accepted DMX frames (goodput)
+    uint32_t tooShort;
+    uint32_t notData;
+    uint32_t otherUniverse;
+    uint32_t badStartCode;
+    uint32_t badValueCount;
+    uint32_t sequenceLost;
+    uint32_t outOfOrder;            // Late or duplicate frames (still processed)
+    uint32_t sources;               // Sources first seen since the reset
+    unsigned long sinceMs;          // millis() at the reset
+};
+
 class E131Handler {
 public:
     void begin(byte* mac, IPAddress ip);
     void setUniverse(uint16_t universe);
+    // Network task only. Polls the W5500 at most every ETH_STATUS_POLL_MS and
+    // returns the cached state in between.
     bool checkHardware(); 
+    // Safe from any task (no SPI access)
+    bool isLinkUp() const { return _status.hardwareOk && _status.linkUp; }
+    const EthStatus& status() const { return _status; }
     int parsePacket(uint8_t* dmxOutputBuffer); 
+
+    // Check the E131_HEADER_SIZE bytes at `header` against `universe`. On
+    // success `slotCount` is the DMX slot count the header claims, capped at
+    // DMX_MAX_CHANNELS but not yet checked against the datagram length.
+    static E131HeaderStatus parseHeader(const uint8_t* header, uint16_t universe, uint16_t& slotCount);
+
+    // Control socket (CONTROL_UDP_PORT), network task only. Copies one text
+    // datagram into `command` (NUL-terminated); returns its length, 0 if none.
+    int readControl(char* command, size_t size);
+    // Reply to the sender of the last control datagram
+    void replyControl(const char* text);
+
+    // Soft-reset the W5500 and restore MAC/IP and the UDP socket
+    bool recover(const char* reason);
+    uint32_t getRecoveryCount() const { return _recoveryCount; }
+    // Datagrams received on the socket, before any filtering
+    uint32_t getPacketCount() const { return _rxPackets; }
+    void printRecoveryLog();
+
+    const E131RxStats& getRxStats() const { return _rxStats; }
+    // Safe from any task; takes effect at the next parsePacket()
+    void resetRxStats() { _rxStatsResetPending = true; }
+    void printRxStats();
     
 private:
+    struct RecoveryEvent {
+        unsigned long timestamp;   // millis() when recovery started
+        uint32_t durationUs;
+        const char* reason;
+        bool success;
+    };
+
     EthernetUDP _udp;
-    uint8_t _packetBuffer[E131_MAX_PACKET_SIZE];
+    EthernetUDP _controlUdp;
+    alignas(HOT_BUFFER_ALIGN) uint8_t _packetBuffer[E131_MAX_PACKET_SIZE];
     uint16_t _universe = DEFAULT_UNIVERSE;
+    byte _mac[6];
+    IPAddress _ip;
+    EthStatus _status;
+
+    // Stall check: armed by a packet, disarmed once a silence was checked
+    unsigned long _lastRxTime = 0;
+    volatile uint32_t _rxPackets = 0;
+    bool _stallArmed = false;
+    unsigned long _lastRecoveryTime = 0;
+
+    struct SourceSequence {
+        uint8_t cid[16];
+        uint8_t sequence;           // Newest sequence number seen
+        bool used;
+        unsigned long lastSeen;
+    };
+
+    E131RxStats _rxStats = {};
+    volatile bool _rxStatsResetPending = false;
+    SourceSequence _sources[E131_STATS_SOURCES] = {};
+
+    void _trackSequence(const uint8_t* header);
+    // VERSIONR and IP read-back; Ethernet.hardwareStatus() only reflects boot
+    bool _chipResponds();
+    // True if a socket is open in UDP mode on `port`
+    bool _socketOpen(uint16_t port);
+
+    RecoveryEvent _recoveryLog[E131_RECOVERY_LOG_SIZE] = {};
+    uint8_t _recoveryLogIndex = 0;
+    uint32_t _recoveryCount = 0;
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "EthBus.h"
+#include "HotPath.h"
+#include "Logger.h"
+
+SemaphoreHandle_t EthBus::_mutex = nullptr;
+TaskHandle_t EthBus::_owner = nullptr;
+volatile uint32_t EthBus::_contentionCount = 0;
+volatile uint32_t EthBus::_foreignCount = 0;
+
+void EthBus::begin() {
+    if (_mutex == nullptr) {
+        _mutex = xSemaphoreCreateRecursiveMutex();
+    }
+}
+
+void EthBus::setOwner(TaskHandle_t owner) {
+    _owner = owner;
+}
+
+HOT_PATH_ATTR EthBus::Guard::Guard() {
+    lock();
+}
+
+HOT_PATH_ATTR EthBus::Guard::~Guard() {
+    unlock();
+}
+
+void HOT_PATH_ATTR EthBus::lock() {
+    if (_mutex == nullptr) return;
+
+    // Fast path: uncontended take never blocks
+    if (xSemaphoreTakeRecursive(_mutex, 0) != pdTRUE) {
+        _contentionCount++;
+        xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+    }
+
+    if (_owner != nullptr && xTaskGetCurrentTaskHandle() != _owner) {
+        if (_foreignCount++ == 0) {
+            LOG_WARN_TAG("ETHBUS", "W5500 accessed from %s (owner is %s)",
+                         pcTaskGetName(NULL), pcTaskGetName(_owner));
+        }
+    }
+}
+
+void HOT_PATH_ATTR EthBus::unlock() {
+    if (_mutex == nullptr) return;
+    xSemaphoreGiveRecursive(_mutex);
+}
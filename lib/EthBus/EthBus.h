@@ -0,0 +1,44 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+/*
+ * Ownership of the SPI bus shared with the W5500.
+ *
+ * Every sequence of W5500 register or socket accesses must run inside an
+ * EthBus::Guard. The network task is the normal owner and takes the lock
+ * uncontended (a single atomic op). Any other task that needs the chip
+ * blocks only until the current sequence finishes, and the contention is
+ * counted so unexpected cross-task access shows up in diagnostics.
+ *
+ * The lock is recursive so helpers can guard themselves even when called
+ * from an already guarded sequence.
+ */
+class EthBus {
+public:
+    static void begin();
+
+    class Guard {
+    public:
+        Guard();
+        ~Guard();
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    // The task expected to do all W5500 access (the network task)
+    static void setOwner(TaskHandle_t owner);
+
+    static uint32_t getContentionCount() { return _contentionCount; }
+    static uint32_t getForeignAccessCount() { return _foreignCount; }
+
+private:
+    static SemaphoreHandle_t _mutex;
+    static TaskHandle_t _owner;
+    static volatile uint32_t _contentionCount;
+    static volatile uint32_t _foreignCount;
+
+    static void lock();
+    static void unlock();
+};
@@ -0,0 +1,207 @@
+#include "FrameHistory.h"
+#include "Logger.h"
+#include "MemPlacement.h"
+#include "HotPath.h"
+#include <atomic>
+
+HistoryFrame* FrameHistory::_ring = nullptr;
+uint32_t FrameHistory::_capacity = 0;
+volatile uint32_t FrameHistory::_recorded = 0;
+volatile uint32_t FrameHistory::_replayRequestMs = 0;
+volatile bool FrameHistory::_replayStop = false;
+bool FrameHistory::_replaying = false;
+uint32_t FrameHistory::_replayNext = 0;
+uint32_t FrameHistory::_replayEnd = 0;
+uint32_t FrameHistory::_replayStartMs = 0;
+uint32_t FrameHistory::_replayBaseMs = 0;
+
+bool FrameHistory::begin() {
+    if (_ring != nullptr) return true;
+
+    _ring = (HistoryFrame*)MemPlacement::allocate("FrameHistory", FRAME_HISTORY_FRAMES * sizeof(HistoryFrame), MEM_COLD);
+    _capacity = FRAME_HISTORY_FRAMES;
+    if (_ring == nullptr) {
+        _ring = (HistoryFrame*)MemPlacement::allocate("FrameHistory", FRAME_HISTORY_FALLBACK_FRAMES * sizeof(HistoryFrame), MEM_COLD);
+        _capacity = FRAME_HISTORY_FALLBACK_FRAMES;
+    }
+    if (_ring == nullptr) {
+        _capacity = 0;
+        LOG_ERROR_TAG("HISTORY", "No memory for the frame history");
+        return false;
+    }
+
+    LOG_INFO_TAG("HISTORY", "Frame history: %lu frames (%lu s at %d fps)", (unsigned long)_capacity,
+                 (unsigned long)(_capacity / FRAME_HISTORY_MAX_FPS), FRAME_HISTORY_MAX_FPS);
+    return true;
+}
+
+void HOT_PATH_ATTR FrameHistory::record(const uint8_t* data, uint16_t length, uint32_t nowMs) {
+    if (_capacity == 0) return;
+    if (length > sizeof(HistoryFrame::data)) length = sizeof(HistoryFrame::data);
+
+    // Only this task writes, so the slot is ours without a lock. Readers see
+    // seq change and drop a copy that overlapped the rewrite.
+    uint32_t n = _recorded;
+    HistoryFrame& frame = _ring[n % _capacity];
+    frame.seq = 0;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    frame.ms = nowMs;
+    frame.length = length;
+    memcpy(frame.data, data, length);
+    std::atomic_thread_fence(std::memory_order_release);
+    frame.seq = n + 1;
+    _recorded = n + 1;
+}
+
+uint32_t FrameHistory::getCount() {
+    uint32_t recorded = _recorded;
+    return recorded < _capacity ? recorded : _capacity;
+}
+
+uint32_t FrameHistory::_firstHeld() {
+    return _recorded - getCount();
+}
+
+// A slot rewritten during the copy only happens to the oldest frames, and
+// then `back` points at a newer one on the next try
+uint16_t FrameHistory::get(uint32_t back, uint8_t* out, uint32_t* ms) {
+    for (int attempt = 0; attempt < 3; attempt++) {
+        uint32_t recorded = _recorded;
+        uint32_t count = recorded < _capacity ? recorded : _capacity;
+        if (back >= count) return 0;
+
+        uint32_t n = recorded - 1 - back;
+        const HistoryFrame& frame = _ring[n % _capacity];
+        if (frame.seq != n + 1) continue;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        uint16_t length = frame.length;
+        if (length > sizeof(HistoryFrame::data)) length = sizeof(HistoryFrame::data);
+        uint32_t frameMs = frame.ms;
+        memcpy(out, frame.data, length);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (frame.seq != n + 1) continue;
+        if (ms != nullptr) *ms = frameMs;
+        return length;
+    }
+    return 0;
+}
+
+// Timestamp of frame number `n`, false if its slot is being rewritten
+bool FrameHistory::_readMs(uint32_t n, uint32_t* ms) {
+    const HistoryFrame& frame = _ring[n % _capacity];
+    if (frame.seq != n + 1) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    *ms = frame.ms;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return frame.seq == n + 1;
+}
+
+uint32_t FrameHistory::getSpanMs() {
+    uint32_t recorded = _recorded;
+    uint32_t count = recorded < _capacity ? recorded : _capacity;
+    if (count < 2) return 0;
+
+    // The oldest slot is the next one overwritten; one frame in is stable enough
+    uint32_t newestMs;
+    uint32_t oldestMs;
+    if (!_readMs(recorded - 1, &newestMs)) return 0;
+    if (!_readMs(recorded - count, &oldestMs) && !_readMs(recorded - count + 1, &oldestMs)) return 0;
+    return newestMs - oldestMs;
+}
+
+bool FrameHistory::startReplay(uint32_t seconds) {
+    if (seconds == 0 || getCount() == 0) return false;
+    _replayStop = false;
+    _replayRequestMs = seconds * 1000;
+    return true;
+}
+
+void FrameHistory::stopReplay() {
+    _replayStop = true;
+}
+
+// First held frame recorded at or after `ms`; timestamps only grow, so a
+// binary search over the ring in recording order
+uint32_t FrameHistory::_findFrom(uint32_t ms) {
+    uint32_t low = _firstHeld();
+    uint32_t high = _recorded;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if ((int32_t)(_ring[mid % _capacity].ms - ms) < 0) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+uint16_t FrameHistory::replayNext(uint32_t nowMs, uint8_t* out) {
+    if (_replayStop) {
+        _replayStop = false;
+        _replayRequestMs = 0;
+        if (_replaying) {
+            _replaying = false;
+            LOG_INFO_TAG("HISTORY", "Replay stopped");
+        }
+        return 0;
+    }
+
+    // Nothing is recorded during a replay, so the frames it plays stay put
+    if (_replayRequestMs != 0) {
+        uint32_t span = _replayRequestMs;
+        _replayRequestMs = 0;
+        if (getCount() == 0) return 0;
+
+        uint32_t newestMs = _ring[(_recorded - 1) % _capacity].ms;
+        _replayNext = _findFrom(span < newestMs ? newestMs - span : 0);
+        _replayEnd = _recorded;
+        _replayStartMs = nowMs;
+        _replayBaseMs = _ring[_replayNext % _capacity].ms;
+        _replaying = true;
+        LOG_INFO_TAG("HISTORY", "Replaying %lu frames (%lu ms)", (unsigned long)(_replayEnd - _replayNext),
+                     (unsigned long)(newestMs - _replayBaseMs));
+    }
+    if (!_replaying) return 0;
+
+    const HistoryFrame& frame = _ring[_replayNext % _capacity];
+    if (nowMs - _replayStartMs < frame.ms - _replayBaseMs) return 0;
+
+    uint16_t length = frame.length;
+    memcpy(out, frame.data, length);
+    if (++_replayNext == _replayEnd) {
+        _replaying = false;
+        LOG_INFO_TAG("HISTORY", "Replay finished");
+    }
+    return length;
+}
+
+void FrameHistory::printStatus() {
+    uint32_t spanMs = getSpanMs();
+    Serial.println(F("\r\n=== FRAME HISTORY ==="));
+    Serial.printf("Region   : %s\r\n", _ring == nullptr ? "none" : MemPlacement::inPsram(_ring) ? "PSRAM" : "internal RAM");
+    Serial.printf("Capacity : %lu frames (%lu bytes)\r\n", (unsigned long)_capacity,
+                  (unsigned long)(_capacity * sizeof(HistoryFrame)));
+    Serial.printf("Held     : %lu frames, %lu.%03lu s\r\n", (unsigned long)getCount(),
+                  (unsigned long)(spanMs / 1000), (unsigned long)(spanMs % 1000));
+    Serial.printf("Recorded : %lu\r\n", (unsigned long)_recorded);
+    if (_replaying) {
+        Serial.printf("Replay   : %lu frames to go\r\n", (unsigned long)(_replayEnd - _replayNext));
+    } else {
+        Serial.println(F("Replay   : idle"));
+    }
+}
+
+void FrameHistory::printFrame(uint32_t back) {
+    uint8_t data[sizeof(HistoryFrame::data)];
+    uint32_t ms = 0;
+    uint16_t length = get(back, data, &ms);
+    if (length == 0) {
+        Serial.printf("History holds %lu frames\r\n", (unsigned long)getCount());
+        return;
+    }
+
+    Serial.printf("Frame -%lu: %u bytes, %lu ms ago\r\n", (unsigned long)back, length, (unsigned long)(millis() - ms));
+    for (uint16_t i = 0; i < length; i++) {
+        Serial.printf("%02X%s", data[i], (i % 16 == 15 || i == length - 1) ? "\r\n" : " ");
+    }
+}
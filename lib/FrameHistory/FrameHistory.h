@@ -0,0 +1,80 @@
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+#define FRAME_HISTORY_FRAMES ((uint32_t)FRAME_HISTORY_SECONDS * FRAME_HISTORY_MAX_FPS)
+
+// One sent frame; fixed stride so any frame is found by index
+struct HistoryFrame {
+    volatile uint32_t seq;          // Frame number + 1 once written, 0 while being written
+    uint32_t ms;                    // millis() when it went to the radio
+    uint16_t length;
+    uint8_t data[MAX_NUM_LEDS * CHAN_PER_LED];
+};
+
+/*
+ * The last FRAME_HISTORY_SECONDS of frames sent to the radio, in PSRAM
+ * (about 2 MB at the default size; MemPlacement falls back to a
+ * FRAME_HISTORY_FALLBACK_FRAMES ring in internal RAM on a board without it).
+ *
+ * The network task records every frame it sends. Any task can copy a past
+ * frame out with get(), for diagnostics or as the reference frame of a delta
+ * encoding. Neither side holds a lock across the PSRAM copy: the network task
+ * is the only writer, and each slot carries a sequence number that a reader
+ * checks before and after its copy, retrying if the slot was rewritten in
+ * between. Recording touches each PSRAM line once, sequentially, so its cost
+ * is a frame-sized copy plus the write-back of about five cache lines.
+ *
+ * Replay sends the last N seconds again with their original timing. It is
+ * requested from any task and played by the network task, which owns the
+ * radio: while it runs, live frames are received and counted but neither
+ * sent nor recorded.
+ */
+class FrameHistory {
+public:
+    // Allocate the ring. Call from setup(), before HeapGuard::arm().
+    static bool begin();
+
+    // Network task: a frame just sent to the radio
+    static void record(const uint8_t* data, uint16_t length, uint32_t nowMs);
+
+    // Copy the frame `back` frames before the newest (0 = newest) into
+    // `out` (room for MAX_NUM_LEDS * CHAN_PER_LED bytes). Returns its length,
+    // 0 if the history does not reach that far. `ms` receives its timestamp.
+    static uint16_t get(uint32_t back, uint8_t* out, uint32_t* ms = nullptr);
+
+    static uint32_t getCount();             // Frames held
+    static uint32_t getCapacity() { return _capacity; }
+    static uint32_t getRecorded() { return _recorded; }
+    static uint32_t getSpanMs();            // Oldest to newest held frame
+
+    // Replay the last `seconds`; false if there is nothing to replay
+    static bool startReplay(uint32_t seconds);
+    static void stopReplay();
+    static bool isReplaying() { return _replaying || _replayRequestMs != 0; }
+
+    // Network task, every iteration: the next replayed frame if one is due
+    // at `nowMs`. Returns its length, 0 if none is due.
+    static uint16_t replayNext(uint32_t nowMs, uint8_t* out);
+
+    static void printStatus();
+    // Hex dump of the frame `back` frames before the newest
+    static void printFrame(uint32_t back);
+
+private:
+    static HistoryFrame* _ring;
+    static uint32_t _capacity;
+    static volatile uint32_t _recorded;     // Frames ever recorded; frame n sits in slot n % _capacity
+
+    static volatile uint32_t _replayRequestMs;  // Span requested, 0 = none
+    static volatile bool _replayStop;
+    static bool _replaying;
+    static uint32_t _replayNext;            // Frame number to play next
+    static uint32_t _replayEnd;             // First frame number not played
+    static uint32_t _replayStartMs;         // nowMs when the replay began
+    static uint32_t _replayBaseMs;          // Timestamp of the first replayed frame
+
+    static uint32_t _firstHeld();
+    static bool _readMs(uint32_t n, uint32_t* ms);
+    static uint32_t _findFrom(uint32_t ms);
+};
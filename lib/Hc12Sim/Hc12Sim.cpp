@@ -0,0 +1,283 @@
+#include "Hc12Sim.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include "RadioFrame.h"
+
+#define UART_BITS_PER_BYTE 10       // 8N1
+#define AIR_BITS_PER_BYTE 8
+#define AIR_PREAMBLE_BITS 60
+#define AIR_WAKE_US 2000
+#define FRAME_ID_BYTES 4            // Scenario frames carry their index here
+#define NEVER UINT64_MAX
+
+Hc12LinkConfig Hc12LinkConfig::forMode(Hc12Mode mode, uint32_t uartBaud) {
+    Hc12LinkConfig config;
+    config.uartBaud = uartBaud;
+
+    switch (mode) {
+        case HC12_FU1:
+            config.airBaud = 250000;
+            config.airOverheadUs = 20000;
+            break;
+        case HC12_FU2:
+            // Limited to 4800 baud on the UART
+            config.uartBaud = std::min<uint32_t>(uartBaud, 4800);
+            config.airBaud = 250000;
+            config.airOverheadUs = 20000;
+            break;
+        case HC12_FU4:
+            config.uartBaud = 1200;
+            config.airBaud = 500;
+            config.airOverheadUs = AIR_WAKE_US + AIR_PREAMBLE_BITS * 1000000ULL / config.airBaud;
+            break;
+        case HC12_FU3:
+        default:
+            // Air rate follows the UART rate
+            if (uartBaud <= 2400) config.airBaud = 5000;
+            else if (uartBaud <= 9600) config.airBaud = 15000;
+            else if (uartBaud <= 38400) config.airBaud = 58000;
+            else config.airBaud = 236000;
+            config.airOverheadUs = AIR_WAKE_US + AIR_PREAMBLE_BITS * 1000000ULL / config.airBaud;
+            break;
+    }
+    return config;
+}
+
+// --- Link ---
+
+Hc12Link::Hc12Link(const Hc12LinkConfig& config)
+    : _config(config),
+      _byteUs((uint32_t)((UART_BITS_PER_BYTE * 1000000ULL + config.uartBaud - 1) / config.uartBaud)),
+      _rng(config.seed ? config.seed : 1) {
+}
+
+float Hc12Link::_random() {
+    // xorshift32: identical sequences on every host
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 17;
+    _rng ^= _rng << 5;
+    return (_rng >> 8) * (1.0f / 16777216.0f);
+}
+
+void Hc12Link::write(uint64_t nowUs, const uint8_t* data, size_t len) {
+    uint64_t t = std::max(nowUs, _txUartFreeUs);
+    for (size_t i = 0; i < len; i++) {
+        t += _byteUs;
+        _inbound.push_back({t, data[i]});
+    }
+    _txUartFreeUs = t;
+    _stats.bytesWritten += len;
+}
+
+void Hc12Link::_startAirPacket() {
+    size_t count = std::min<size_t>(_buffer.size(), _config.airPacketBytes);
+    _airPacket.assign(_buffer.begin(), _buffer.begin() + count);
+    _buffer.erase(_buffer.begin(), _buffer.begin() + count);
+    _airBusy = true;
+    _airEndUs = _simUs + _config.airOverheadUs +
+        (uint64_t)count * AIR_BITS_PER_BYTE * 1000000ULL / _config.airBaud;
+}
+
+void Hc12Link::_finishAirPacket() {
+    _airBusy = false;
+    _stats.airPackets++;
+
+    // Channel state for this packet
+    if (_burst) {
+        if (_random() < _config.burstExitRate) _burst = false;
+    } else if (_random() < _config.burstEnterRate) {
+        _burst = true;
+    }
+    if (_burst) _stats.burstPackets++;
+
+    float dropRate = _burst ? _config.burstDropRate : _config.packetDropRate;
+    if (_random() < dropRate) {
+        _stats.airPacketsDropped++;
+        return;
+    }
+
+    float ber = _burst ? _config.burstBitErrorRate : _config.bitErrorRate;
+    for (uint8_t& value : _airPacket) {
+        if (ber > 0) {
+            for (uint8_t bit = 0; bit < AIR_BITS_PER_BYTE; bit++) {
+                if (_random() < ber) {
+                    value ^= (uint8_t)(1 << bit);
+                    _stats.bitErrors++;
+                }
+            }
+        }
+        // The remote module shifts each byte out as soon as its UART is free
+        _rxUartFreeUs = std::max(_rxUartFreeUs, _airEndUs) + _byteUs;
+        _outbound.push_back({_rxUartFreeUs, value});
+    }
+}
+
+void Hc12Link::_advance(uint64_t untilUs) {
+    for (;;) {
+        uint64_t nextArrival = _inbound.empty() ? NEVER : _inbound.front().timeUs;
+        uint64_t nextAirEnd = _airBusy ? _airEndUs : NEVER;
+        uint64_t nextAirStart = NEVER;
+        if (!_airBusy && !_buffer.empty()) {
+            nextAirStart = _buffer.size() >= _config.airPacketBytes
+                ? _simUs
+                : std::max(_simUs, _lastArrivalUs + (uint64_t)_config.idleGapBytes * _byteUs);
+        }
+
+        uint64_t next = std::min(nextArrival, std::min(nextAirEnd, nextAirStart));
+        if (next == NEVER || next > untilUs) break;
+        _simUs = next;
+
+        // Same-time order: finish the packet on air, start the next, then
+        // take in the byte that just arrived
+        if (next == nextAirEnd) {
+            _finishAirPacket();
+        } else if (next == nextAirStart) {
+            _startAirPacket();
+        } else {
+            TimedByte b = _inbound.front();
+            _inbound.pop_front();
+            _lastArrivalUs = b.timeUs;
+            if (_buffer.size() >= _config.bufferBytes) {
+                _stats.bytesOverflowed++;
+            } else {
+                _buffer.push_back(b.value);
+            }
+        }
+    }
+    if (untilUs > _simUs) _simUs = untilUs;
+}
+
+size_t Hc12Link::read(uint64_t nowUs, uint8_t* out, size_t max, uint64_t* times) {
+    _advance(nowUs);
+    size_t n = 0;
+    while (n < max && !_outbound.empty() && _outbound.front().timeUs <= nowUs) {
+        if (times) times[n] = _outbound.front().timeUs;
+        out[n++] = _outbound.front().value;
+        _outbound.pop_front();
+    }
+    _stats.bytesDelivered += n;
+    return n;
+}
+
+// --- Scenario runner ---
+
+static uint32_t percentile(std::vector<uint32_t>& sorted, uint8_t pct) {
+    if (sorted.empty()) return 0;
+    size_t index = (sorted.size() - 1) * pct / 100;
+    return sorted[index];
+}
+
+// Frame `id`: its index, then a pattern derived from it
+static void fillPayload(uint8_t* payload, uint16_t length, uint32_t id) {
+    payload[0] = id >> 24;
+    payload[1] = id >> 16;
+    payload[2] = id >> 8;
+    payload[3] = id;
+    for (uint16_t i = FRAME_ID_BYTES; i < length; i++) payload[i] = (uint8_t)(i * 31 + id);
+}
+
+static bool intact(const uint8_t* payload, uint16_t length, uint32_t id) {
+    uint8_t expected[RADIO_FRAME_MAX_PAYLOAD];
+    fillPayload(expected, length, id);
+    return memcmp(payload, expected, length) == 0;
+}
+
+Hc12Report Hc12Sim::run(const Hc12LinkConfig& config, const Hc12Scenario& scenario) {
+    Hc12Report report = {};
+    Hc12Link link(config);
+    RadioFrameDecoder<> decoder;
+
+    uint16_t payloadBytes = std::min<uint16_t>(std::max<uint16_t>(scenario.payloadBytes, FRAME_ID_BYTES),
+                                               RADIO_FRAME_MAX_PAYLOAD);
+    uint64_t durationUs = (uint64_t)scenario.durationMs * 1000;
+    uint64_t periodUs = scenario.frameRate > 0 ? (uint64_t)(1000000.0f / scenario.frameRate) : durationUs;
+    if (periodUs == 0) periodUs = 1;
+
+    std::vector<uint64_t> sentAt;              // Time each frame was due, by index
+    std::vector<uint32_t> latencies;
+    uint8_t payload[RADIO_FRAME_MAX_PAYLOAD];
+    uint8_t frame[RADIO_FRAME_MAX_PAYLOAD + RADIO_FRAME_OVERHEAD];
+    uint8_t rx[256];
+    uint64_t rxTimes[256];
+
+    // Deliver whatever has arrived by `t` to the decoder
+    auto drain = [&](uint64_t t) {
+        size_t n;
+        while ((n = link.read(t, rx, sizeof(rx), rxTimes)) > 0) {
+            for (size_t i = 0; i < n; i++) {
+                RadioFrameResult result = decoder.feed(rx[i]);
+                if (result == RADIO_FRAME_BAD_CHECKSUM) {
+                    report.framesCorrupt++;
+                } else if (result == RADIO_FRAME_OK && decoder.length() >= FRAME_ID_BYTES) {
+                    const uint8_t* p = decoder.payload();
+                    uint32_t id = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+                    if (id < sentAt.size() && decoder.length() == payloadBytes &&
+                        intact(p, payloadBytes, id)) {
+                        report.framesDelivered++;
+                        latencies.push_back((uint32_t)(rxTimes[i] - sentAt[id]));
+                    } else {
+                        report.framesUndetected++;
+                    }
+                } else if (result == RADIO_FRAME_OK) {
+                    report.framesUndetected++;
+                }
+            }
+        }
+    };
+
+    for (uint64_t t = 0; t < durationUs; t += periodUs) {
+        drain(t);
+        report.framesOffered++;
+        if (scenario.skipWhenBusy && link.txIdleAt() > t) {
+            report.framesSkipped++;
+            continue;
+        }
+
+        uint32_t id = (uint32_t)sentAt.size();
+        fillPayload(payload, payloadBytes, id);
+        size_t frameSize = RadioFrame::encode(payload, payloadBytes, frame, sizeof(frame));
+
+        // Latency counts from when the frame was due, so queueing shows up
+        sentAt.push_back(t);
+        link.write(t, frame, frameSize);
+        report.framesSent++;
+    }
+    // Let everything in flight land; queued frames may still be draining
+    drain(std::max(durationUs, link.txIdleAt()) + 10000000ULL);
+
+    float seconds = durationUs / 1e6f;
+    report.offeredFps = report.framesOffered / seconds;
+    report.achievedFps = report.framesDelivered / seconds;
+    report.deliveryRate = report.framesSent ? (float)report.framesDelivered / report.framesSent : 0;
+    std::sort(latencies.begin(), latencies.end());
+    report.latencyP50Us = percentile(latencies, 50);
+    report.latencyP99Us = percentile(latencies, 99);
+    report.latencyMaxUs = latencies.empty() ? 0 : latencies.back();
+    report.link = link.stats();
+    return report;
+}
+
+void Hc12Sim::printReport(const Hc12LinkConfig& config, const Hc12Scenario& scenario, const Hc12Report& report) {
+    printf("=== HC-12 link ===\n");
+    printf("UART %lu baud, air %lu bps, %u-byte air packets, %u-byte buffer\n",
+           (unsigned long)config.uartBaud, (unsigned long)config.airBaud,
+           config.airPacketBytes, config.bufferBytes);
+    printf("Frames: %u-byte payload at %.1f fps for %.1f s (%s)\n",
+           scenario.payloadBytes, scenario.frameRate, scenario.durationMs / 1000.0f,
+           scenario.skipWhenBusy ? "skip when busy" : "queue");
+    printf("Offered:    %lu (%.1f fps)\n", (unsigned long)report.framesOffered, report.offeredFps);
+    printf("Skipped:    %lu (sender busy)\n", (unsigned long)report.framesSkipped);
+    printf("Sent:       %lu\n", (unsigned long)report.framesSent);
+    printf("Delivered:  %lu (%.1f fps, %.1f%% of sent)\n", (unsigned long)report.framesDelivered,
+           report.achievedFps, report.deliveryRate * 100.0f);
+    printf("Corrupt:    %lu caught by checksum, %lu passed it\n",
+           (unsigned long)report.framesCorrupt, (unsigned long)report.framesUndetected);
+    printf("Latency:    p50 %.1f ms, p99 %.1f ms, max %.1f ms\n", report.latencyP50Us / 1000.0f,
+           report.latencyP99Us / 1000.0f, report.latencyMaxUs / 1000.0f);
+    printf("Air:        %lu packets, %lu dropped, %lu in bursts, %lu bit errors\n",
+           (unsigned long)report.link.airPackets, (unsigned long)report.link.airPacketsDropped,
+           (unsigned long)report.link.burstPackets, (unsigned long)report.link.bitErrors);
+    printf("Overflow:   %llu bytes\n", (unsigned long long)report.link.bytesOverflowed);
+    printf("==================\n");
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+#include <vector>
+#include "Config.h"
+
+// HC-12 transmission modes (AT+FUx)
+enum Hc12Mode : uint8_t {
+    HC12_FU1 = 1,
+    HC12_FU2 = 2,
+    HC12_FU3 = 3,   // Factory default
+    HC12_FU4 = 4
+};
+
+struct Hc12LinkConfig {
+    uint32_t uartBaud = HC12_BAUD;      // MCU <-> module, 8N1, same on both ends
+    uint32_t airBaud = 15000;           // Over-the-air bit rate
+    uint16_t airPacketBytes = 60;       // Largest air packet
+    uint16_t bufferBytes = 128;         // Module RX buffer; overflow loses bytes
+    uint32_t airOverheadUs = 4000;      // Per air packet: wake-up, preamble, sync
+    uint8_t idleGapBytes = 2;           // UART silence (byte times) that flushes a short packet
+
+    // Errors, applied per air packet. The channel alternates between a good
+    // and a burst state (Gilbert-Elliott); each state has its own rates.
+    float bitErrorRate = 0;             // Per bit
+    float packetDropRate = 0;           // Whole air packet lost
+    float burstEnterRate = 0;           // Per packet, good -> burst
+    float burstExitRate = 1;            // Per packet, burst -> good
+    float burstBitErrorRate = 0;
+    float burstDropRate = 0;
+    uint32_t seed = 1;
+
+    // Datasheet timing for a mode/baud pair. Overheads are approximate;
+    // calibrate against a pair of real modules before trusting absolute
+    // latencies.
+    static Hc12LinkConfig forMode(Hc12Mode mode, uint32_t uartBaud);
+};
+
+struct Hc12LinkStats {
+    uint64_t bytesWritten;              // Accepted by the sending UART
+    uint64_t bytesOverflowed;           // Lost to a full module buffer
+    uint64_t bytesDelivered;            // Out of the receiving UART
+    uint32_t airPackets;
+    uint32_t airPacketsDropped;
+    uint32_t bitErrors;
+    uint32_t burstPackets;              // Air packets sent in the burst state
+};
+
+/*
+ * Discrete-event model of an HC-12 pair: MCU UART -> module buffer -> air
+ * packets -> remote module -> remote UART. Time is simulated and supplied by
+ * the caller in microseconds, so runs are deterministic and take no wall
+ * time. Host only.
+ *
+ * A module starts an air packet when it holds airPacketBytes, or when the
+ * UART has been idle for idleGapBytes byte times, whichever comes first.
+ */
+class Hc12Link {
+public:
+    explicit Hc12Link(const Hc12LinkConfig& config = Hc12LinkConfig());
+
+    // Queue bytes on the sending UART at `nowUs`. They go out back to back
+    // after anything still being shifted out.
+    void write(uint64_t nowUs, const uint8_t* data, size_t len);
+    // Time the sending UART finishes the last queued byte
+    uint64_t txIdleAt() const { return _txUartFreeUs; }
+
+    // Run the model up to `nowUs`, then copy out bytes the receiving UART has
+    // delivered by then. `times` (optional) gets each byte's delivery time.
+    size_t read(uint64_t nowUs, uint8_t* out, size_t max, uint64_t* times = nullptr);
+
+    const Hc12LinkConfig& config() const { return _config; }
+    const Hc12LinkStats& stats() const { return _stats; }
+    // UART byte time in microseconds (start + 8 data + stop bits)
+    uint32_t byteTimeUs() const { return _byteUs; }
+
+private:
+    struct TimedByte {
+        uint64_t timeUs;
+        uint8_t value;
+    };
+
+    Hc12LinkConfig _config;
+    Hc12LinkStats _stats = {};
+    uint32_t _byteUs;
+    uint32_t _rng;
+    bool _burst = false;
+
+    // Sending side
+    uint64_t _txUartFreeUs = 0;
+    std::deque<TimedByte> _inbound;     // On the wire to the module
+    std::deque<uint8_t> _buffer;        // In the module
+    uint64_t _lastArrivalUs = 0;
+    uint64_t _simUs = 0;
+
+    // Air and receiving side
+    bool _airBusy = false;
+    uint64_t _airEndUs = 0;
+    std::vector<uint8_t> _airPacket;
+    uint64_t _rxUartFreeUs = 0;
+    std::deque<TimedByte> _outbound;    // Leaving the remote UART
+
+    void _advance(uint64_t untilUs);
+    void _startAirPacket();
+    void _finishAirPacket();
+    float _random();
+};
+
+// Frame stream for a scenario: what the transmitter sends and how often
+struct Hc12Scenario {
+    uint16_t payloadBytes = MAX_NUM_LEDS * CHAN_PER_LED;
+    float frameRate = 30;               // Frames offered per second
+    uint32_t durationMs = 10000;
+    // true: a frame due while the UART is still busy is skipped (a latest-
+    // wins sender). false: it is queued behind the previous one.
+    bool skipWhenBusy = true;
+};
+
+struct Hc12Report {
+    uint32_t framesOffered;
+    uint32_t framesSkipped;             // Sender busy (skipWhenBusy)
+    uint32_t framesSent;
+    uint32_t framesDelivered;           // Decoded intact at the receiver
+    uint32_t framesCorrupt;             // Failed the checksum
+    uint32_t framesUndetected;          // Passed the checksum with wrong contents
+    float offeredFps;
+    float achievedFps;                  // Delivered frames per second
+    float deliveryRate;                 // Delivered / sent
+    uint32_t latencyP50Us;              // Frame due -> last byte out of the receiver
+    uint32_t latencyP99Us;
+    uint32_t latencyMaxUs;
+    Hc12LinkStats link;
+};
+
+namespace Hc12Sim {
+    // Drive `scenario` through a link built from `config` into a
+    // RadioFrameDecoder and measure what arrives
+    Hc12Report run(const Hc12LinkConfig& config, const Hc12Scenario& scenario);
+    void printReport(const Hc12LinkConfig& config, const Hc12Scenario& scenario, const Hc12Report& report);
+}
@@ -0,0 +1,106 @@
+#include "HeapGuard.h"
+#include <esp_heap_caps.h>
+
+HeapGuard::WatchedTask HeapGuard::_tasks[HEAP_GUARD_MAX_TASKS] = {};
+volatile uint8_t HeapGuard::_taskCount = 0;
+volatile bool HeapGuard::_armed = false;
+volatile bool HeapGuard::_assert = HEAP_GUARD_ASSERT;
+volatile uint32_t HeapGuard::_violations = 0;
+volatile uint32_t HeapGuard::_allocations = 0;
+volatile uint32_t HeapGuard::_frees = 0;
+size_t HeapGuard::_freeAtArm = 0;
+portMUX_TYPE HeapGuard::_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Set while the hook runs, so an allocation made by the hook itself (the
+// host's task lookup can allocate) does not recurse
+static thread_local bool inHook = false;
+
+void HeapGuard::arm() {
+    _freeAtArm = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    _armed = true;
+}
+
+void HeapGuard::watchCurrentTask() {
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    portENTER_CRITICAL(&_mux);
+    if (_taskCount < HEAP_GUARD_MAX_TASKS) {
+        _tasks[_taskCount] = {current, 0, 0, 0, nullptr};
+        _taskCount++;
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+void HeapGuard::onAllocate(size_t size, void* caller) {
+    if (!_armed || inHook) return;
+    inHook = true;
+
+    portENTER_CRITICAL(&_mux);
+    _allocations++;
+    portEXIT_CRITICAL(&_mux);
+
+    // Each entry is only written by its own task
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        WatchedTask& task = _tasks[i];
+        if (task.handle != current) continue;
+
+        task.allocations++;
+        task.bytes += size;
+        task.lastSize = size;
+        task.lastCaller = caller;
+        portENTER_CRITICAL(&_mux);
+        _violations++;
+        portEXIT_CRITICAL(&_mux);
+        if (_assert) abort();
+        break;
+    }
+
+    inHook = false;
+}
+
+void HeapGuard::onFree() {
+    if (!_armed) return;
+    portENTER_CRITICAL(&_mux);
+    _frees++;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void HeapGuard::reset() {
+    portENTER_CRITICAL(&_mux);
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        _tasks[i].allocations = 0;
+        _tasks[i].bytes = 0;
+        _tasks[i].lastSize = 0;
+        _tasks[i].lastCaller = nullptr;
+    }
+    _violations = 0;
+    _allocations = 0;
+    _frees = 0;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void HeapGuard::printReport() {
+    Serial.println(F("\r\n=== HEAP ==="));
+    Serial.printf("Free now     : %u bytes\r\n", (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+    Serial.printf("Free at arm  : %u bytes\r\n", (unsigned)_freeAtArm);
+    Serial.printf("Minimum free : %u bytes\r\n", (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL));
+    Serial.printf("Largest block: %u bytes\r\n", (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL));
+
+#ifdef HEAP_GUARD
+    if (!_armed) {
+        Serial.println(F("Not armed yet (setup() still running)"));
+        return;
+    }
+    Serial.printf("Since arm    : %lu allocations, %lu frees\r\n", (unsigned long)_allocations, (unsigned long)_frees);
+    Serial.printf("%-16s %8s %8s %9s %12s\r\n", "Task", "Allocs", "Bytes", "Last size", "Last caller");
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        const WatchedTask& task = _tasks[i];
+        Serial.printf("%-16s %8lu %8lu %9u   %10p\r\n", pcTaskGetName(task.handle),
+                      (unsigned long)task.allocations, (unsigned long)task.bytes,
+                      (unsigned)task.lastSize, task.lastCaller);
+    }
+    Serial.printf("Violations   : %lu (assert %s)\r\n", (unsigned long)_violations, _assert ? "on" : "off");
+#else
+    Serial.println(F("Allocation hooks not built in, use a heapguard environment"));
+#endif
+}
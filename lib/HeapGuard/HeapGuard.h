@@ -0,0 +1,67 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "Config.h"
+
+/*
+ * Zero-heap-after-boot check.
+ *
+ * Everything the firmware needs is allocated while it boots; after that the
+ * network (and radio) and display paths must run on static, stack or pool
+ * memory, so a show running for days cannot fragment the heap. Each of those
+ * tasks calls watchCurrentTask() as it enters its main loop, and setup()
+ * calls arm() when it is done. From then on every malloc, calloc, realloc
+ * and free is counted, and an allocation from a watched task is recorded
+ * with its size and caller, or aborts when asserting is enabled so the
+ * panic backtrace points at it.
+ *
+ * The hooks need the allocator wrapped at link time, which only the
+ * heapguard environments do (-D HEAP_GUARD and -Wl,--wrap=malloc etc., see
+ * platformio.ini). In other builds nothing is counted and the report shows
+ * the heap watermarks only. FreeRTOS objects are allocated through
+ * heap_caps_malloc, below the wrapped functions; they are all created at boot.
+ */
+class HeapGuard {
+public:
+    // Start counting. Call at the end of setup().
+    static void arm();
+    static bool isArmed() { return _armed; }
+
+    // Treat allocations from the calling task as violations from now on
+    static void watchCurrentTask();
+
+    // Abort on a watched allocation instead of only recording it
+    static void setAssert(bool enable) { _assert = enable; }
+    static bool getAssert() { return _assert; }
+
+    // Allocations from watched tasks since they started watching
+    static uint32_t getViolationCount() { return _violations; }
+
+    // Called by the allocator wrappers (HeapGuardWrap.cpp)
+    static void onAllocate(size_t size, void* caller);
+    static void onFree();
+
+    // Forget the counts; watched tasks stay watched
+    static void reset();
+    static void printReport();
+
+private:
+    struct WatchedTask {
+        TaskHandle_t handle;
+        uint32_t allocations;
+        uint32_t bytes;
+        size_t lastSize;
+        void* lastCaller;
+    };
+
+    static WatchedTask _tasks[HEAP_GUARD_MAX_TASKS];
+    static volatile uint8_t _taskCount;
+    static volatile bool _armed;
+    static volatile bool _assert;
+    static volatile uint32_t _violations;
+    static volatile uint32_t _allocations;
+    static volatile uint32_t _frees;
+    static size_t _freeAtArm;
+    static portMUX_TYPE _mux;
+};
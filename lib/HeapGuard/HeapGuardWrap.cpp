@@ -0,0 +1,76 @@
+#ifdef HEAP_GUARD
+/*
+ * Allocator hooks for HeapGuard, active when linked with
+ *   -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+ * The linker sends every call to malloc() to __wrap_malloc() and the real
+ * one becomes __real_malloc(). On the target operator new calls malloc()
+ * from the statically linked libstdc++, so it is covered too. On the host
+ * libstdc++ is a shared library the linker cannot rewrite; the host
+ * environment also wraps operator new (HEAP_GUARD_WRAP_NEW).
+ */
+#include <stdlib.h>
+#include "HeapGuard.h"
+
+#define CALLER() __builtin_extract_return_addr(__builtin_return_address(0))
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+    HeapGuard::onAllocate(size, CALLER());
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    HeapGuard::onAllocate(count * size, CALLER());
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    HeapGuard::onAllocate(size, CALLER());
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+    if (ptr != nullptr) HeapGuard::onFree();
+    __real_free(ptr);
+}
+
+#ifdef HEAP_GUARD_WRAP_NEW
+// operator new/new[] and the matching deletes, plain and sized
+void* __real__Znwm(size_t size);
+void* __real__Znam(size_t size);
+void __real__ZdlPv(void* ptr);
+void __real__ZdlPvm(void* ptr, size_t size);
+void __real__ZdaPv(void* ptr);
+
+void* __wrap__Znwm(size_t size) {
+    HeapGuard::onAllocate(size, CALLER());
+    return __real__Znwm(size);
+}
+
+void* __wrap__Znam(size_t size) {
+    HeapGuard::onAllocate(size, CALLER());
+    return __real__Znam(size);
+}
+
+void __wrap__ZdlPv(void* ptr) {
+    if (ptr != nullptr) HeapGuard::onFree();
+    __real__ZdlPv(ptr);
+}
+
+void __wrap__ZdlPvm(void* ptr, size_t size) {
+    if (ptr != nullptr) HeapGuard::onFree();
+    __real__ZdlPvm(ptr, size);
+}
+
+void __wrap__ZdaPv(void* ptr) {
+    if (ptr != nullptr) HeapGuard::onFree();
+    __real__ZdaPv(ptr);
+}
+#endif
+}
+#endif
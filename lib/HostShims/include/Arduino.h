@@ -0,0 +1,171 @@
+#pragma once
+/*
+ * Host stand-in for the Arduino-ESP32 core: just the parts the firmware
+ * uses, backed by the C++ standard library. See HostShims.h for the hooks
+ * tests use to drive inputs and inspect outputs.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// Memory placement attributes are meaningless on the host
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define DMA_ATTR
+#define EXT_RAM_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#define PROGMEM
+#define F(s) (s)
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define SERIAL_8N1 0x800001c
+#define DEC 10
+#define HEX 16
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#ifndef __GLIBC_PREREQ
+#define __GLIBC_PREREQ(a, b) 0
+#endif
+#if !defined(__APPLE__) && !__GLIBC_PREREQ(2, 38)
+extern "C" size_t strlcpy(char* dst, const char* src, size_t size);
+#endif
+
+// Sketch entry points (src/main.cpp)
+void setup();
+void loop();
+
+// Time
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+// Nominal target clock, so cycle figures from host runs are scaled time
+inline uint32_t getCpuFrequencyMhz() { return 240; }
+
+// GPIO (levels are driven from tests via HostGpio)
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int digitalRead(uint8_t pin);
+void neopixelWrite(uint8_t pin, uint8_t red, uint8_t green, uint8_t blue);
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(int n, int base = DEC) { return print((long)n, base); }
+    size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+    size_t print(const Printable& p) { return p.printTo(*this); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual void flush() {}
+};
+
+class String {
+public:
+    String(const char* str = "") : _str(str ? str : "") {}
+    String& operator+=(char c) { _str += c; return *this; }
+    String& operator+=(const char* str) { _str += str; return *this; }
+    const char* c_str() const { return _str.c_str(); }
+    unsigned int length() const { return (unsigned int)_str.size(); }
+private:
+    std::string _str;
+};
+
+class IPAddress : public Printable {
+public:
+    IPAddress() { _address.dword = 0; }
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+        _address.bytes[0] = a; _address.bytes[1] = b; _address.bytes[2] = c; _address.bytes[3] = d;
+    }
+    IPAddress(uint32_t address) { _address.dword = address; }
+    operator uint32_t() const { return _address.dword; }
+    bool operator==(const IPAddress& other) const { return _address.dword == other._address.dword; }
+    bool operator!=(const IPAddress& other) const { return !(*this == other); }
+    uint8_t operator[](int index) const { return _address.bytes[index]; }
+    uint8_t& operator[](int index) { return _address.bytes[index]; }
+    size_t printTo(Print& p) const override;
+private:
+    union {
+        uint8_t bytes[4];
+        uint32_t dword;
+    } _address;
+};
+
+class HardwareSerial : public Stream {
+public:
+    explicit HardwareSerial(int port) : _port(port) {}
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1);
+    void end() {}
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override {}
+    int availableForWrite() { return 128; }
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    operator bool() const { return true; }
+private:
+    int _port;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
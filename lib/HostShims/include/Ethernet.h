@@ -0,0 +1,29 @@
+#pragma once
+#include <Arduino.h>
+#include "EthernetUdp.h"
+
+enum EthernetHardwareStatus {
+    EthernetNoHardware,
+    EthernetW5100,
+    EthernetW5200,
+    EthernetW5500
+};
+
+enum EthernetLinkStatus {
+    Unknown,
+    LinkON,
+    LinkOFF
+};
+
+// Backed by the fake W5500 in HostShims; hardware presence and link state
+// are set through HostNet
+class EthernetClass {
+public:
+    void init(uint8_t csPin) { (void)csPin; }
+    void begin(uint8_t* mac, IPAddress ip);
+    EthernetHardwareStatus hardwareStatus();
+    EthernetLinkStatus linkStatus();
+    IPAddress localIP();
+};
+
+extern EthernetClass Ethernet;
@@ -0,0 +1,39 @@
+#pragma once
+#include <Arduino.h>
+
+// One socket of the fake W5500. Datagrams are queued with HostNet::inject()
+// and sent ones are collected by HostNet::takeSent().
+class EthernetUDP : public Stream {
+public:
+    uint8_t begin(uint16_t port);
+    void stop();
+
+    int parsePacket();
+    int available() override;
+    int read() override;
+    int read(uint8_t* buffer, size_t len);
+    int read(char* buffer, size_t len) { return read((uint8_t*)buffer, len); }
+    int peek() override;
+    void flush() override;
+    IPAddress remoteIP() { return _remoteIP; }
+    uint16_t remotePort() { return _remotePort; }
+
+    int beginPacket(IPAddress ip, uint16_t port);
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int endPacket();
+
+private:
+    uint16_t _port = 0;
+    uint8_t _rx[2048];
+    size_t _rxLength = 0;
+    size_t _rxOffset = 0;
+    IPAddress _remoteIP;
+    uint16_t _remotePort = 0;
+
+    uint8_t _tx[2048];
+    size_t _txLength = 0;
+    IPAddress _txIP;
+    uint16_t _txPort = 0;
+};
@@ -0,0 +1,71 @@
+#pragma once
+/*
+ * Test and tooling hooks for the host build: feed inputs to the firmware and
+ * inspect what it produced. Nothing here exists on the target.
+ */
+#include <Arduino.h>
+#include <vector>
+
+namespace HostNet {
+    struct Datagram {
+        uint16_t localPort;      // Socket the datagram was sent from / queued for
+        IPAddress remoteIP;
+        uint16_t remotePort;
+        std::vector<uint8_t> data;
+    };
+
+    // Queue a datagram for the socket bound to `port`. Dropped (false) if none
+    // is, or if it does not fit in the socket's 2 KB RX buffer, as on the chip.
+    bool inject(uint16_t port, const uint8_t* data, size_t len,
+                IPAddress from = IPAddress(192, 168, 0, 10), uint16_t fromPort = 5568);
+    size_t pending(uint16_t port);
+    // Oldest datagram the firmware sent, false if none
+    bool takeSent(Datagram& out);
+
+    // A missing or dead chip; registers read 0 and it comes back reset.
+    // Ethernet.hardwareStatus() keeps reporting what the first
+    // Ethernet.begin() found, like the library.
+    void setHardwarePresent(bool present);
+    void setLink(bool up);
+    // A socket the chip closed on its own, under a still-bound EthernetUDP
+    void closeSocket(uint16_t port);
+
+    // W5500 register/socket accesses, and accesses that overlapped another
+    // thread's (the fake aborts on those unless disabled)
+    uint32_t accessCount();
+    uint32_t concurrentAccessCount();
+    void setAbortOnConcurrentAccess(bool enable);
+
+    // Close sockets, drop queued datagrams and restore hardware/link state;
+    // the next Ethernet.begin() detects the chip again
+    void reset();
+}
+
+namespace HostSerial {
+    // Bytes written to UART `port` since the last call (0 = Serial, 2 = Serial2)
+    std::vector<uint8_t> takeOutput(int port);
+    // Bytes the firmware will read from UART `port`
+    void feedInput(int port, const uint8_t* data, size_t len);
+    // Copy UART output to stdout as well (on by default for Serial only)
+    void setEcho(int port, bool enable);
+    // Keep written bytes for takeOutput() (on by default for all but Serial)
+    void setCapture(int port, bool enable);
+}
+
+namespace HostGpio {
+    // Drive an input pin; fires an attached interrupt on a matching edge
+    void setLevel(uint8_t pin, int level);
+    int getLevel(uint8_t pin);
+    void getNeopixel(uint8_t rgb[3]);
+}
+
+namespace HostClock {
+    // Move millis(), micros() and esp_timer forward without sleeping, for
+    // timeouts measured in seconds. Tasks keep running in real time.
+    void advance(uint32_t ms);
+}
+
+namespace HostNvs {
+    void clear();
+    uint32_t commitCount();
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <Arduino.h>
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+class SPISettings {
+public:
+    SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0) {
+        (void)clock; (void)bitOrder; (void)dataMode;
+    }
+};
+
+// Bus transactions carry no data on the host; the fake W5500 is accessed
+// through the Ethernet classes directly
+class SPIClass {
+public:
+    void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {
+        (void)sck; (void)miso; (void)mosi; (void)ss;
+    }
+    void beginTransaction(const SPISettings& settings) { (void)settings; }
+    void endTransaction() {}
+};
+
+extern SPIClass SPI;
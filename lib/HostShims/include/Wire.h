@@ -0,0 +1,14 @@
+#pragma once
+#include <Arduino.h>
+
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { (void)sda; (void)scl; (void)frequency; return true; }
+    bool setClock(uint32_t frequency) { (void)frequency; return true; }
+    void beginTransmission(uint8_t address) { (void)address; }
+    size_t write(uint8_t data) { (void)data; return 1; }
+    size_t write(const uint8_t* data, size_t len) { (void)data; return len; }
+    uint8_t endTransmission(bool sendStop = true) { (void)sendStop; return 0; }
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef int i2c_port_t;
+typedef void* i2c_cmd_handle_t;
+
+#define I2C_NUM_0 0
+#define I2C_NUM_1 1
+#define I2C_MASTER_WRITE 0
+#define I2C_MASTER_READ 1
+#define I2C_LINK_RECOMMENDED_SIZE(transactions) (20 * (transactions) + 40)
+
+// Commands are accepted and discarded; there is no panel on the host
+i2c_cmd_handle_t i2c_cmd_link_create_static(uint8_t* buffer, uint32_t size);
+void i2c_cmd_link_delete_static(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ackEnable);
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd, const uint8_t* data, size_t len, bool ackEnable);
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks);
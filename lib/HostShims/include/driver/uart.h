@@ -0,0 +1,11 @@
+#pragma once
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef int uart_port_t;
+#define UART_NUM_0 0
+#define UART_NUM_1 1
+#define UART_NUM_2 2
+
+// Host serial ports transmit instantly, so this always succeeds
+esp_err_t uart_wait_tx_done(uart_port_t port, TickType_t ticks);
@@ -0,0 +1,8 @@
+#pragma once
+/*
+ * ROM cache control. The host has no cache the firmware can see; the
+ * invalidation is a no-op, so cold-cache benchmark cases measure warm there.
+ */
+#include <stdint.h>
+
+inline void Cache_Invalidate_ICache_All() {}
@@ -0,0 +1,8 @@
+#pragma once
+#include <freertos/FreeRTOS.h>
+#include "esp_err.h"
+
+typedef bool (*esp_freertos_idle_cb_t)(void);
+
+// There are no idle tasks on the host: returns ESP_ERR_NOT_SUPPORTED
+esp_err_t esp_register_freertos_idle_hook_for_cpu(esp_freertos_idle_cb_t callback, UBaseType_t cpu);
@@ -0,0 +1,24 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+// Host stand-ins for the heap regions and watermarks. Internal RAM is a
+// nominal HOST_HEAP_BYTES heap less what the process has allocated
+// (mallinfo2); PSRAM is HOST_PSRAM_BYTES less what heap_caps_malloc() placed
+// there. The minimum is the lowest free value seen by any of these calls,
+// not a true low-water mark.
+#define HOST_HEAP_BYTES (320 * 1024)
+#define HOST_PSRAM_BYTES (8 * 1024 * 1024)
+
+void* heap_caps_malloc(size_t size, uint32_t caps);
+void heap_caps_free(void* ptr);
+
+size_t heap_caps_get_total_size(uint32_t caps);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
@@ -0,0 +1,54 @@
+#pragma once
+/*
+ * FreeRTOS API on top of std::thread. Tasks are threads, ticks are
+ * milliseconds, priorities and core affinity are recorded but not enforced.
+ * Every critical section (portENTER_CRITICAL*) takes one global recursive
+ * lock, which is stricter than a per-mux spinlock but has the same
+ * guarantees for the code inside.
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint8_t StackType_t;
+
+typedef struct HostTask* TaskHandle_t;
+typedef struct HostQueue* QueueHandle_t;
+typedef QueueHandle_t SemaphoreHandle_t;
+// Storage for the *Static creators; the host allocates and ignores it
+typedef struct { void* reserved; } StaticSemaphore_t;
+
+#define configTICK_RATE_HZ 1000
+#define configUSE_TRACE_FACILITY 0
+#define configGENERATE_RUN_TIME_STATS 0
+#define configMAX_TASK_NAME_LEN 16
+#define portNUM_PROCESSORS 2
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY 0xffffffffUL
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+#define configASSERT(x) do { if (!(x)) hostAbort("configASSERT failed: %s at %s:%d", #x, __FILE__, __LINE__); } while (0)
+
+typedef struct {
+    uint32_t unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+
+void hostEnterCritical();
+void hostExitCritical();
+[[noreturn]] void hostAbort(const char* format, ...);
+
+#define portENTER_CRITICAL(mux) ((void)(mux), hostEnterCritical())
+#define portEXIT_CRITICAL(mux) ((void)(mux), hostExitCritical())
+#define portENTER_CRITICAL_ISR(mux) portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_ISR(mux) portEXIT_CRITICAL(mux)
+#define portYIELD_FROM_ISR(...) ((void)0)
@@ -0,0 +1,11 @@
+#pragma once
+#include "FreeRTOS.h"
+
+// Stack bounds aren't tracked on the host; only pxTCB is filled in
+typedef struct {
+    void* pxTCB;
+    StackType_t* pxTopOfStack;
+    StackType_t* pxEndOfStack;
+} TaskSnapshot_t;
+
+UBaseType_t uxTaskGetSnapshotAll(TaskSnapshot_t* const snapshots, const UBaseType_t size, UBaseType_t* const tcbSize);
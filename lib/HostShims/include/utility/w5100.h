@@ -0,0 +1,27 @@
+#pragma once
+#include <SPI.h>
+
+#define SPI_ETHERNET_SETTINGS SPISettings(14000000, MSBFIRST, SPI_MODE0)
+#define MAX_SOCK_NUM 8
+
+typedef uint8_t SOCKET;
+
+class SnSR {
+public:
+    static const uint8_t CLOSED = 0x00;
+    static const uint8_t UDP = 0x22;
+};
+
+// Register access the firmware uses for soft reset, the chip version, IP
+// read-back and socket status. Open sockets occupy the lowest indexes.
+class W5100Class {
+public:
+    static uint8_t readVERSIONR_W5500();
+    static void writeMR(uint8_t value);
+    static uint8_t readMR();
+    static void getIPAddress(uint8_t* address);
+    static uint8_t readSnSR(SOCKET s);
+    static uint16_t readSnPORT(SOCKET s);
+};
+
+extern W5100Class W5100;
@@ -0,0 +1,388 @@
+#include <Arduino.h>
+#include <HostShims.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <malloc.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// --- Time ---
+
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+static std::atomic<uint64_t> skippedUs{0};
+
+static uint64_t elapsedUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count() +
+           skippedUs;
+}
+
+void HostClock::advance(uint32_t ms) { skippedUs += (uint64_t)ms * 1000; }
+
+unsigned long millis() { return (unsigned long)(elapsedUs() / 1000); }
+unsigned long micros() { return (unsigned long)elapsedUs(); }
+int64_t esp_timer_get_time() { return (int64_t)elapsedUs(); }
+
+void delay(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+void delayMicroseconds(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+void yield() { std::this_thread::yield(); }
+
+// --- Errors ---
+
+void hostAbort(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    fputs("\r\nHOST ABORT: ", stderr);
+    vfprintf(stderr, format, args);
+    fputs("\r\n", stderr);
+    va_end(args);
+    fflush(stdout);
+    abort();
+}
+
+const char* esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK:                        return "ESP_OK";
+        case ESP_FAIL:                      return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:                return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:           return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:         return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:          return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:             return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_TIMEOUT:               return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_NVS_NOT_INITIALIZED:   return "ESP_ERR_NVS_NOT_INITIALIZED";
+        case ESP_ERR_NVS_NOT_FOUND:         return "ESP_ERR_NVS_NOT_FOUND";
+        case ESP_ERR_NVS_INVALID_HANDLE:    return "ESP_ERR_NVS_INVALID_HANDLE";
+        case ESP_ERR_NVS_INVALID_LENGTH:    return "ESP_ERR_NVS_INVALID_LENGTH";
+        case ESP_ERR_NVS_NO_FREE_PAGES:     return "ESP_ERR_NVS_NO_FREE_PAGES";
+        case ESP_ERR_NVS_NEW_VERSION_FOUND: return "ESP_ERR_NVS_NEW_VERSION_FOUND";
+        default:                            return "UNKNOWN ERROR";
+    }
+}
+
+#if !defined(__APPLE__) && !__GLIBC_PREREQ(2, 38)
+extern "C" size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+// --- GPIO ---
+
+#define HOST_GPIO_COUNT 64
+
+struct PinState {
+    int level = HIGH;             // Inputs idle high (pull-ups)
+    void (*handler)(void*) = nullptr;
+    void* arg = nullptr;
+    int mode = 0;
+};
+
+static std::mutex gpioMutex;
+static PinState pins[HOST_GPIO_COUNT];
+static uint8_t neopixel[3];
+
+void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+    if (pin >= HOST_GPIO_COUNT) return;
+    std::lock_guard<std::mutex> lock(gpioMutex);
+    pins[pin].level = level ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    if (pin >= HOST_GPIO_COUNT) return LOW;
+    std::lock_guard<std::mutex> lock(gpioMutex);
+    return pins[pin].level;
+}
+
+void neopixelWrite(uint8_t pin, uint8_t red, uint8_t green, uint8_t blue) {
+    (void)pin;
+    std::lock_guard<std::mutex> lock(gpioMutex);
+    neopixel[0] = red;
+    neopixel[1] = green;
+    neopixel[2] = blue;
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode) {
+    if (pin >= HOST_GPIO_COUNT) return;
+    std::lock_guard<std::mutex> lock(gpioMutex);
+    pins[pin].handler = handler;
+    pins[pin].arg = arg;
+    pins[pin].mode = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+    if (pin >= HOST_GPIO_COUNT) return;
+    std::lock_guard<std::mutex> lock(gpioMutex);
+    pins[pin].handler = nullptr;
+}
+
+void HostGpio::setLevel(uint8_t pin, int level) {
+    if (pin >= HOST_GPIO_COUNT) return;
+    void (*handler)(void*) = nullptr;
+    void* arg = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(gpioMutex);
+        PinState& p = pins[pin];
+        level = level ? HIGH : LOW;
+        bool rising = p.level == LOW && level == HIGH;
+        bool falling = p.level == HIGH && level == LOW;
+        p.level = level;
+        if ((p.mode == CHANGE && (rising || falling)) || (p.mode == RISING && rising) || (p.mode == FALLING && falling)) {
+            handler = p.handler;
+            arg = p.arg;
+        }
+    }
+    // The "ISR" runs on the caller's thread
+    if (handler != nullptr) handler(arg);
+}
+
+int HostGpio::getLevel(uint8_t pin) {
+    return digitalRead(pin);
+}
+
+void HostGpio::getNeopixel(uint8_t rgb[3]) {
+    std::lock_guard<std::mutex> lock(gpioMutex);
+    memcpy(rgb, neopixel, 3);
+}
+
+// --- Print ---
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char local[128];
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(local, sizeof(local), format, copy);
+    va_end(copy);
+    if (len < 0) {
+        va_end(args);
+        return 0;
+    }
+
+    size_t written;
+    if ((size_t)len < sizeof(local)) {
+        written = write((const uint8_t*)local, len);
+    } else {
+        std::string big(len + 1, '\0');
+        vsnprintf(&big[0], big.size(), format, args);
+        written = write((const uint8_t*)big.data(), len);
+    }
+    va_end(args);
+    return written;
+}
+
+size_t Print::print(long n, int base) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%ld", n);
+    return write(buf);
+}
+
+size_t Print::print(unsigned long n, int base) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", n);
+    return write(buf);
+}
+
+size_t Print::print(double n, int digits) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+}
+
+size_t IPAddress::printTo(Print& p) const {
+    return p.printf("%u.%u.%u.%u", _address.bytes[0], _address.bytes[1], _address.bytes[2], _address.bytes[3]);
+}
+
+// --- Serial ports ---
+
+#define HOST_UART_COUNT 3
+#define HOST_UART_CAPTURE_LIMIT (1 << 20)   // Oldest output is dropped beyond this
+
+// Captured output is a fixed ring, so writing does not allocate in the
+// firmware's task (HeapGuard would count it; the driver has a TX ring too)
+struct UartState {
+    std::mutex mutex;
+    std::deque<uint8_t> input;
+    uint8_t output[HOST_UART_CAPTURE_LIMIT];
+    size_t outputHead;                  // Oldest captured byte
+    size_t outputCount;
+    bool echo;
+    bool capture;
+};
+
+static UartState uarts[HOST_UART_COUNT];
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+
+static struct UartDefaults {
+    UartDefaults() {
+        for (int i = 0; i < HOST_UART_COUNT; i++) {
+            uarts[i].echo = (i == 0);
+            uarts[i].capture = (i != 0);
+        }
+    }
+} uartDefaults;
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rxPin, int8_t txPin) {
+    (void)baud; (void)config; (void)rxPin; (void)txPin;
+}
+
+int HardwareSerial::available() {
+    std::lock_guard<std::mutex> lock(uarts[_port].mutex);
+    return (int)uarts[_port].input.size();
+}
+
+int HardwareSerial::read() {
+    std::lock_guard<std::mutex> lock(uarts[_port].mutex);
+    if (uarts[_port].input.empty()) return -1;
+    int c = uarts[_port].input.front();
+    uarts[_port].input.pop_front();
+    return c;
+}
+
+int HardwareSerial::peek() {
+    std::lock_guard<std::mutex> lock(uarts[_port].mutex);
+    return uarts[_port].input.empty() ? -1 : uarts[_port].input.front();
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    UartState& uart = uarts[_port];
+    std::lock_guard<std::mutex> lock(uart.mutex);
+    if (uart.echo) {
+        fwrite(buffer, 1, size, stdout);
+        fflush(stdout);
+    }
+    if (uart.capture) {
+        for (size_t i = 0; i < size; i++) {
+            uart.output[(uart.outputHead + uart.outputCount) % HOST_UART_CAPTURE_LIMIT] = buffer[i];
+            if (uart.outputCount < HOST_UART_CAPTURE_LIMIT) uart.outputCount++;
+            else uart.outputHead = (uart.outputHead + 1) % HOST_UART_CAPTURE_LIMIT;
+        }
+    }
+    return size;
+}
+
+std::vector<uint8_t> HostSerial::takeOutput(int port) {
+    if (port < 0 || port >= HOST_UART_COUNT) return {};
+    std::lock_guard<std::mutex> lock(uarts[port].mutex);
+    UartState& uart = uarts[port];
+    std::vector<uint8_t> out(uart.outputCount);
+    for (size_t i = 0; i < uart.outputCount; i++) {
+        out[i] = uart.output[(uart.outputHead + i) % HOST_UART_CAPTURE_LIMIT];
+    }
+    uart.outputHead = 0;
+    uart.outputCount = 0;
+    return out;
+}
+
+void HostSerial::feedInput(int port, const uint8_t* data, size_t len) {
+    if (port < 0 || port >= HOST_UART_COUNT) return;
+    std::lock_guard<std::mutex> lock(uarts[port].mutex);
+    uarts[port].input.insert(uarts[port].input.end(), data, data + len);
+}
+
+void HostSerial::setEcho(int port, bool enable) {
+    if (port < 0 || port >= HOST_UART_COUNT) return;
+    std::lock_guard<std::mutex> lock(uarts[port].mutex);
+    uarts[port].echo = enable;
+}
+
+void HostSerial::setCapture(int port, bool enable) {
+    if (port < 0 || port >= HOST_UART_COUNT) return;
+    std::lock_guard<std::mutex> lock(uarts[port].mutex);
+    uarts[port].capture = enable;
+    if (!enable) {
+        uarts[port].outputHead = 0;
+        uarts[port].outputCount = 0;
+    }
+}
+
+// --- Heap ---
+
+static size_t hostMinFree = HOST_HEAP_BYTES;
+static size_t hostPsramUsed = 0;
+static size_t hostPsramMinFree = HOST_PSRAM_BYTES;
+static std::mutex hostPsramMutex;
+static std::map<void*, size_t> hostPsramBlocks;
+
+void* heap_caps_malloc(size_t size, uint32_t caps) {
+    if (!(caps & MALLOC_CAP_SPIRAM)) return malloc(size);
+
+    std::lock_guard<std::mutex> lock(hostPsramMutex);
+    if (size > HOST_PSRAM_BYTES - hostPsramUsed) return nullptr;
+    void* ptr = malloc(size);
+    if (ptr == nullptr) return nullptr;
+    hostPsramBlocks[ptr] = size;
+    hostPsramUsed += size;
+    hostPsramMinFree = std::min(hostPsramMinFree, HOST_PSRAM_BYTES - hostPsramUsed);
+    return ptr;
+}
+
+void heap_caps_free(void* ptr) {
+    {
+        std::lock_guard<std::mutex> lock(hostPsramMutex);
+        auto block = hostPsramBlocks.find(ptr);
+        if (block != hostPsramBlocks.end()) {
+            hostPsramUsed -= block->second;
+            hostPsramBlocks.erase(block);
+        }
+    }
+    free(ptr);
+}
+
+size_t heap_caps_get_total_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? HOST_PSRAM_BYTES : HOST_HEAP_BYTES;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) {
+        std::lock_guard<std::mutex> lock(hostPsramMutex);
+        return HOST_PSRAM_BYTES - hostPsramUsed;
+    }
+    // PSRAM blocks come from the same process heap (large ones mmapped); do
+    // not count them twice
+    struct mallinfo2 info = mallinfo2();
+    size_t used = info.uordblks + info.hblkhd;
+    {
+        std::lock_guard<std::mutex> lock(hostPsramMutex);
+        used = used > hostPsramUsed ? used - hostPsramUsed : 0;
+    }
+    size_t free = used < HOST_HEAP_BYTES ? HOST_HEAP_BYTES - used : 0;
+    if (free < hostMinFree) hostMinFree = free;
+    return free;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) {
+        std::lock_guard<std::mutex> lock(hostPsramMutex);
+        return hostPsramMinFree;
+    }
+    heap_caps_get_free_size(caps);
+    return hostMinFree;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    // glibc does not fragment like multi_heap; report the free total
+    return heap_caps_get_free_size(caps);
+}
@@ -0,0 +1,479 @@
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/timers.h>
+#include <freertos/task_snapshot.h>
+#include <esp_freertos_hooks.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// --- Critical sections ---
+
+static std::recursive_mutex criticalMutex;
+
+void hostEnterCritical() { criticalMutex.lock(); }
+void hostExitCritical() { criticalMutex.unlock(); }
+
+// --- Tasks ---
+
+struct HostTask {
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t stackDepth;
+    UBaseType_t priority;
+    BaseType_t core;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t notifyValue = 0;
+    bool notifyPending = false;
+};
+
+// Thrown by vTaskDelete(NULL) to unwind the calling task's thread
+struct HostTaskExit {};
+
+static std::mutex registryMutex;
+static std::vector<HostTask*> registry;
+static thread_local HostTask* currentTask = nullptr;
+static const std::thread::id mainThread = std::this_thread::get_id();
+
+static HostTask* registerTask(const char* name, uint32_t stackDepth, UBaseType_t priority, BaseType_t core) {
+    HostTask* task = new HostTask();
+    strlcpy(task->name, name, sizeof(task->name));
+    task->stackDepth = stackDepth;
+    task->priority = priority;
+    task->core = core;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.push_back(task);
+    return task;
+}
+
+static void unregisterTask(HostTask* task) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (size_t i = 0; i < registry.size(); i++) {
+        if (registry[i] == task) {
+            registry.erase(registry.begin() + i);
+            break;
+        }
+    }
+}
+
+// Block on `cv` until `ready` or the timeout; ticks are milliseconds
+template <typename Predicate>
+static bool waitTicks(std::unique_lock<std::mutex>& lock, std::condition_variable& cv, TickType_t ticks, Predicate ready) {
+    if (ticks == portMAX_DELAY) {
+        cv.wait(lock, ready);
+        return true;
+    }
+    return cv.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* createdTask, BaseType_t coreId) {
+    HostTask* task = registerTask(name, stackDepth, priority, coreId);
+    if (createdTask != nullptr) *createdTask = task;
+
+    std::thread([task, code, parameter]() {
+        currentTask = task;
+        try {
+            code(parameter);
+            hostAbort("Task %s returned from its function", task->name);
+        } catch (const HostTaskExit&) {
+        }
+        unregisterTask(task);
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char* name, uint32_t stackDepth, void* parameter,
+                       UBaseType_t priority, TaskHandle_t* createdTask) {
+    return xTaskCreatePinnedToCore(code, name, stackDepth, parameter, priority, createdTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (task == nullptr || task == currentTask) {
+        throw HostTaskExit();
+    }
+    // Another thread can't be stopped from outside
+    hostAbort("vTaskDelete of another task (%s) is not supported on the host", task->name);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (ticks == 0) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+    }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    // Threads not created through xTaskCreate* are adopted on first use
+    if (currentTask == nullptr) {
+        bool isMain = std::this_thread::get_id() == mainThread;
+        currentTask = registerTask(isMain ? "loopTask" : "host", 8192, 1, isMain ? 1 : tskNO_AFFINITY);
+    }
+    return currentTask;
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)millis();
+}
+
+void vTaskSuspendAll() {}
+
+BaseType_t xTaskResumeAll() {
+    return pdFALSE;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return (UBaseType_t)registry.size();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    if (task == nullptr) task = xTaskGetCurrentTaskHandle();
+    return task->stackDepth;
+}
+
+const char* pcTaskGetName(TaskHandle_t task) {
+    if (task == nullptr) task = xTaskGetCurrentTaskHandle();
+    return task->name;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task) {
+    if (task == nullptr) task = xTaskGetCurrentTaskHandle();
+    return task->priority;
+}
+
+BaseType_t xTaskGetAffinity(TaskHandle_t task) {
+    if (task == nullptr) task = xTaskGetCurrentTaskHandle();
+    return task->core;
+}
+
+UBaseType_t uxTaskGetSnapshotAll(TaskSnapshot_t* const snapshots, const UBaseType_t size, UBaseType_t* const tcbSize) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    UBaseType_t n = 0;
+    for (; n < size && n < registry.size(); n++) {
+        snapshots[n] = {registry[n], nullptr, nullptr};
+    }
+    *tcbSize = sizeof(HostTask);
+    return n;
+}
+
+esp_err_t esp_register_freertos_idle_hook_for_cpu(esp_freertos_idle_cb_t callback, UBaseType_t cpu) {
+    (void)callback; (void)cpu;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+BaseType_t xPortGetCoreID() {
+    BaseType_t core = xTaskGetCurrentTaskHandle()->core;
+    return core == tskNO_AFFINITY ? 0 : core;
+}
+
+// --- Task notifications ---
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+    if (task == nullptr) return pdFAIL;
+    std::lock_guard<std::mutex> lock(task->mutex);
+    switch (action) {
+        case eSetBits:                  task->notifyValue |= value; break;
+        case eIncrement:                task->notifyValue++; break;
+        case eSetValueWithOverwrite:    task->notifyValue = value; break;
+        case eSetValueWithoutOverwrite:
+            if (task->notifyPending) return pdFAIL;
+            task->notifyValue = value;
+            break;
+        case eNoAction:                 break;
+    }
+    task->notifyPending = true;
+    task->cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action, BaseType_t* woken) {
+    if (woken != nullptr) *woken = pdFALSE;
+    return xTaskNotify(task, value, action);
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t* value, TickType_t ticks) {
+    HostTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    if (!task->notifyPending) {
+        task->notifyValue &= ~clearOnEntry;
+    }
+    if (!waitTicks(lock, task->cv, ticks, [task]() { return task->notifyPending; })) {
+        if (value != nullptr) *value = task->notifyValue;
+        return pdFALSE;
+    }
+    if (value != nullptr) *value = task->notifyValue;
+    task->notifyValue &= ~clearOnExit;
+    task->notifyPending = false;
+    return pdTRUE;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    return xTaskNotify(task, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) {
+    if (woken != nullptr) *woken = pdFALSE;
+    xTaskNotify(task, 0, eIncrement);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    HostTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    waitTicks(lock, task->cv, ticks, [task]() { return task->notifyValue != 0; });
+    uint32_t value = task->notifyValue;
+    if (value != 0) {
+        task->notifyValue = clearOnExit ? 0 : value - 1;
+    }
+    task->notifyPending = false;
+    return value;
+}
+
+// --- Queues and semaphores ---
+
+struct HostQueue {
+    enum Kind { QUEUE, BINARY, COUNTING, MUTEX, RECURSIVE_MUTEX };
+
+    Kind kind;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    // Queue storage (ring buffer of fixed-size items)
+    std::vector<uint8_t> storage;
+    UBaseType_t itemSize = 0;
+    UBaseType_t length = 0;
+    UBaseType_t head = 0;
+
+    // Items waiting, or the semaphore count
+    UBaseType_t count = 0;
+    UBaseType_t maxCount = 0;
+
+    // Mutex ownership
+    HostTask* holder = nullptr;
+    UBaseType_t depth = 0;
+};
+
+static HostQueue* newSemaphore(HostQueue::Kind kind, UBaseType_t maxCount, UBaseType_t initialCount) {
+    HostQueue* q = new HostQueue();
+    q->kind = kind;
+    q->maxCount = maxCount;
+    q->count = initialCount;
+    return q;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    HostQueue* q = new HostQueue();
+    q->kind = HostQueue::QUEUE;
+    q->itemSize = itemSize;
+    q->length = length;
+    q->storage.resize((size_t)length * itemSize);
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if (!waitTicks(lock, q->cv, ticks, [q]() { return q->count < q->length; })) {
+        return pdFAIL;
+    }
+    UBaseType_t tail = (q->head + q->count) % q->length;
+    memcpy(&q->storage[(size_t)tail * q->itemSize], item, q->itemSize);
+    q->count++;
+    q->cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void* item, BaseType_t* woken) {
+    if (woken != nullptr) *woken = pdFALSE;
+    return xQueueSend(q, item, 0);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void* item) {
+    std::lock_guard<std::mutex> lock(q->mutex);
+    q->head = 0;
+    q->count = 1;
+    memcpy(q->storage.data(), item, q->itemSize);
+    q->cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if (!waitTicks(lock, q->cv, ticks, [q]() { return q->count > 0; })) {
+        return pdFAIL;
+    }
+    memcpy(item, &q->storage[(size_t)q->head * q->itemSize], q->itemSize);
+    q->head = (q->head + 1) % q->length;
+    q->count--;
+    q->cv.notify_all();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    std::lock_guard<std::mutex> lock(q->mutex);
+    return q->count;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() { return newSemaphore(HostQueue::BINARY, 1, 0); }
+SemaphoreHandle_t xSemaphoreCreateMutex() { return newSemaphore(HostQueue::MUTEX, 1, 1); }
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t*) { return newSemaphore(HostQueue::MUTEX, 1, 1); }
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return newSemaphore(HostQueue::RECURSIVE_MUTEX, 1, 1); }
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    return newSemaphore(HostQueue::COUNTING, maxCount, initialCount);
+}
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) { delete semaphore; }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+    HostTask* self = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(s->mutex);
+
+    if (s->kind == HostQueue::RECURSIVE_MUTEX && s->holder == self) {
+        s->depth++;
+        return pdPASS;
+    }
+    if (!waitTicks(lock, s->cv, ticks, [s]() { return s->count > 0; })) {
+        return pdFAIL;
+    }
+    s->count--;
+    if (s->kind == HostQueue::MUTEX || s->kind == HostQueue::RECURSIVE_MUTEX) {
+        s->holder = self;
+        s->depth = 1;
+    }
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    std::lock_guard<std::mutex> lock(s->mutex);
+
+    if (s->kind == HostQueue::MUTEX || s->kind == HostQueue::RECURSIVE_MUTEX) {
+        if (s->holder != currentTask) return pdFAIL;
+        if (--s->depth > 0) return pdPASS;
+        s->holder = nullptr;
+    }
+    if (s->count >= s->maxCount) return pdFAIL;
+    s->count++;
+    s->cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t s, BaseType_t* woken) {
+    if (woken != nullptr) *woken = pdFALSE;
+    return xSemaphoreGive(s);
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t ticks) { return xSemaphoreTake(s, ticks); }
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s) { return xSemaphoreGive(s); }
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t s) {
+    std::lock_guard<std::mutex> lock(s->mutex);
+    return s->holder;
+}
+
+// --- Software timers ---
+
+struct HostTimer {
+    char name[configMAX_TASK_NAME_LEN];
+    TickType_t period;
+    bool autoReload;
+    void* id;
+    TimerCallbackFunction_t callback;
+    bool active = false;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+static std::mutex timerMutex;
+static std::condition_variable timerCv;
+static std::vector<HostTimer*> timers;
+static std::once_flag timerServiceStarted;
+
+static void timerService() {
+    currentTask = registerTask("Tmr Svc", 4096, 1, tskNO_AFFINITY);
+    std::unique_lock<std::mutex> lock(timerMutex);
+    for (;;) {
+        HostTimer* next = nullptr;
+        for (HostTimer* t : timers) {
+            if (t->active && (next == nullptr || t->deadline < next->deadline)) next = t;
+        }
+        if (next == nullptr) {
+            timerCv.wait(lock);
+            continue;
+        }
+        if (std::chrono::steady_clock::now() < next->deadline) {
+            timerCv.wait_until(lock, next->deadline);
+            continue;
+        }
+
+        if (next->autoReload) {
+            next->deadline += std::chrono::milliseconds(next->period);
+        } else {
+            next->active = false;
+        }
+        lock.unlock();
+        next->callback(next);
+        lock.lock();
+    }
+}
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* id,
+                           TimerCallbackFunction_t callback) {
+    std::call_once(timerServiceStarted, []() { std::thread(timerService).detach(); });
+
+    HostTimer* timer = new HostTimer();
+    strlcpy(timer->name, name, sizeof(timer->name));
+    timer->period = period;
+    timer->autoReload = autoReload != pdFALSE;
+    timer->id = id;
+    timer->callback = callback;
+
+    std::lock_guard<std::mutex> lock(timerMutex);
+    timers.push_back(timer);
+    return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks) {
+    (void)ticks;
+    std::lock_guard<std::mutex> lock(timerMutex);
+    timer->active = true;
+    timer->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timer->period);
+    timerCv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticks) {
+    return xTimerStart(timer, ticks);
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks) {
+    (void)ticks;
+    std::lock_guard<std::mutex> lock(timerMutex);
+    timer->active = false;
+    timerCv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticks) {
+    {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        timer->period = period;
+    }
+    return xTimerStart(timer, ticks);
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer) {
+    std::lock_guard<std::mutex> lock(timerMutex);
+    return timer->active ? pdTRUE : pdFALSE;
+}
+
+void* pvTimerGetTimerID(TimerHandle_t timer) {
+    return timer->id;
+}
@@ -0,0 +1,130 @@
+/*
+ * Entry point for the firmware on Linux (pio run -e native). Lives in its
+ * own object so test binaries, which bring their own main(), never pull it
+ * out of the library archive.
+ *
+ * Environment:
+ *   HOST_RUN_MS=<ms>         exit cleanly after this long (profiling runs)
+ *   HOST_UDP_PORTS=5568,...  bridge these real UDP ports to the fake W5500,
+ *                            so sACN senders on the network reach the firmware
+ *   HOST_TASK_WDT=0          disable the task watchdog checker
+ * Standard input is fed to Serial, so the serial console works.
+ */
+#include <Arduino.h>
+#include <HostShims.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct BridgeSocket {
+    uint16_t port;
+    int fd;
+};
+
+std::vector<BridgeSocket> bridgeSockets;
+
+void stdinReader() {
+    int c;
+    while ((c = getchar()) != EOF) {
+        uint8_t byte = (uint8_t)c;
+        HostSerial::feedInput(0, &byte, 1);
+    }
+}
+
+void bridgeReceive() {
+    std::vector<pollfd> fds;
+    for (const BridgeSocket& s : bridgeSockets) fds.push_back({s.fd, POLLIN, 0});
+
+    uint8_t buffer[2048];
+    for (;;) {
+        if (poll(fds.data(), fds.size(), -1) <= 0) continue;
+        for (size_t i = 0; i < fds.size(); i++) {
+            if (!(fds[i].revents & POLLIN)) continue;
+            sockaddr_in from = {};
+            socklen_t fromLen = sizeof(from);
+            ssize_t len = recvfrom(fds[i].fd, buffer, sizeof(buffer), 0, (sockaddr*)&from, &fromLen);
+            if (len < 0) continue;
+            HostNet::inject(bridgeSockets[i].port, buffer, (size_t)len,
+                            IPAddress((uint32_t)from.sin_addr.s_addr), ntohs(from.sin_port));
+        }
+    }
+}
+
+void bridgeTransmit() {
+    for (;;) {
+        HostNet::Datagram d;
+        if (!HostNet::takeSent(d)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        for (const BridgeSocket& s : bridgeSockets) {
+            if (s.port != d.localPort) continue;
+            sockaddr_in to = {};
+            to.sin_family = AF_INET;
+            to.sin_addr.s_addr = (uint32_t)d.remoteIP;
+            to.sin_port = htons(d.remotePort);
+            sendto(s.fd, d.data.data(), d.data.size(), 0, (sockaddr*)&to, sizeof(to));
+        }
+    }
+}
+
+void startBridge(const char* ports) {
+    while (ports != nullptr && *ports != '\0') {
+        char* end;
+        long port = strtol(ports, &end, 10);
+        if (end == ports) break;
+        ports = (*end == ',') ? end + 1 : end;
+
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons((uint16_t)port);
+        if (fd < 0 || bind(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            fprintf(stderr, "host: cannot bind UDP port %ld\n", port);
+            if (fd >= 0) close(fd);
+            continue;
+        }
+        bridgeSockets.push_back({(uint16_t)port, fd});
+        fprintf(stderr, "host: bridging UDP port %ld\n", port);
+    }
+
+    if (!bridgeSockets.empty()) {
+        std::thread(bridgeReceive).detach();
+        std::thread(bridgeTransmit).detach();
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::thread(stdinReader).detach();
+    startBridge(getenv("HOST_UDP_PORTS"));
+
+    const char* runMs = getenv("HOST_RUN_MS");
+    if (runMs != nullptr) {
+        unsigned long duration = strtoul(runMs, nullptr, 10);
+        std::thread([duration]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+            fflush(stdout);
+            // Tasks never return, so skip static destructors they may still use
+            _exit(0);
+        }).detach();
+    }
+
+    // The main thread plays the Arduino loopTask
+    xTaskGetCurrentTaskHandle();
+    setup();
+    for (;;) {
+        loop();
+    }
+}
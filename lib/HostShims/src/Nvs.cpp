@@ -0,0 +1,120 @@
+#include <nvs.h>
+#include <nvs_flash.h>
+#include <HostShims.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Entry {
+    bool isString;
+    std::vector<uint8_t> data;   // Strings include their terminator
+};
+
+std::mutex nvsMutex;
+std::map<std::string, std::map<std::string, Entry>> namespaces;
+std::vector<std::string> handles;   // nvs_handle_t - 1 indexes this
+uint32_t commits = 0;
+
+std::map<std::string, Entry>* lookup(nvs_handle_t handle) {
+    if (handle == 0 || handle > handles.size()) return nullptr;
+    return &namespaces[handles[handle - 1]];
+}
+
+esp_err_t getEntry(nvs_handle_t handle, const char* key, void* out, size_t* length) {
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    auto* ns = lookup(handle);
+    if (ns == nullptr) return ESP_ERR_NVS_INVALID_HANDLE;
+    auto it = ns->find(key);
+    if (it == ns->end()) return ESP_ERR_NVS_NOT_FOUND;
+
+    const std::vector<uint8_t>& data = it->second.data;
+    if (out == nullptr) {
+        *length = data.size();
+        return ESP_OK;
+    }
+    if (*length < data.size()) return ESP_ERR_NVS_INVALID_LENGTH;
+    memcpy(out, data.data(), data.size());
+    *length = data.size();
+    return ESP_OK;
+}
+
+esp_err_t setEntry(nvs_handle_t handle, const char* key, const void* value, size_t length, bool isString) {
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    auto* ns = lookup(handle);
+    if (ns == nullptr) return ESP_ERR_NVS_INVALID_HANDLE;
+    Entry& entry = (*ns)[key];
+    entry.isString = isString;
+    entry.data.assign((const uint8_t*)value, (const uint8_t*)value + length);
+    return ESP_OK;
+}
+
+}  // namespace
+
+esp_err_t nvs_flash_init() { return ESP_OK; }
+
+esp_err_t nvs_flash_erase() {
+    HostNvs::clear();
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t mode, nvs_handle_t* handle) {
+    (void)mode;
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    handles.push_back(name);
+    *handle = (nvs_handle_t)handles.size();
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) { (void)handle; }
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out, size_t* length) {
+    return getEntry(handle, key, out, length);
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+    return setEntry(handle, key, value, length, false);
+}
+
+esp_err_t nvs_get_str(nvs_handle_t handle, const char* key, char* out, size_t* length) {
+    return getEntry(handle, key, out, length);
+}
+
+esp_err_t nvs_set_str(nvs_handle_t handle, const char* key, const char* value) {
+    return setEntry(handle, key, value, strlen(value) + 1, true);
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key) {
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    auto* ns = lookup(handle);
+    if (ns == nullptr) return ESP_ERR_NVS_INVALID_HANDLE;
+    return ns->erase(key) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t handle) {
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    auto* ns = lookup(handle);
+    if (ns == nullptr) return ESP_ERR_NVS_INVALID_HANDLE;
+    ns->clear();
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    if (lookup(handle) == nullptr) return ESP_ERR_NVS_INVALID_HANDLE;
+    commits++;
+    return ESP_OK;
+}
+
+void HostNvs::clear() {
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    namespaces.clear();
+    commits = 0;
+}
+
+uint32_t HostNvs::commitCount() {
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    return commits;
+}
@@ -0,0 +1,199 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include <driver/i2c.h>
+#include <driver/uart.h>
+#include <esp_task_wdt.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+SPIClass SPI;
+TwoWire Wire;
+
+// --- UART / I2C drivers ---
+
+esp_err_t uart_wait_tx_done(uart_port_t port, TickType_t ticks) {
+    (void)port; (void)ticks;
+    return ESP_OK;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create_static(uint8_t* buffer, uint32_t size) {
+    (void)size;
+    return buffer;
+}
+
+void i2c_cmd_link_delete_static(i2c_cmd_handle_t cmd) { (void)cmd; }
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd) { (void)cmd; return ESP_OK; }
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd) { (void)cmd; return ESP_OK; }
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ackEnable) {
+    (void)cmd; (void)data; (void)ackEnable;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd, const uint8_t* data, size_t len, bool ackEnable) {
+    (void)cmd; (void)data; (void)len; (void)ackEnable;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks) {
+    (void)port; (void)cmd; (void)ticks;
+    return ESP_OK;
+}
+
+// --- Graphics ---
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < h; i++) drawPixel(x, y + i, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int16_t i = 0; i < w; i++) drawPixel(x + i, y, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int16_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int16_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int16_t err = dx + dy;
+    for (;;) {
+        drawPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int16_t e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < w; i++) drawFastVLine(x + i, y, h, color);
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    // Classic 6x8 font metrics
+    if (c == '\n') {
+        _cursorX = 0;
+        _cursorY += 8 * _textSize;
+    } else if (c != '\r') {
+        _cursorX += 6 * _textSize;
+    }
+    return 1;
+}
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t resetPin, uint32_t clkDuring, uint32_t clkAfter)
+    : Adafruit_GFX(w, h), _buffer(new uint8_t[w * ((h + 7) / 8)]()) {
+    (void)twi; (void)resetPin; (void)clkDuring; (void)clkAfter;
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306() {
+    delete[] _buffer;
+}
+
+bool Adafruit_SSD1306::begin(uint8_t vccState, uint8_t address, bool reset, bool periphBegin) {
+    (void)vccState; (void)address; (void)reset; (void)periphBegin;
+    return true;
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+    memset(_buffer, 0, _width * ((_height + 7) / 8));
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    uint8_t& cell = _buffer[x + (y / 8) * _width];
+    uint8_t bit = 1 << (y & 7);
+    switch (color) {
+        case SSD1306_WHITE:   cell |= bit; break;
+        case SSD1306_BLACK:   cell &= ~bit; break;
+        case SSD1306_INVERSE: cell ^= bit; break;
+    }
+}
+
+// --- Task watchdog ---
+
+namespace {
+
+struct WatchedTask {
+    TaskHandle_t task;
+    std::chrono::steady_clock::time_point lastReset;
+    bool reported;
+};
+
+std::mutex wdtMutex;
+std::vector<WatchedTask> wdtTasks;
+uint32_t wdtTimeoutMs = 5000;
+bool wdtPanic = false;
+std::once_flag wdtStarted;
+
+void wdtChecker() {
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::lock_guard<std::mutex> lock(wdtMutex);
+        auto now = std::chrono::steady_clock::now();
+        for (WatchedTask& w : wdtTasks) {
+            auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(now - w.lastReset).count();
+            if (idle < wdtTimeoutMs || w.reported) continue;
+            w.reported = true;
+            fprintf(stderr, "E (%lu) task_wdt: Task watchdog got triggered by %s (%ld ms)\r\n",
+                    millis(), pcTaskGetName(w.task), (long)idle);
+            if (wdtPanic) hostAbort("Task watchdog timeout");
+        }
+    }
+}
+
+}  // namespace
+
+esp_err_t esp_task_wdt_init(uint32_t timeoutSeconds, bool panic) {
+    // HOST_TASK_WDT=0 turns the checker off, e.g. when stepping in a debugger
+    const char* enabled = getenv("HOST_TASK_WDT");
+    if (enabled != nullptr && strcmp(enabled, "0") == 0) return ESP_OK;
+
+    {
+        std::lock_guard<std::mutex> lock(wdtMutex);
+        wdtTimeoutMs = timeoutSeconds * 1000;
+        wdtPanic = panic;
+    }
+    std::call_once(wdtStarted, []() { std::thread(wdtChecker).detach(); });
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_add(TaskHandle_t task) {
+    if (task == nullptr) task = xTaskGetCurrentTaskHandle();
+    std::lock_guard<std::mutex> lock(wdtMutex);
+    wdtTasks.push_back({task, std::chrono::steady_clock::now(), false});
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_delete(TaskHandle_t task) {
+    if (task == nullptr) task = xTaskGetCurrentTaskHandle();
+    std::lock_guard<std::mutex> lock(wdtMutex);
+    for (size_t i = 0; i < wdtTasks.size(); i++) {
+        if (wdtTasks[i].task == task) {
+            wdtTasks.erase(wdtTasks.begin() + i);
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t esp_task_wdt_reset() {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    std::lock_guard<std::mutex> lock(wdtMutex);
+    for (WatchedTask& w : wdtTasks) {
+        if (w.task == self) {
+            w.lastReset = std::chrono::steady_clock::now();
+            w.reported = false;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
@@ -0,0 +1,341 @@
+/*
+ * Fake W5500 behind the Ethernet library API.
+ *
+ * Only one task may talk to the real chip at a time (EthBus serializes it),
+ * so every register or socket access here is checked for overlap with an
+ * access from another thread. An overlap aborts the process by default,
+ * which turns a missing EthBus::Guard into a test failure instead of a
+ * once-a-week corrupted SPI transfer.
+ */
+#include <Ethernet.h>
+#include <EthernetUdp.h>
+#include <utility/w5100.h>
+#include <HostShims.h>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <mutex>
+
+#define W5500_MR_RST 0x80
+#define FAKE_SENT_LIMIT 1024   // Oldest sent datagrams are dropped beyond this
+#define FAKE_TX_BYTES 2048     // Largest datagram, as EthernetUDP's TX buffer
+// Socket RX buffer: 2 KB each with the library's 8 sockets. Every datagram
+// takes an 8-byte header (peer IP, port, length) in it too; one that does
+// not fit is dropped by the chip.
+#define FAKE_RX_BUFFER_BYTES 2048
+#define FAKE_RX_HEADER_BYTES 8
+
+namespace {
+
+// Sent datagrams are kept in a fixed ring, so sending does not allocate in
+// the firmware's task (HeapGuard would count it; the chip has a TX buffer)
+struct SentDatagram {
+    uint16_t localPort;
+    IPAddress remoteIP;
+    uint16_t remotePort;
+    size_t length;
+    uint8_t data[FAKE_TX_BYTES];
+};
+
+struct FakeW5500 {
+    // Host-side bookkeeping lock; unrelated to the bus check below
+    std::mutex mutex;
+    bool hardwarePresent = true;
+    // What the library's W5100.init() found at the first Ethernet.begin();
+    // hardwareStatus() reports this for good, as on the device
+    bool initialized = false;
+    bool detected = false;
+    bool linkUp = true;
+    IPAddress ip;
+    std::map<uint16_t, std::deque<HostNet::Datagram>> sockets;   // Bound ports
+    SentDatagram sent[FAKE_SENT_LIMIT];
+    size_t sentHead = 0;                // Oldest
+    size_t sentCount = 0;
+
+    std::atomic<int> busUsers{0};
+    std::atomic<uint32_t> accesses{0};
+    std::atomic<uint32_t> concurrentAccesses{0};
+    std::atomic<bool> abortOnConcurrent{true};
+};
+
+FakeW5500 chip;
+thread_local int busDepth = 0;
+
+// One chip access; nesting on the same thread is a single access
+class BusAccess {
+public:
+    BusAccess() {
+        if (busDepth++ > 0) return;
+        chip.accesses++;
+        if (chip.busUsers.fetch_add(1) != 0) {
+            chip.concurrentAccesses++;
+            if (chip.abortOnConcurrent) {
+                hostAbort("W5500 accessed concurrently (task %s)", pcTaskGetName(nullptr));
+            }
+        }
+    }
+    ~BusAccess() {
+        if (--busDepth == 0) chip.busUsers--;
+    }
+};
+
+}  // namespace
+
+EthernetClass Ethernet;
+W5100Class W5100;
+
+// --- Ethernet ---
+
+void EthernetClass::begin(uint8_t* mac, IPAddress ip) {
+    (void)mac;
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    if (!chip.initialized) {
+        chip.initialized = true;
+        chip.detected = chip.hardwarePresent;
+    }
+    if (chip.hardwarePresent) chip.ip = ip;
+}
+
+EthernetHardwareStatus EthernetClass::hardwareStatus() {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    return chip.detected ? EthernetW5500 : EthernetNoHardware;
+}
+
+EthernetLinkStatus EthernetClass::linkStatus() {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    if (!chip.detected) return Unknown;
+    // A dead chip reads PHYCFGR as 0: link down, not "no hardware"
+    return chip.hardwarePresent && chip.linkUp ? LinkON : LinkOFF;
+}
+
+IPAddress EthernetClass::localIP() {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    return chip.ip;
+}
+
+// --- Registers ---
+
+void W5100Class::writeMR(uint8_t value) {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    if (chip.hardwarePresent && (value & W5500_MR_RST)) {
+        // A reset clears the network config and closes every socket
+        chip.ip = IPAddress();
+        chip.sockets.clear();
+    }
+}
+
+uint8_t W5100Class::readMR() {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    // A missing chip reads back as all ones, so a reset never completes
+    return chip.hardwarePresent ? 0x00 : 0xFF;
+}
+
+uint8_t W5100Class::readVERSIONR_W5500() {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    return chip.hardwarePresent ? 0x04 : 0x00;
+}
+
+void W5100Class::getIPAddress(uint8_t* address) {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    IPAddress ip = chip.hardwarePresent ? chip.ip : IPAddress();
+    for (int i = 0; i < 4; i++) address[i] = ip[i];
+}
+
+uint8_t W5100Class::readSnSR(SOCKET s) {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    return chip.hardwarePresent && s < chip.sockets.size() ? SnSR::UDP : SnSR::CLOSED;
+}
+
+uint16_t W5100Class::readSnPORT(SOCKET s) {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    if (!chip.hardwarePresent || s >= chip.sockets.size()) return 0;
+    auto socket = chip.sockets.begin();
+    std::advance(socket, s);
+    return socket->first;
+}
+
+// --- UDP sockets ---
+
+uint8_t EthernetUDP::begin(uint16_t port) {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    if (!chip.hardwarePresent) return 0;
+    chip.sockets[port];
+    _port = port;
+    _rxLength = _rxOffset = 0;
+    return 1;
+}
+
+void EthernetUDP::stop() {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    chip.sockets.erase(_port);
+    _port = 0;
+    _rxLength = _rxOffset = 0;
+}
+
+int EthernetUDP::parsePacket() {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+
+    // Like the library, any unread part of the previous datagram is discarded
+    _rxLength = _rxOffset = 0;
+
+    auto socket = chip.sockets.find(_port);
+    if (_port == 0 || socket == chip.sockets.end() || socket->second.empty()) return 0;
+
+    HostNet::Datagram& d = socket->second.front();
+    _rxLength = min(d.data.size(), sizeof(_rx));
+    if (_rxLength > 0) memcpy(_rx, d.data.data(), _rxLength);
+    _remoteIP = d.remoteIP;
+    _remotePort = d.remotePort;
+    socket->second.pop_front();
+    return (int)_rxLength;
+}
+
+int EthernetUDP::available() {
+    return (int)(_rxLength - _rxOffset);
+}
+
+int EthernetUDP::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int EthernetUDP::read(uint8_t* buffer, size_t len) {
+    BusAccess bus;
+    // The library returns -1 once the datagram is used up
+    size_t remaining = _rxLength - _rxOffset;
+    if (remaining == 0) return -1;
+    size_t n = min(len, remaining);
+    if (buffer != nullptr) memcpy(buffer, _rx + _rxOffset, n);
+    _rxOffset += n;
+    return (int)n;
+}
+
+int EthernetUDP::peek() {
+    return _rxOffset < _rxLength ? _rx[_rxOffset] : -1;
+}
+
+void EthernetUDP::flush() {
+    // Waits for TX in the library; nothing to do here
+}
+
+int EthernetUDP::beginPacket(IPAddress ip, uint16_t port) {
+    _txIP = ip;
+    _txPort = port;
+    _txLength = 0;
+    return 1;
+}
+
+size_t EthernetUDP::write(const uint8_t* buffer, size_t size) {
+    size_t n = min(size, sizeof(_tx) - _txLength);
+    memcpy(_tx + _txLength, buffer, n);
+    _txLength += n;
+    return n;
+}
+
+int EthernetUDP::endPacket() {
+    BusAccess bus;
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    if (!chip.hardwarePresent) return 0;
+    if (chip.sentCount == FAKE_SENT_LIMIT) {
+        chip.sentHead = (chip.sentHead + 1) % FAKE_SENT_LIMIT;
+        chip.sentCount--;
+    }
+    SentDatagram& d = chip.sent[(chip.sentHead + chip.sentCount++) % FAKE_SENT_LIMIT];
+    d.localPort = _port;
+    d.remoteIP = _txIP;
+    d.remotePort = _txPort;
+    d.length = min(_txLength, sizeof(d.data));
+    memcpy(d.data, _tx, d.length);
+    return 1;
+}
+
+// --- Host hooks ---
+
+bool HostNet::inject(uint16_t port, const uint8_t* data, size_t len, IPAddress from, uint16_t fromPort) {
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    auto socket = chip.sockets.find(port);
+    if (!chip.hardwarePresent || !chip.linkUp || socket == chip.sockets.end()) return false;
+
+    size_t used = 0;
+    for (const Datagram& queued : socket->second) used += queued.data.size() + FAKE_RX_HEADER_BYTES;
+    if (used + len + FAKE_RX_HEADER_BYTES > FAKE_RX_BUFFER_BYTES) return false;
+
+    Datagram d;
+    d.localPort = port;
+    d.remoteIP = from;
+    d.remotePort = fromPort;
+    d.data.assign(data, data + len);
+    socket->second.push_back(std::move(d));
+    return true;
+}
+
+size_t HostNet::pending(uint16_t port) {
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    auto socket = chip.sockets.find(port);
+    return socket == chip.sockets.end() ? 0 : socket->second.size();
+}
+
+bool HostNet::takeSent(Datagram& out) {
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    if (chip.sentCount == 0) return false;
+    const SentDatagram& d = chip.sent[chip.sentHead];
+    out.localPort = d.localPort;
+    out.remoteIP = d.remoteIP;
+    out.remotePort = d.remotePort;
+    out.data.assign(d.data, d.data + d.length);
+    chip.sentHead = (chip.sentHead + 1) % FAKE_SENT_LIMIT;
+    chip.sentCount--;
+    return true;
+}
+
+void HostNet::setHardwarePresent(bool present) {
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    // Power loss: the chip comes back reset
+    if (!present) {
+        chip.ip = IPAddress();
+        chip.sockets.clear();
+    }
+    chip.hardwarePresent = present;
+}
+
+void HostNet::closeSocket(uint16_t port) {
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    chip.sockets.erase(port);
+}
+
+void HostNet::setLink(bool up) {
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    chip.linkUp = up;
+}
+
+uint32_t HostNet::accessCount() { return chip.accesses; }
+uint32_t HostNet::concurrentAccessCount() { return chip.concurrentAccesses; }
+void HostNet::setAbortOnConcurrentAccess(bool enable) { chip.abortOnConcurrent = enable; }
+
+void HostNet::reset() {
+    std::lock_guard<std::mutex> lock(chip.mutex);
+    chip.hardwarePresent = true;
+    chip.initialized = false;
+    chip.detected = false;
+    chip.linkUp = true;
+    chip.ip = IPAddress();
+    chip.sockets.clear();
+    chip.sentHead = 0;
+    chip.sentCount = 0;
+    chip.accesses = 0;
+    chip.concurrentAccesses = 0;
+}
@@ -0,0 +1,104 @@
+#include "LatencyTrace.h"
+#include "Logger.h"
+#include <algorithm>
+#include <esp_timer.h>
+
+LatencyTrace::FrameTrace LatencyTrace::_ring[LATENCY_TRACE_RING_SIZE] = {};
+LatencyTrace::FrameTrace LatencyTrace::_current = {};
+bool LatencyTrace::_open = false;
+uint16_t LatencyTrace::_head = 0;
+uint16_t LatencyTrace::_count = 0;
+uint32_t LatencyTrace::_scratch[LATENCY_TRACE_RING_SIZE] = {};
+
+static portMUX_TYPE traceMux = portMUX_INITIALIZER_UNLOCKED;
+
+uint32_t LatencyTrace::now() {
+    // Never return 0, which marks a point as "not reached"
+    uint32_t t = (uint32_t)esp_timer_get_time();
+    return t ? t : 1;
+}
+
+void LatencyTrace::beginFrame() {
+    if (_open) {
+        endFrame();
+    }
+    memset(&_current, 0, sizeof(_current));
+    _current.stamp[TRACE_SOCKET_READY] = now();
+    _open = true;
+}
+
+void LatencyTrace::mark(TracePoint point) {
+    if (_open) {
+        _current.stamp[point] = now();
+    }
+}
+
+void LatencyTrace::endFrame() {
+    if (!_open) return;
+
+    portENTER_CRITICAL(&traceMux);
+    _ring[_head] = _current;
+    _head = (_head + 1) % LATENCY_TRACE_RING_SIZE;
+    if (_count < LATENCY_TRACE_RING_SIZE) _count++;
+    portEXIT_CRITICAL(&traceMux);
+
+    _open = false;
+}
+
+void LatencyTrace::abortFrame() {
+    _open = false;
+}
+
+bool LatencyTrace::frameOpen() {
+    return _open;
+}
+
+void LatencyTrace::reset() {
+    portENTER_CRITICAL(&traceMux);
+    _head = 0;
+    _count = 0;
+    portEXIT_CRITICAL(&traceMux);
+    LOG_INFO_TAG("TRACE", "Latency trace ring cleared");
+}
+
+void LatencyTrace::printStage(const char* name, TracePoint from, TracePoint to) {
+    uint16_t n = 0;
+
+    // Collect deltas for frames that reached both points
+    for (uint16_t i = 0; i < LATENCY_TRACE_RING_SIZE; i++) {
+        portENTER_CRITICAL(&traceMux);
+        bool valid = i < _count;
+        uint32_t a = _ring[i].stamp[from];
+        uint32_t b = _ring[i].stamp[to];
+        portEXIT_CRITICAL(&traceMux);
+
+        if (valid && a != 0 && b != 0) {
+            _scratch[n++] = b - a;
+        }
+    }
+
+    if (n == 0) {
+        Serial.printf("%-18s %6s\r\n", name, "-");
+        return;
+    }
+
+    std::sort(_scratch, _scratch + n);
+    Serial.printf("%-18s %6u %8lu %8lu %8lu %8lu\r\n", name, n,
+                  (unsigned long)_scratch[(n - 1) * 50 / 100],
+                  (unsigned long)_scratch[(n - 1) * 90 / 100],
+                  (unsigned long)_scratch[(n - 1) * 99 / 100],
+                  (unsigned long)_scratch[n - 1]);
+}
+
+void LatencyTrace::dumpPercentiles() {
+    Serial.println(F("\r\n=== FRAME LATENCY (us) ==="));
+    Serial.printf("%-18s %6s %8s %8s %8s %8s\r\n", "stage", "n", "p50", "p90", "p99", "max");
+    printStage("socket->header",   TRACE_SOCKET_READY,   TRACE_HEADER_READ);
+    printStage("header->payload",  TRACE_HEADER_READ,    TRACE_PAYLOAD_READ);
+    printStage("payload->process", TRACE_PAYLOAD_READ,   TRACE_PROCESSED);
+    printStage("process->enqueue", TRACE_PROCESSED,      TRACE_RADIO_ENQUEUE);
+    printStage("enqueue->first",   TRACE_RADIO_ENQUEUE,  TRACE_FIRST_BYTE_OUT);
+    printStage("first->last",      TRACE_FIRST_BYTE_OUT, TRACE_LAST_BYTE_OUT);
+    printStage("TOTAL",            TRACE_SOCKET_READY,   TRACE_LAST_BYTE_OUT);
+    Serial.println(F("==========================\r\n"));
+}
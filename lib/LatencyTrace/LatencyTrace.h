@@ -0,0 +1,70 @@
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+/*
+ * Per-frame latency tracing for the UDP -> HC-12 pipeline.
+ *
+ * Each accepted frame gets one record holding a microsecond timestamp
+ * (esp_timer) for every trace point below. Records live in a fixed ring of
+ * LATENCY_TRACE_RING_SIZE entries; dumpPercentiles() reports p50/p90/p99/max
+ * for every stage and for the end-to-end total.
+ *
+ * All marks are made from the network task. Only dumpPercentiles() and
+ * reset() may be called from another task.
+ */
+
+enum TracePoint : uint8_t {
+    TRACE_SOCKET_READY,     // W5500 reported a datagram
+    TRACE_HEADER_READ,      // E1.31 header copied out of the socket
+    TRACE_PAYLOAD_READ,     // DMX payload copied out of the socket
+    TRACE_PROCESSED,        // Frame ready to hand to the radio
+    TRACE_RADIO_ENQUEUE,    // sendDmxPacket() entered
+    TRACE_FIRST_BYTE_OUT,   // First byte accepted by the UART
+    TRACE_LAST_BYTE_OUT,    // UART TX FIFO drained
+    TRACE_POINT_COUNT
+};
+
+class LatencyTrace {
+public:
+    // Open a new frame and stamp TRACE_SOCKET_READY. Any frame still open
+    // (e.g. radio not yet drained) is committed as-is.
+    static void beginFrame();
+    static void mark(TracePoint point);
+    // Commit the open frame to the ring
+    static void endFrame();
+    // Drop the open frame (packet was filtered out)
+    static void abortFrame();
+    static bool frameOpen();
+
+    static void dumpPercentiles();
+    static void reset();
+
+private:
+    struct FrameTrace {
+        uint32_t stamp[TRACE_POINT_COUNT];   // 0 = point not reached
+    };
+
+    static FrameTrace _ring[LATENCY_TRACE_RING_SIZE];
+    static FrameTrace _current;
+    static bool _open;
+    static uint16_t _head;
+    static uint16_t _count;
+    static uint32_t _scratch[LATENCY_TRACE_RING_SIZE];
+
+    static uint32_t now();
+    static void printStage(const char* name, TracePoint from, TracePoint to);
+};
+
+// Trace macros compile to nothing when tracing is disabled in Config.h
+#if LATENCY_TRACE_ENABLE
+#define TRACE_BEGIN_FRAME() LatencyTrace::beginFrame()
+#define TRACE_MARK(point)   LatencyTrace::mark(point)
+#define TRACE_END_FRAME()   LatencyTrace::endFrame()
+#define TRACE_ABORT_FRAME() LatencyTrace::abortFrame()
+#else
+#define TRACE_BEGIN_FRAME() ((void)0)
+#define TRACE_MARK(point)   ((void)0)
+#define TRACE_END_FRAME()   ((void)0)
+#define TRACE_ABORT_FRAME() ((void)0)
+#endif
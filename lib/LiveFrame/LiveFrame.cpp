@@ -0,0 +1,69 @@
+#include "LiveFrame.h"
+#include "HotPath.h"
+
+uint8_t LiveFrame::_frame[MAX_NUM_LEDS * CHAN_PER_LED] HOT_BUFFER_ATTR = {};
+uint16_t LiveFrame::_frameLen = 0;
+volatile uint32_t LiveFrame::_frameCount = 0;
+uint16_t LiveFrame::_packetRate[PREVIEW_HISTORY_LEN] = {};
+uint16_t LiveFrame::_radioFps[PREVIEW_HISTORY_LEN] = {};
+uint8_t LiveFrame::_historyHead = 0;
+uint32_t LiveFrame::_bucketSecond = 0;
+uint32_t LiveFrame::_bucketPackets = 0;
+uint32_t LiveFrame::_bucketFrames = 0;
+
+static portMUX_TYPE liveFrameMux = portMUX_INITIALIZER_UNLOCKED;
+
+void HOT_PATH_ATTR LiveFrame::publish(const uint8_t* data, uint16_t len) {
+    if (len > sizeof(_frame)) len = sizeof(_frame);
+
+    portENTER_CRITICAL(&liveFrameMux);
+    memcpy(_frame, data, len);
+    _frameLen = len;
+    _frameCount++;
+    portEXIT_CRITICAL(&liveFrameMux);
+}
+
+void LiveFrame::tick(uint32_t rxPackets) {
+    uint32_t second = millis() / 1000;
+    if (second == _bucketSecond) return;
+
+    uint32_t frames = _frameCount;
+    uint16_t packetRate = (uint16_t)min<uint32_t>(rxPackets - _bucketPackets, UINT16_MAX);
+    uint16_t radioFps = (uint16_t)min<uint32_t>(frames - _bucketFrames, UINT16_MAX);
+
+    portENTER_CRITICAL(&liveFrameMux);
+    // Attribute the counts to the bucket that just closed; skipped seconds read as zero
+    uint32_t elapsed = min<uint32_t>(second - _bucketSecond, PREVIEW_HISTORY_LEN);
+    for (uint32_t i = 0; i < elapsed; i++) {
+        bool last = (i == elapsed - 1);
+        _packetRate[_historyHead] = last ? packetRate : 0;
+        _radioFps[_historyHead] = last ? radioFps : 0;
+        _historyHead = (_historyHead + 1) % PREVIEW_HISTORY_LEN;
+    }
+    portEXIT_CRITICAL(&liveFrameMux);
+
+    _bucketSecond = second;
+    _bucketPackets = rxPackets;
+    _bucketFrames = frames;
+}
+
+uint16_t LiveFrame::snapshot(uint8_t* dst, uint16_t maxLen) {
+    portENTER_CRITICAL(&liveFrameMux);
+    uint16_t len = min(_frameLen, maxLen);
+    memcpy(dst, _frame, len);
+    portEXIT_CRITICAL(&liveFrameMux);
+    return len;
+}
+
+void LiveFrame::history(uint16_t* packetRate, uint16_t* radioFps, uint8_t count) {
+    if (count > PREVIEW_HISTORY_LEN) count = PREVIEW_HISTORY_LEN;
+
+    portENTER_CRITICAL(&liveFrameMux);
+    uint8_t start = (_historyHead + PREVIEW_HISTORY_LEN - count) % PREVIEW_HISTORY_LEN;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t idx = (start + i) % PREVIEW_HISTORY_LEN;
+        packetRate[i] = _packetRate[idx];
+        radioFps[i] = _radioFps[idx];
+    }
+    portEXIT_CRITICAL(&liveFrameMux);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+/*
+ * Latest outgoing frame and per-second traffic history, shared from the
+ * network task to the display.
+ *
+ * The network task publishes every frame it sends to the radio and calls
+ * tick() once per loop iteration. Readers get a consistent copy of the frame
+ * and of the rate history; both are copied under a spinlock held only for
+ * the memcpy.
+ */
+class LiveFrame {
+public:
+    // Network task: frame just handed to the radio
+    static void publish(const uint8_t* data, uint16_t len);
+    // Network task: close per-second buckets. rxPackets is the running count
+    // of datagrams received on the socket.
+    static void tick(uint32_t rxPackets);
+
+    // Copy the latest frame; returns its length
+    static uint16_t snapshot(uint8_t* dst, uint16_t maxLen);
+    // Copy the last `count` one-second samples, oldest first. Seconds the
+    // network task missed are filled with zeros on its next tick().
+    static void history(uint16_t* packetRate, uint16_t* radioFps, uint8_t count);
+
+    static uint32_t getFrameCount() { return _frameCount; }
+
+private:
+    alignas(HOT_BUFFER_ALIGN) static uint8_t _frame[MAX_NUM_LEDS * CHAN_PER_LED];
+    static uint16_t _frameLen;
+    static volatile uint32_t _frameCount;
+
+    static uint16_t _packetRate[PREVIEW_HISTORY_LEN];
+    static uint16_t _radioFps[PREVIEW_HISTORY_LEN];
+    static uint8_t _historyHead;
+    static uint32_t _bucketSecond;
+    static uint32_t _bucketPackets;
+    static uint32_t _bucketFrames;
+};
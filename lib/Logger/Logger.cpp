@@ -44,15 +44,18 @@ void Logger::log(LogLevel level, const char* tag, const char* format, ...) {
     const char* color = getLevelColor(level);
     const char* levelStr = getLevelString(level);
     
-    // Format and print the log message
+    // Format and print the log message. Print::printf() mallocs for lines
+    // longer than 64 bytes, so the line is built on the stack instead.
+    char line[LOG_LINE_SIZE];
 #if LOG_ENABLE_TIMESTAMPS
     unsigned long timestamp = millis();
-    Serial.printf("%s[%8lu] [%-5s] [%-*s] %s%s\r\n", 
-                  color, timestamp, levelStr, LOG_MAX_TAG_LENGTH, tag, buffer, ANSI_COLOR_RESET);
+    int len = snprintf(line, sizeof(line), "%s[%8lu] [%-5s] [%-*s] %s%s\r\n", 
+                       color, timestamp, levelStr, LOG_MAX_TAG_LENGTH, tag, buffer, ANSI_COLOR_RESET);
 #else
-    Serial.printf("%s[%-5s] [%-*s] %s%s\r\n", 
-                  color, levelStr, LOG_MAX_TAG_LENGTH, tag, buffer, ANSI_COLOR_RESET);
+    int len = snprintf(line, sizeof(line), "%s[%-5s] [%-*s] %s%s\r\n", 
+                       color, levelStr, LOG_MAX_TAG_LENGTH, tag, buffer, ANSI_COLOR_RESET);
 #endif
+    writeLine(line, len);
     
     // Update statistics
     updateStats(level);
@@ -105,16 +108,18 @@ void Logger::logWithLocation(LogLevel level, const char* tag, const char* file,
     const char* levelStr = getLevelString(level);
     
     // Format and print with location
+    char text[LOG_LINE_SIZE];
 #if LOG_ENABLE_TIMESTAMPS
     unsigned long timestamp = millis();
-    Serial.printf("%s[%8lu] [%-5s] [%-*s] %s (%s:%d)%s\r\n", 
-                  color, timestamp, levelStr, LOG_MAX_TAG_LENGTH, tag, 
-                  buffer, filename, line, ANSI_COLOR_RESET);
+    int len = snprintf(text, sizeof(text), "%s[%8lu] [%-5s] [%-*s] %s (%s:%d)%s\r\n", 
+                       color, timestamp, levelStr, LOG_MAX_TAG_LENGTH, tag, 
+                       buffer, filename, line, ANSI_COLOR_RESET);
 #else
-    Serial.printf("%s[%-5s] [%-*s] %s (%s:%d)%s\r\n", 
-                  color, levelStr, LOG_MAX_TAG_LENGTH, tag, 
-                  buffer, filename, line, ANSI_COLOR_RESET);
+    int len = snprintf(text, sizeof(text), "%s[%-5s] [%-*s] %s (%s:%d)%s\r\n", 
+                       color, levelStr, LOG_MAX_TAG_LENGTH, tag, 
+                       buffer, filename, line, ANSI_COLOR_RESET);
 #endif
+    writeLine(text, len);
     
     // Update statistics
     updateStats(level);
@@ -152,11 +157,11 @@ LogLevel Logger::getModuleLevel(const char* module) {
 
 void Logger::printStats() {
     Serial.println(F("\r\n=== LOGGER STATISTICS ==="));
-    Serial.printf("ERROR   : %lu\r\n", _stats.errorCount);
-    Serial.printf("WARN    : %lu\r\n", _stats.warnCount);
-    Serial.printf("INFO    : %lu\r\n", _stats.infoCount);
-    Serial.printf("DEBUG   : %lu\r\n", _stats.debugCount);
-    Serial.printf("VERBOSE : %lu\r\n", _stats.verboseCount);
+    Serial.printf("ERROR   : %lu\r\n", (unsigned long)_stats.errorCount);
+    Serial.printf("WARN    : %lu\r\n", (unsigned long)_stats.warnCount);
+    Serial.printf("INFO    : %lu\r\n", (unsigned long)_stats.infoCount);
+    Serial.printf("DEBUG   : %lu\r\n", (unsigned long)_stats.debugCount);
+    Serial.printf("VERBOSE : %lu\r\n", (unsigned long)_stats.verboseCount);
     Serial.printf("Last ERROR: %lu ms\r\n", _stats.lastErrorTime);
     Serial.printf("Last WARN : %lu ms\r\n", _stats.lastWarnTime);
     Serial.printf("Uptime    : %lu ms\r\n", millis());
@@ -306,6 +311,17 @@ void Logger::addToErrorBuffer(const char* tag, const char* message) {
     _errorBufferIndex = (_errorBufferIndex + 1) % LOG_ERROR_BUFFER_SIZE;
 }
 
+void Logger::writeLine(char* line, int len) {
+    if (len < 0) return;
+    if (len >= LOG_LINE_SIZE) {
+        // Truncated: keep the line ending
+        len = LOG_LINE_SIZE - 1;
+        line[len - 2] = '\r';
+        line[len - 1] = '\n';
+    }
+    Serial.write((const uint8_t*)line, len);
+}
+
 void Logger::updateStats(LogLevel level) {
     switch (level) {
         case LOG_LEVEL_ERROR:
@@ -96,6 +96,11 @@ enum LogLevel {
 #define LOG_BUFFER_SIZE 256
 #endif
 
+// Formatted line: message plus color codes, timestamp, level, tag and location
+#ifndef LOG_LINE_SIZE
+#define LOG_LINE_SIZE (LOG_BUFFER_SIZE + 96)
+#endif
+
 #ifndef LOG_ENABLE_TIMESTAMPS
 #define LOG_ENABLE_TIMESTAMPS true
 #endif
@@ -171,6 +176,7 @@ private:
     static const char* getLevelColor(LogLevel level);
     static void addToErrorBuffer(const char* tag, const char* message);
     static void updateStats(LogLevel level);
+    static void writeLine(char* line, int len);
 };
 
 // ============================================================================
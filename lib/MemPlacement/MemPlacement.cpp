@@ -0,0 +1,66 @@
+#include "MemPlacement.h"
+#include <esp_heap_caps.h>
+#include "Logger.h"
+
+MemPlacement::Block MemPlacement::_blocks[MEM_PLACEMENT_MAX_BLOCKS] = {};
+uint8_t MemPlacement::_blockCount = 0;
+
+bool MemPlacement::hasPsram() {
+    return heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0;
+}
+
+void* MemPlacement::allocate(const char* name, size_t size, MemClass memClass) {
+    if (_blockCount >= MEM_PLACEMENT_MAX_BLOCKS) {
+        LOG_ERROR_TAG("MEM", "Placement table full, %s not allocated", name);
+        return nullptr;
+    }
+
+    void* ptr = nullptr;
+    bool psram = false;
+    if (memClass == MEM_COLD && hasPsram()) {
+        ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        psram = ptr != nullptr;
+    }
+    if (ptr == nullptr && (memClass == MEM_HOT || size <= MEM_COLD_INTERNAL_MAX)) {
+        ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+
+    if (ptr == nullptr) {
+        LOG_WARN_TAG("MEM", "No room for %s (%u bytes)", name, (unsigned)size);
+        return nullptr;
+    }
+    if (memClass == MEM_COLD && !psram) {
+        LOG_WARN_TAG("MEM", "%s in internal RAM, no PSRAM", name);
+    }
+
+    _blocks[_blockCount++] = {name, (uint8_t*)ptr, size, memClass, psram};
+    LOG_INFO_TAG("MEM", "%s: %u bytes in %s", name, (unsigned)size, psram ? "PSRAM" : "internal RAM");
+    return ptr;
+}
+
+bool MemPlacement::inPsram(const void* ptr) {
+    const uint8_t* p = (const uint8_t*)ptr;
+    for (uint8_t i = 0; i < _blockCount; i++) {
+        const Block& block = _blocks[i];
+        if (p >= block.ptr && p < block.ptr + block.size) return block.psram;
+    }
+    return false;
+}
+
+void MemPlacement::printReport() {
+    Serial.println(F("\r\n=== MEMORY PLACEMENT ==="));
+    Serial.printf("%-16s %9s %5s  %s\r\n", "Block", "Bytes", "Class", "Region");
+    for (uint8_t i = 0; i < _blockCount; i++) {
+        const Block& block = _blocks[i];
+        Serial.printf("%-16s %9u %5s  %s\r\n", block.name, (unsigned)block.size,
+                      block.memClass == MEM_HOT ? "hot" : "cold", block.psram ? "PSRAM" : "internal");
+    }
+    Serial.printf("Internal: %u of %u bytes free\r\n", (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+                  (unsigned)heap_caps_get_total_size(MALLOC_CAP_INTERNAL));
+    if (hasPsram()) {
+        Serial.printf("PSRAM   : %u of %u bytes free\r\n", (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM),
+                      (unsigned)heap_caps_get_total_size(MALLOC_CAP_SPIRAM));
+    } else {
+        Serial.println(F("PSRAM   : not present"));
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+// Where a buffer belongs, by how it is accessed
+enum MemClass : uint8_t {
+    MEM_HOT,    // Touched per packet or per render: internal SRAM
+    MEM_COLD    // Bulk data written once per frame or read rarely: PSRAM
+};
+
+/*
+ * Placement policy for the large buffers allocated at boot.
+ *
+ * Internal SRAM is scarce (about 300 KB) but costs no more than a cache hit;
+ * the board's 8 MB of PSRAM sits behind the data cache on an 80 MHz octal
+ * bus, so a miss costs a cache line fill. Hot buffers therefore stay
+ * internal: static arrays already do, and MEM_HOT blocks are requested with
+ * MALLOC_CAP_INTERNAL so Arduino's malloc() cannot move them to PSRAM (it
+ * does for requests above 4 KB). Cold bulk data goes to PSRAM; without PSRAM
+ * a cold block up to MEM_COLD_INTERNAL_MAX falls back to internal RAM and a
+ * larger one fails, so the caller can shrink it.
+ *
+ * Blocks are never freed. Allocate them at boot, before HeapGuard::arm();
+ * diagnostics (the bench memory cases) place theirs on first use instead.
+ */
+class MemPlacement {
+public:
+    // Returns nullptr if the block does not fit (or the table is full)
+    static void* allocate(const char* name, size_t size, MemClass memClass);
+
+    static bool hasPsram();
+    // Whether `ptr` is inside a block placed in PSRAM
+    static bool inPsram(const void* ptr);
+
+    // Blocks placed so far, plus internal and PSRAM totals
+    static void printReport();
+
+private:
+    struct Block {
+        const char* name;
+        uint8_t* ptr;
+        size_t size;
+        MemClass memClass;
+        bool psram;
+    };
+
+    static Block _blocks[MEM_PLACEMENT_MAX_BLOCKS];
+    static uint8_t _blockCount;
+};
@@ -0,0 +1,300 @@
+#include "PcapFile.h"
+#include <string.h>
+
+#define PCAP_MAGIC_US 0xA1B2C3D4
+#define PCAP_MAGIC_NS 0xA1B23C4D
+#define PCAPNG_SHB 0x0A0D0D0A
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_SPB 0x00000003
+#define PCAPNG_EPB 0x00000006
+#define PCAPNG_OPT_TSRESOL 9
+#define PCAP_MAX_BLOCK (16 * 1024 * 1024)
+
+#define LINKTYPE_NULL 0
+#define LINKTYPE_ETHERNET 1
+#define LINKTYPE_RAW 101
+#define LINKTYPE_LOOP 108
+#define LINKTYPE_LINUX_SLL 113
+#define LINKTYPE_IPV4 228
+#define LINKTYPE_LINUX_SLL2 276
+
+#define ETHERTYPE_IPV4 0x0800
+#define ETHERTYPE_VLAN 0x8100
+#define ETHERTYPE_QINQ 0x88A8
+#define IP_PROTO_UDP 17
+
+static uint16_t be16(const uint8_t* p) { return (uint16_t)((p[0] << 8) | p[1]); }
+static uint32_t be32(const uint8_t* p) { return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]; }
+static uint32_t le32(const uint8_t* p) { return ((uint32_t)p[3] << 24) | ((uint32_t)p[2] << 16) | ((uint32_t)p[1] << 8) | p[0]; }
+
+PcapFile::~PcapFile() {
+    close();
+}
+
+bool PcapFile::open(const char* path) {
+    close();
+    _error = "";
+    _frames = _skipped = 0;
+    _lastTimestampUs = 0;
+
+    _file = fopen(path, "rb");
+    if (!_file) return _fail("cannot open file");
+
+    uint8_t magic[4];
+    if (fread(magic, 1, sizeof(magic), _file) != sizeof(magic)) return _fail("file too short");
+
+    if (be32(magic) == PCAPNG_SHB) {
+        _pcapng = true;
+        return _readSectionHeader();
+    }
+    return _readClassicHeader(magic);
+}
+
+void PcapFile::close() {
+    if (_file) fclose(_file);
+    _file = nullptr;
+    _pcapng = false;
+    _interfaces.clear();
+}
+
+bool PcapFile::next(CapturedDatagram& out) {
+    if (!_file) return false;
+    return _pcapng ? _nextPcapng(out) : _nextClassic(out);
+}
+
+bool PcapFile::_fail(const char* error) {
+    _error = error;
+    if (_file) fclose(_file);
+    _file = nullptr;
+    return false;
+}
+
+uint16_t PcapFile::_u16(const uint8_t* p) const {
+    return _bigEndian ? be16(p) : (uint16_t)((p[1] << 8) | p[0]);
+}
+
+uint32_t PcapFile::_u32(const uint8_t* p) const {
+    return _bigEndian ? be32(p) : le32(p);
+}
+
+// --- Classic pcap ---
+
+bool PcapFile::_readClassicHeader(const uint8_t* magic) {
+    uint64_t ticksPerSecond;
+    if (le32(magic) == PCAP_MAGIC_US || be32(magic) == PCAP_MAGIC_US) {
+        ticksPerSecond = 1000000;
+    } else if (le32(magic) == PCAP_MAGIC_NS || be32(magic) == PCAP_MAGIC_NS) {
+        ticksPerSecond = 1000000000;
+    } else {
+        return _fail("not a pcap or pcapng file");
+    }
+    _bigEndian = be32(magic) == PCAP_MAGIC_US || be32(magic) == PCAP_MAGIC_NS;
+
+    // version, thiszone, sigfigs, snaplen, linktype
+    uint8_t header[20];
+    if (fread(header, 1, sizeof(header), _file) != sizeof(header)) return _fail("truncated pcap header");
+    // The upper bits of the link type field carry FCS information
+    _interfaces.push_back({(uint16_t)(_u32(header + 16) & 0xFFFF), ticksPerSecond});
+    return true;
+}
+
+bool PcapFile::_nextClassic(CapturedDatagram& out) {
+    for (;;) {
+        uint8_t record[16];
+        size_t n = fread(record, 1, sizeof(record), _file);
+        if (n == 0) return false;
+        if (n != sizeof(record)) return _fail("truncated record header");
+
+        uint32_t seconds = _u32(record);
+        uint32_t fraction = _u32(record + 4);
+        uint32_t included = _u32(record + 8);
+        if (included > PCAP_MAX_BLOCK) return _fail("record length out of range");
+
+        _block.resize(included);
+        if (included > 0 && fread(_block.data(), 1, included, _file) != included) {
+            return _fail("truncated record");
+        }
+        _frames++;
+
+        const Interface& iface = _interfaces[0];
+        out.timestampUs = (uint64_t)seconds * 1000000 +
+            (iface.ticksPerSecond == 1000000 ? fraction : fraction / 1000);
+        if (_decodeFrame(iface.linkType, _block.data(), included, out)) return true;
+    }
+}
+
+// --- pcapng ---
+
+bool PcapFile::_readSectionHeader() {
+    // Block type already consumed; read length and byte-order magic
+    uint8_t rest[8];
+    if (fread(rest, 1, sizeof(rest), _file) != sizeof(rest)) return _fail("truncated section header");
+    if (be32(rest + 4) == PCAPNG_BYTE_ORDER_MAGIC) {
+        _bigEndian = true;
+    } else if (le32(rest + 4) == PCAPNG_BYTE_ORDER_MAGIC) {
+        _bigEndian = false;
+    } else {
+        return _fail("bad pcapng byte-order magic");
+    }
+
+    uint32_t length = _u32(rest);
+    if (length < 28 || length % 4 != 0 || length > PCAP_MAX_BLOCK) return _fail("bad section header length");
+    // Version, section length, options and the trailing length are not needed
+    _block.resize(length - 12);
+    if (fread(_block.data(), 1, _block.size(), _file) != _block.size()) return _fail("truncated section header");
+
+    // Interface ids are per section
+    _interfaces.clear();
+    return true;
+}
+
+void PcapFile::_addInterface(const uint8_t* body, size_t length) {
+    Interface iface = {_u16(body), 1000000};
+
+    // Options follow linktype, reserved and snaplen
+    size_t offset = 8;
+    while (offset + 4 <= length) {
+        uint16_t code = _u16(body + offset);
+        uint16_t optionLength = _u16(body + offset + 2);
+        offset += 4;
+        if (code == 0 || offset + optionLength > length) break;
+        if (code == PCAPNG_OPT_TSRESOL && optionLength >= 1) {
+            uint8_t resolution = body[offset];
+            uint8_t exponent = resolution & 0x7F;
+            uint64_t base = (resolution & 0x80) ? 2 : 10;
+            iface.ticksPerSecond = 1;
+            for (uint8_t i = 0; i < exponent && iface.ticksPerSecond < 1000000000000000000ULL; i++) {
+                iface.ticksPerSecond *= base;
+            }
+        }
+        offset += (optionLength + 3) & ~3u;
+    }
+    _interfaces.push_back(iface);
+}
+
+bool PcapFile::_nextPcapng(CapturedDatagram& out) {
+    for (;;) {
+        uint8_t head[8];
+        size_t n = fread(head, 1, sizeof(head), _file);
+        if (n == 0) return false;
+        if (n != sizeof(head)) return _fail("truncated block header");
+
+        if (be32(head) == PCAPNG_SHB) {
+            if (fseek(_file, -4, SEEK_CUR) != 0) return _fail("seek failed");
+            if (!_readSectionHeader()) return false;
+            continue;
+        }
+
+        uint32_t type = _u32(head);
+        uint32_t length = _u32(head + 4);
+        if (length < 12 || length % 4 != 0 || length > PCAP_MAX_BLOCK) return _fail("bad block length");
+
+        // Body plus the trailing copy of the length
+        size_t bodyLength = length - 12;
+        _block.resize(bodyLength + 4);
+        if (fread(_block.data(), 1, _block.size(), _file) != _block.size()) return _fail("truncated block");
+        const uint8_t* body = _block.data();
+
+        if (type == PCAPNG_IDB) {
+            if (bodyLength < 8) return _fail("bad interface block");
+            _addInterface(body, bodyLength);
+        } else if (type == PCAPNG_EPB) {
+            if (bodyLength < 20) return _fail("bad packet block");
+            uint32_t interfaceId = _u32(body);
+            uint32_t included = _u32(body + 12);
+            if (interfaceId >= _interfaces.size()) return _fail("packet on undeclared interface");
+            if (included > bodyLength - 20) return _fail("packet longer than its block");
+            _frames++;
+
+            const Interface& iface = _interfaces[interfaceId];
+            uint64_t ticks = ((uint64_t)_u32(body + 4) << 32) | _u32(body + 8);
+            out.timestampUs = ticks / iface.ticksPerSecond * 1000000 +
+                (ticks % iface.ticksPerSecond) * 1000000 / iface.ticksPerSecond;
+            _lastTimestampUs = out.timestampUs;
+            if (_decodeFrame(iface.linkType, body + 20, included, out)) return true;
+        } else if (type == PCAPNG_SPB) {
+            if (bodyLength < 4) return _fail("bad packet block");
+            if (_interfaces.empty()) return _fail("packet on undeclared interface");
+            uint32_t original = _u32(body);
+            uint32_t included = original < bodyLength - 4 ? original : bodyLength - 4;
+            _frames++;
+
+            out.timestampUs = _lastTimestampUs;
+            if (_decodeFrame(_interfaces[0].linkType, body + 4, included, out)) return true;
+        }
+        // Statistics, name resolution, custom blocks: nothing to replay
+    }
+}
+
+// --- Link, IPv4 and UDP layers ---
+
+bool PcapFile::_decodeFrame(uint16_t linkType, const uint8_t* data, size_t length,
+                            CapturedDatagram& out) {
+    size_t offset;
+    uint16_t protocol = ETHERTYPE_IPV4;
+
+    switch (linkType) {
+        case LINKTYPE_ETHERNET:
+            offset = 14;
+            if (length < offset) break;
+            protocol = be16(data + 12);
+            while ((protocol == ETHERTYPE_VLAN || protocol == ETHERTYPE_QINQ) && length >= offset + 4) {
+                protocol = be16(data + offset + 2);
+                offset += 4;
+            }
+            break;
+        case LINKTYPE_LINUX_SLL:
+            offset = 16;
+            if (length >= offset) protocol = be16(data + 14);
+            break;
+        case LINKTYPE_LINUX_SLL2:
+            offset = 20;
+            if (length >= offset) protocol = be16(data);
+            break;
+        case LINKTYPE_NULL:
+        case LINKTYPE_LOOP:
+            // Address family in the capturing host's byte order
+            offset = 4;
+            if (length >= offset && le32(data) != 2 && be32(data) != 2) protocol = 0;
+            break;
+        case LINKTYPE_RAW:
+        case LINKTYPE_IPV4:
+            offset = 0;
+            break;
+        default:
+            _skipped++;
+            return false;
+    }
+
+    if (length < offset + 20 || protocol != ETHERTYPE_IPV4) {
+        _skipped++;
+        return false;
+    }
+    const uint8_t* ip = data + offset;
+    size_t ipAvailable = length - offset;
+
+    size_t ipHeader = (ip[0] & 0x0F) * 4;
+    size_t ipLength = be16(ip + 2);
+    bool laterFragment = (be16(ip + 6) & 0x1FFF) != 0;
+    if ((ip[0] >> 4) != 4 || ipHeader < 20 || ip[9] != IP_PROTO_UDP || laterFragment ||
+        ipLength < ipHeader + 8 || ipAvailable < ipHeader + 8) {
+        _skipped++;
+        return false;
+    }
+
+    const uint8_t* udp = ip + ipHeader;
+    size_t udpLength = be16(udp + 4);
+    // Snapped or fragmented: the datagram is not all here
+    if (udpLength < 8 || udpLength > ipLength - ipHeader || ipHeader + udpLength > ipAvailable) {
+        _skipped++;
+        return false;
+    }
+
+    memcpy(&out.srcIp, ip + 12, 4);
+    memcpy(&out.dstIp, ip + 16, 4);
+    out.srcPort = be16(udp);
+    out.dstPort = be16(udp + 2);
+    out.payload.assign(udp + 8, udp + udpLength);
+    return true;
+}
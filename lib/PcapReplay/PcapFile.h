@@ -0,0 +1,68 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+// One IPv4 UDP datagram from a capture
+struct CapturedDatagram {
+    uint64_t timestampUs;       // Capture time, microseconds since the epoch
+    uint32_t srcIp;             // Network byte order
+    uint32_t dstIp;
+    uint16_t srcPort;
+    uint16_t dstPort;
+    std::vector<uint8_t> payload;
+};
+
+/*
+ * Sequential reader for classic pcap (either byte order, micro- or
+ * nanosecond timestamps) and pcapng (section/interface/enhanced/simple
+ * packet blocks; anything else is skipped). Only IPv4 UDP is returned.
+ * Other traffic, truncated captures and non-first fragments are counted
+ * and skipped.
+ *
+ * Link types: Ethernet (with 802.1Q tags), Linux cooked v1/v2, BSD
+ * loopback and raw IP.
+ */
+class PcapFile {
+public:
+    ~PcapFile();
+
+    bool open(const char* path);
+    // Next UDP datagram; false at the end of the file or on a format error
+    bool next(CapturedDatagram& out);
+    void close();
+
+    // Empty unless open() or next() hit a malformed file
+    const char* error() const { return _error; }
+    uint32_t getFrameCount() const { return _frames; }
+    uint32_t getSkippedCount() const { return _skipped; }
+
+private:
+    struct Interface {
+        uint16_t linkType;
+        uint64_t ticksPerSecond;
+    };
+
+    FILE* _file = nullptr;
+    bool _pcapng = false;
+    bool _bigEndian = false;               // Byte order of the current file/section
+    std::vector<Interface> _interfaces;    // Classic pcap: exactly one
+    std::vector<uint8_t> _block;
+    uint64_t _lastTimestampUs = 0;         // Simple packet blocks carry none
+    const char* _error = "";
+    uint32_t _frames = 0;
+    uint32_t _skipped = 0;
+
+    bool _fail(const char* error);
+    uint16_t _u16(const uint8_t* p) const;
+    uint32_t _u32(const uint8_t* p) const;
+
+    bool _readClassicHeader(const uint8_t* magic);
+    bool _nextClassic(CapturedDatagram& out);
+    bool _nextPcapng(CapturedDatagram& out);
+    bool _readSectionHeader();
+    void _addInterface(const uint8_t* body, size_t length);
+
+    // Frame at link layer -> datagram; false if it is not IPv4 UDP
+    bool _decodeFrame(uint16_t linkType, const uint8_t* data, size_t length, CapturedDatagram& out);
+};
@@ -0,0 +1,128 @@
+#include "PcapReplay.h"
+#include <Arduino.h>
+#include <HostShims.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include "ConfigSchema.h"
+#include "E131Handler.h"
+#include "PcapFile.h"
+#include "Pipeline.h"
+#include "RadioLink.h"
+
+const char* PcapReplay::_error = "";
+
+static E131Handler* eth;
+static RadioLink* radio;
+
+static void begin() {
+    if (eth) return;
+
+    static byte mac[] = DEFAULT_MAC;
+    eth = new E131Handler();
+    eth->begin(mac, IPAddress(DEFAULT_IP));
+
+    radio = new RadioLink();
+    radio->begin(DEFAULT_RADIO_CHANNEL);
+    // AT mode traffic is not part of the radio stream
+    HostSerial::takeOutput(HC12_UART_NUM);
+}
+
+static uint64_t elapsedUs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
+bool PcapReplay::run(const ReplayOptions& options, FILE* radioOut, ReplayStats& stats) {
+    memset(&stats, 0, sizeof(stats));
+    _error = "";
+
+    PcapFile capture;
+    if (!capture.open(options.capturePath)) {
+        _error = capture.error();
+        return false;
+    }
+
+    begin();
+    // Nothing from an earlier run may leak into this stream
+    HostSerial::takeOutput(HC12_UART_NUM);
+
+    DeviceConfig config;
+    ConfigSchema::applyDefaults(config);
+    if (options.universe) config.universe = options.universe;
+    if (options.numLeds) config.numLeds = options.numLeds;
+    ConfigSchema::sanitize(config);
+
+    static PipelineConfig pipe;
+    Pipeline::build(config, 1, pipe);
+    eth->setUniverse(pipe.universe);
+
+    static uint8_t dmx[DMX_MAX_CHANNELS];
+    static uint8_t radioBuffer[PIPELINE_MAX_PAYLOAD];
+    uint64_t firstTimestamp = 0;
+    bool first = true;
+    auto start = std::chrono::steady_clock::now();
+
+    CapturedDatagram datagram;
+    while (capture.next(datagram)) {
+        if (datagram.dstPort != options.port) continue;
+
+        if (first) {
+            firstTimestamp = datagram.timestampUs;
+            first = false;
+        }
+        // Captures may be out of order across interfaces; never go backwards
+        uint64_t offset = datagram.timestampUs > firstTimestamp ? datagram.timestampUs - firstTimestamp : 0;
+        if (offset > stats.captureSpanUs) stats.captureSpanUs = offset;
+
+        if (options.realtime && options.speed > 0) {
+            std::this_thread::sleep_until(start + std::chrono::microseconds((uint64_t)(offset / options.speed)));
+        }
+
+        auto packetStart = std::chrono::steady_clock::now();
+        HostNet::inject(options.port, datagram.payload.data(), datagram.payload.size(),
+                        IPAddress(datagram.srcIp), datagram.srcPort);
+        stats.datagrams++;
+
+        // Same stages, in the same order, as networkLoop()
+        int len = eth->parsePacket(dmx);
+        if (len > 0) {
+            uint16_t bytesToSend = Pipeline::process(pipe, dmx, len, radioBuffer);
+            if (radio->sendDmxPacket(radioBuffer, bytesToSend)) stats.radioFrames++;
+            radio->poll();
+        }
+        stats.pipelineUs += elapsedUs(packetStart);
+
+        std::vector<uint8_t> sent = HostSerial::takeOutput(HC12_UART_NUM);
+        stats.radioBytes += sent.size();
+        if (radioOut && !sent.empty()) fwrite(sent.data(), 1, sent.size(), radioOut);
+    }
+
+    stats.elapsedUs = elapsedUs(start);
+    stats.captureFrames = capture.getFrameCount();
+    stats.skippedFrames = capture.getSkippedCount();
+    if (capture.error()[0]) {
+        _error = capture.error();
+        return false;
+    }
+    return true;
+}
+
+void PcapReplay::printStats(const ReplayStats& stats, FILE* out) {
+    double seconds = stats.elapsedUs / 1e6;
+    fprintf(out, "=== Replay ===\n");
+    fprintf(out, "Capture frames:   %lu (%lu skipped)\n",
+            (unsigned long)stats.captureFrames, (unsigned long)stats.skippedFrames);
+    fprintf(out, "sACN datagrams:   %lu\n", (unsigned long)stats.datagrams);
+    fprintf(out, "Radio frames:     %lu (%llu bytes)\n",
+            (unsigned long)stats.radioFrames, (unsigned long long)stats.radioBytes);
+    fprintf(out, "Capture span:     %.3f s\n", stats.captureSpanUs / 1e6);
+    fprintf(out, "Elapsed:          %.3f s\n", seconds);
+    if (stats.datagrams > 0) {
+        fprintf(out, "Pipeline:         %.2f us/datagram\n", (double)stats.pipelineUs / stats.datagrams);
+    }
+    if (seconds > 0) {
+        fprintf(out, "Throughput:       %.0f datagrams/s\n", stats.datagrams / seconds);
+    }
+    fprintf(out, "==============\n");
+}
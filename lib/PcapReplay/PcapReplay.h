@@ -0,0 +1,47 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include "Config.h"
+
+struct ReplayOptions {
+    const char* capturePath = nullptr;
+    uint16_t port = E131_PORT;      // Datagrams to this UDP port are replayed
+    uint16_t universe = 0;          // 0 = the factory default
+    uint16_t numLeds = 0;           // 0 = the factory default
+    bool realtime = false;          // Keep the capture's packet spacing
+    float speed = 1.0f;             // Playback rate when realtime
+};
+
+struct ReplayStats {
+    uint32_t captureFrames;         // Link-layer frames read from the capture
+    uint32_t skippedFrames;         // Not IPv4 UDP, or truncated
+    uint32_t datagrams;             // Delivered to the E1.31 socket
+    uint32_t radioFrames;           // Frames handed to the radio
+    uint64_t radioBytes;
+    uint64_t captureSpanUs;         // First to last replayed datagram
+    uint64_t elapsedUs;             // Wall time of the whole replay
+    uint64_t pipelineUs;            // Wall time inside parse/process/send
+};
+
+/*
+ * Host-only: drives captured sACN traffic through the same stages as the
+ * network task (E131Handler -> Pipeline -> RadioLink), with the fake W5500
+ * and UART from HostShims in place of the hardware. Every byte the radio
+ * would have sent is written to `radioOut`, so a replay can be compared
+ * byte for byte against a golden file.
+ *
+ * The first run() pays for RadioLink::begin() (about a second of AT mode
+ * delays); later runs reuse the handler and the radio.
+ */
+class PcapReplay {
+public:
+    // Returns false with error() set if the capture could not be read. Frames
+    // replayed before a format error are still written and counted.
+    static bool run(const ReplayOptions& options, FILE* radioOut, ReplayStats& stats);
+    static const char* error() { return _error; }
+
+    static void printStats(const ReplayStats& stats, FILE* out);
+
+private:
+    static const char* _error;
+};
@@ -0,0 +1,100 @@
+#include "Pipeline.h"
+#include "HotPath.h"
+#include <atomic>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Three slots: the published one, the one the reader may still hold, and
+// one free to build into
+static PipelineConfig pipelineSlots[3] HOT_BUFFER_ATTR;
+static std::atomic<PipelineConfig*> currentPipeline{nullptr};
+static std::atomic<PipelineConfig*> readerPipeline{nullptr};
+static uint32_t pipelineGeneration = 0;
+// Menu, console and control port can all publish. Created by the first
+// rebuild, which setup() makes before any task starts.
+static StaticSemaphore_t rebuildMutexBuffer;
+static SemaphoreHandle_t rebuildMutex = nullptr;
+
+void Pipeline::build(const DeviceConfig& config, uint32_t generation, PipelineConfig& pipe) {
+    pipe.generation = generation;
+    pipe.universe = config.universe;
+    pipe.numLeds = config.numLeds > MAX_NUM_LEDS ? MAX_NUM_LEDS : config.numLeds;
+    pipe.payloadLength = CHAN_PER_LED * pipe.numLeds;
+    pipe.radioChannel = config.radioChannel;
+
+    // Straight mapping for now: LED n takes slots 3n..3n+2 at full level.
+    // The tables are the hook for patching and output curves.
+    for (uint16_t i = 0; i < PIPELINE_MAX_PAYLOAD; i++) {
+        pipe.gather[i] = i;
+    }
+    for (uint16_t v = 0; v < 256; v++) {
+        pipe.lut[v] = (uint8_t)v;
+    }
+
+    pipe.gatherIdentity = true;
+    for (uint16_t i = 0; i < pipe.payloadLength; i++) {
+        if (pipe.gather[i] != i) { pipe.gatherIdentity = false; break; }
+    }
+    pipe.lutIdentity = true;
+    for (uint16_t v = 0; v < 256; v++) {
+        if (pipe.lut[v] != v) { pipe.lutIdentity = false; break; }
+    }
+}
+
+const PipelineConfig* Pipeline::rebuild(const DeviceConfig& config) {
+    if (rebuildMutex == nullptr) rebuildMutex = xSemaphoreCreateMutexStatic(&rebuildMutexBuffer);
+    xSemaphoreTake(rebuildMutex, portMAX_DELAY);
+
+    // The other half of acquire()'s handshake: the reader stores its hazard
+    // then reloads currentPipeline, we stored currentPipeline (last rebuild)
+    // then load the hazard. Only seq_cst orders a store before a later load,
+    // so either the reader saw the new snapshot or we see its hazard here.
+    PipelineConfig* current = currentPipeline.load(std::memory_order_acquire);
+    PipelineConfig* held = readerPipeline.load(std::memory_order_seq_cst);
+
+    PipelineConfig* spare = nullptr;
+    for (PipelineConfig& slot : pipelineSlots) {
+        if (&slot != current && &slot != held) { spare = &slot; break; }
+    }
+
+    build(config, ++pipelineGeneration, *spare);
+    currentPipeline.store(spare, std::memory_order_seq_cst);
+    xSemaphoreGive(rebuildMutex);
+    return spare;
+}
+
+const PipelineConfig* HOT_PATH_ATTR Pipeline::acquire() {
+    // Publish the hazard, then confirm the snapshot wasn't swapped meanwhile
+    PipelineConfig* pipe;
+    do {
+        pipe = currentPipeline.load(std::memory_order_acquire);
+        readerPipeline.store(pipe, std::memory_order_seq_cst);
+    } while (pipe != currentPipeline.load(std::memory_order_seq_cst));
+    return pipe;
+}
+
+void HOT_PATH_ATTR Pipeline::release() {
+    readerPipeline.store(nullptr, std::memory_order_release);
+}
+
+uint16_t HOT_PATH_ATTR Pipeline::process(const PipelineConfig& pipe, const uint8_t* dmx, uint16_t dmxLen, uint8_t* out) {
+    uint16_t len = pipe.payloadLength;
+
+    if (pipe.gatherIdentity) {
+        if (len > dmxLen) len = dmxLen;
+        if (pipe.lutIdentity) {
+            memcpy(out, dmx, len);
+        } else {
+            for (uint16_t i = 0; i < len; i++) out[i] = pipe.lut[dmx[i]];
+        }
+        return len;
+    }
+
+    for (uint16_t i = 0; i < len; i++) {
+        uint16_t slot = pipe.gather[i];
+        if (slot >= dmxLen) return i;
+        out[i] = pipe.lut[dmx[slot]];
+    }
+    return len;
+}
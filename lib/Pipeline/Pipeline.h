@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "Config.h"
+#include "ConfigData.h"
+
+#define PIPELINE_MAX_PAYLOAD (MAX_NUM_LEDS * CHAN_PER_LED)
+
+// Everything the per-packet path needs, derived once from DeviceConfig and
+// validated when built. Instances are immutable once published.
+struct PipelineConfig {
+    uint32_t generation;                     // Bumped on every rebuild
+    uint16_t universe;                       // Universe to accept
+    uint16_t numLeds;
+    uint16_t payloadLength;                  // Bytes sent to the radio per frame
+    uint8_t radioChannel;
+    bool gatherIdentity;                     // gather[i] == i: plain copy
+    bool lutIdentity;                        // lut[v] == v: skip the lookup
+    uint16_t gather[PIPELINE_MAX_PAYLOAD];   // DMX slot feeding each output byte
+    uint8_t lut[256];                        // Output level curve
+};
+
+/*
+ * Publishes PipelineConfig snapshots to the network task.
+ *
+ * rebuild() (any task, off the hot path; concurrent rebuilds are serialized)
+ * fills a spare slot and swaps it in with one atomic pointer store. The network task brackets each loop
+ * iteration with acquire()/release(); the slot it holds is never reused by
+ * a rebuild, so a snapshot cannot change under it. Single reader only.
+ */
+class Pipeline {
+public:
+    static const PipelineConfig* rebuild(const DeviceConfig& config);
+
+    // Network task
+    static const PipelineConfig* acquire();
+    static void release();
+
+    // Gather + LUT one frame. Returns bytes written to out (at most
+    // payloadLength, fewer if the DMX frame is shorter than the gather needs).
+    static uint16_t process(const PipelineConfig& pipe, const uint8_t* dmx, uint16_t dmxLen, uint8_t* out);
+
+    // Fill `pipe` from `config` without publishing it (tools and tests)
+    static void build(const DeviceConfig& config, uint32_t generation, PipelineConfig& pipe);
+};
@@ -0,0 +1,112 @@
+#include "ProfileStore.h"
+#include "Logger.h"
+
+ConfigManager* ProfileStore::_store = nullptr;
+ConfigService* ProfileStore::_service = nullptr;
+ProfileStore::Profile ProfileStore::_profiles[PROFILE_COUNT] = {};
+volatile int8_t ProfileStore::_active = -1;
+volatile uint32_t ProfileStore::_generation = 0;
+portMUX_TYPE ProfileStore::_mux = portMUX_INITIALIZER_UNLOCKED;
+
+void ProfileStore::begin(ConfigManager& store, ConfigService& service) {
+    _store = &store;
+    _service = &service;
+
+    int loaded = 0;
+    for (uint8_t slot = 0; slot < PROFILE_COUNT; slot++) {
+        Profile& profile = _profiles[slot];
+        profile.used = store.loadProfile(slot, profile.name, sizeof(profile.name), profile.config);
+        if (profile.used) loaded++;
+    }
+    LOG_INFO_TAG("PROFILE", "%d of %d profile slots in use", loaded, PROFILE_COUNT);
+}
+
+bool ProfileStore::isUsed(uint8_t slot) {
+    return slot < PROFILE_COUNT && _profiles[slot].used;
+}
+
+bool ProfileStore::getName(uint8_t slot, char* name, size_t size) {
+    if (slot >= PROFILE_COUNT) return false;
+    portENTER_CRITICAL(&_mux);
+    bool used = _profiles[slot].used;
+    if (used) strlcpy(name, _profiles[slot].name, size);
+    portEXIT_CRITICAL(&_mux);
+    return used;
+}
+
+bool ProfileStore::activate(uint8_t slot) {
+    if (_service == nullptr) return false;
+
+    ConfigService::EditGuard edit(*_service);
+    DeviceConfig config = _service->get();
+    if (!applyTo(slot, config)) return false;
+    _service->stage(config);
+    _service->publish();
+    return true;
+}
+
+bool ProfileStore::applyTo(uint8_t slot, DeviceConfig& config) {
+    if (slot >= PROFILE_COUNT) return false;
+
+    portENTER_CRITICAL(&_mux);
+    Profile profile = _profiles[slot];
+    portEXIT_CRITICAL(&_mux);
+
+    if (!profile.used) {
+        LOG_WARN_TAG("PROFILE", "Profile %d is empty", slot + 1);
+        return false;
+    }
+
+    config.universe = profile.config.universe;
+    config.numLeds = profile.config.numLeds;
+    config.radioChannel = profile.config.radioChannel;
+    _active = slot;
+    LOG_INFO_TAG("PROFILE", "Switching to profile %d (%s)", slot + 1, profile.name);
+    return true;
+}
+
+bool ProfileStore::save(uint8_t slot, const char* name, const DeviceConfig& config) {
+    if (slot >= PROFILE_COUNT || _store == nullptr) return false;
+
+    Profile profile;
+    profile.used = true;
+    strlcpy(profile.name, name, sizeof(profile.name));
+    profile.config = config;
+    if (!_store->saveProfile(slot, profile.name, profile.config)) return false;
+
+    portENTER_CRITICAL(&_mux);
+    _profiles[slot] = profile;
+    _generation++;
+    portEXIT_CRITICAL(&_mux);
+    return true;
+}
+
+bool ProfileStore::erase(uint8_t slot) {
+    if (slot >= PROFILE_COUNT || _store == nullptr) return false;
+    if (!_store->eraseProfile(slot)) return false;
+
+    portENTER_CRITICAL(&_mux);
+    _profiles[slot].used = false;
+    _generation++;
+    portEXIT_CRITICAL(&_mux);
+    if (_active == slot) _active = -1;
+    return true;
+}
+
+void ProfileStore::printList() {
+    Serial.println(F("\r\n=== PROFILES ==="));
+    Serial.println(F("Slot Name         Universe LEDs Chan"));
+    for (uint8_t slot = 0; slot < PROFILE_COUNT; slot++) {
+        portENTER_CRITICAL(&_mux);
+        Profile profile = _profiles[slot];
+        portEXIT_CRITICAL(&_mux);
+
+        if (!profile.used) {
+            Serial.printf("%c%-3d (empty)\r\n", slot == _active ? '*' : ' ', slot + 1);
+            continue;
+        }
+        Serial.printf("%c%-3d %-12s %8u %4u %4u\r\n", slot == _active ? '*' : ' ', slot + 1, profile.name,
+                      profile.config.universe, profile.config.numLeds, profile.config.radioChannel);
+    }
+    Serial.println(F("================\r\n"));
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+#include "ConfigData.h"
+#include "ConfigManager.h"
+#include "ConfigService.h"
+
+/*
+ * Named show profiles (venue setups).
+ *
+ * All slots are read from NVS once at boot and cached, so switching never
+ * touches flash. A profile carries the show settings - universe, LED count
+ * and radio channel; the device's own network settings stay as they are.
+ * activate() publishes through ConfigService, which rebuilds the pipeline
+ * snapshot; the network task adopts it at its next frame boundary.
+ *
+ * Slots are 0-based here and shown 1-based to users.
+ */
+class ProfileStore {
+public:
+    static void begin(ConfigManager& store, ConfigService& service);
+
+    static bool isUsed(uint8_t slot);
+    // Copies the slot name; false for an empty slot
+    static bool getName(uint8_t slot, char* name, size_t size);
+    // Last profile activated since boot, -1 if none
+    static int8_t getActive() { return _active; }
+    // Changes whenever a slot is saved or erased, so a list can tell it's stale
+    static uint32_t getGeneration() { return _generation; }
+
+    // Switch to a stored profile (any task)
+    static bool activate(uint8_t slot);
+    // Overlay a profile's show settings on `config` and mark it active; the
+    // caller publishes (used by the menu, which edits a staged copy)
+    static bool applyTo(uint8_t slot, DeviceConfig& config);
+    // Store the current show settings under `name` (writes flash)
+    static bool save(uint8_t slot, const char* name, const DeviceConfig& config);
+    static bool erase(uint8_t slot);
+
+    static void printList();
+
+private:
+    struct Profile {
+        bool used;
+        char name[PROFILE_NAME_LENGTH];
+        DeviceConfig config;
+    };
+
+    static ConfigManager* _store;
+    static ConfigService* _service;
+    static Profile _profiles[PROFILE_COUNT];
+    static volatile int8_t _active;
+    static volatile uint32_t _generation;
+    static portMUX_TYPE _mux;
+};
@@ -0,0 +1,152 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * HC-12 frame format shared by the transmitter and the receivers:
+ *
+ *   [RADIO_FRAME_START] [length] [data x length] [checksum]
+ *
+ * The checksum is RADIO_FRAME_START XORed with every data byte; the length
+ * byte is not covered.
+ *
+ * This header is the definition of the format. It is header-only, never
+ * allocates and depends on nothing but the C library, so receiver firmware
+ * can include it as-is rather than re-implementing the framing. Buffers are
+ * sized by a payload capacity template parameter, letting a receiver that
+ * only drives a few LEDs keep a small decoder.
+ */
+#define RADIO_FRAME_START 0xAA
+#define RADIO_FRAME_OVERHEAD 3
+#define RADIO_FRAME_MAX_PAYLOAD 255     // Length is a single byte
+
+enum RadioFrameResult {
+    RADIO_FRAME_NONE,                   // Frame still incomplete (or no frame yet)
+    RADIO_FRAME_OK,
+    RADIO_FRAME_BAD_CHECKSUM,
+    RADIO_FRAME_TOO_LONG                // Valid length, but beyond the decoder's capacity
+};
+
+class RadioFrame {
+public:
+    static uint8_t checksum(const uint8_t* data, uint16_t length) {
+        uint8_t sum = RADIO_FRAME_START;
+        for (uint16_t i = 0; i < length; i++) {
+            sum ^= data[i];
+        }
+        return sum;
+    }
+
+    // Frame `length` data bytes into `out`. Returns the frame size, or 0 if
+    // the payload exceeds RADIO_FRAME_MAX_PAYLOAD or `out` is too small.
+    static size_t encode(const uint8_t* data, uint16_t length, uint8_t* out, size_t outSize) {
+        if (length > RADIO_FRAME_MAX_PAYLOAD) return 0;
+        size_t frameSize = (size_t)length + RADIO_FRAME_OVERHEAD;
+        if (frameSize > outSize) return 0;
+
+        out[0] = RADIO_FRAME_START;
+        out[1] = (uint8_t)length;
+        if (length > 0) memcpy(out + 2, data, length);
+        out[frameSize - 1] = checksum(data, length);
+        return frameSize;
+    }
+
+    // Validate one complete frame and copy its payload to `data`. Returns the
+    // payload length, or -1 if the frame is malformed, truncated, has
+    // trailing bytes, fails the checksum, or does not fit in `dataSize`.
+    static int decode(const uint8_t* frame, size_t frameSize, uint8_t* data, size_t dataSize) {
+        if (frameSize < RADIO_FRAME_OVERHEAD) return -1;
+        if (frame[0] != RADIO_FRAME_START) return -1;
+
+        uint8_t length = frame[1];
+        if ((size_t)length + RADIO_FRAME_OVERHEAD != frameSize) return -1;
+        if (length > dataSize) return -1;
+        if (checksum(frame + 2, length) != frame[frameSize - 1]) return -1;
+
+        if (length > 0) memcpy(data, frame + 2, length);
+        return length;
+    }
+};
+
+/*
+ * Transmit-side frame buffer holding one encoded frame of up to `Capacity`
+ * payload bytes.
+ */
+template <size_t Capacity = RADIO_FRAME_MAX_PAYLOAD>
+class RadioFrameEncoder {
+    static_assert(Capacity <= RADIO_FRAME_MAX_PAYLOAD, "payload capacity exceeds the length byte");
+
+public:
+    // Returns the frame size, or 0 (and no frame) if `length` exceeds Capacity
+    size_t encode(const uint8_t* data, uint16_t length) {
+        _size = RadioFrame::encode(data, length, _bytes, sizeof(_bytes));
+        return _size;
+    }
+
+    const uint8_t* data() const { return _bytes; }
+    size_t size() const { return _size; }
+
+private:
+    uint8_t _bytes[Capacity + RADIO_FRAME_OVERHEAD];
+    size_t _size = 0;
+};
+
+/*
+ * Byte-at-a-time frame parser, as a receiver runs it on its UART stream.
+ * Bytes before a start byte are skipped; a frame that fails its checksum is
+ * dropped and the parser goes back to hunting for a start byte. A frame
+ * longer than `Capacity` is skipped whole, so its data cannot be mistaken
+ * for a start byte.
+ */
+template <size_t Capacity = RADIO_FRAME_MAX_PAYLOAD>
+class RadioFrameDecoder {
+    static_assert(Capacity > 0 && Capacity <= RADIO_FRAME_MAX_PAYLOAD, "payload capacity out of range");
+
+public:
+    RadioFrameResult feed(uint8_t byte) {
+        switch (_state) {
+            case WAIT_START:
+                if (byte == RADIO_FRAME_START) _state = WAIT_LENGTH;
+                return RADIO_FRAME_NONE;
+            case WAIT_LENGTH:
+                _length = byte;
+                _received = 0;
+                _checksum = RADIO_FRAME_START;
+                if (_length > Capacity) _state = SKIP;
+                else _state = _length > 0 ? DATA : WAIT_CHECKSUM;
+                return RADIO_FRAME_NONE;
+            case DATA:
+                _payload[_received++] = byte;
+                _checksum ^= byte;
+                if (_received == _length) _state = WAIT_CHECKSUM;
+                return RADIO_FRAME_NONE;
+            case SKIP:
+                // Data bytes, then the checksum
+                if (_received++ < _length) return RADIO_FRAME_NONE;
+                _state = WAIT_START;
+                return RADIO_FRAME_TOO_LONG;
+            case WAIT_CHECKSUM:
+            default:
+                _state = WAIT_START;
+                return byte == _checksum ? RADIO_FRAME_OK : RADIO_FRAME_BAD_CHECKSUM;
+        }
+    }
+
+    // Drop a partial frame and hunt for the next start byte
+    void reset() { _state = WAIT_START; }
+    bool inFrame() const { return _state != WAIT_START; }
+
+    // Valid after feed() returned RADIO_FRAME_OK, until the next feed()
+    const uint8_t* payload() const { return _payload; }
+    uint8_t length() const { return _length; }
+
+private:
+    enum State { WAIT_START, WAIT_LENGTH, DATA, WAIT_CHECKSUM, SKIP };
+
+    State _state = WAIT_START;
+    uint8_t _length = 0;
+    uint8_t _received = 0;
+    uint8_t _checksum = 0;
+    uint8_t _payload[Capacity];
+};
@@ -1,7 +1,10 @@
 #include "RadioLink.h"
 #include "Logger.h"
+#include "LatencyTrace.h"
+#include "HotPath.h"
+#include <driver/uart.h>
 
-void RadioLink::begin() {
+void RadioLink::begin(uint8_t channel) {
     LOG_INFO_TAG("RADIO", "Initializing HC-12 radio...");
     pinMode(HC12_SET, OUTPUT);
     
@@ -10,7 +13,7 @@ void RadioLink::begin() {
     delay(500);
     LOG_DEBUG_TAG("RADIO", "Entered AT command mode");
 
-    // Initialize Serial2
+    // Initialize Serial2 (UART HC12_UART_NUM)
     // RX=18, TX=17
     _serial = &Serial2;
     _serial->begin(HC12_BAUD, SERIAL_8N1, HC12_RX, HC12_TX);
@@ -21,41 +24,162 @@ void RadioLink::begin() {
     
     // Check for response
     if (_serial->available()) {
-        String response = "";
-        while(_serial->available()) {
-            response += (char)_serial->read();
+        char response[32];
+        size_t len = 0;
+        while (_serial->available()) {
+            char c = (char)_serial->read();
+            if (len < sizeof(response) - 1) response[len++] = c;
         }
-        LOG_DEBUG_TAG("RADIO", "HC-12 response: %s", response.c_str());
+        response[len] = '\0';
+        LOG_DEBUG_TAG("RADIO", "HC-12 response: %s", response);
     } else {
         LOG_WARN_TAG("RADIO", "No response from HC-12 module");
     }
 
+    _requestedChannel = channel;
+    _sendChannel(channel);
+
     // Exit Setup Mode
     digitalWrite(HC12_SET, HIGH);
     delay(100);
     LOG_INFO_TAG("RADIO", "HC-12 initialized, exited AT mode");
 }
 
-void RadioLink::sendDmxPacket(uint8_t* dmxData, uint16_t length) {
-    // Protocol: [0xAA] [Length] [Data...] [Checksum]
-    
-    if (length > 255) {
+bool HOT_PATH_ATTR RadioLink::sendDmxPacket(uint8_t* dmxData, uint16_t length) {
+    // Mid-retune the module is (or is about to be) in AT mode
+    if (_retune != RETUNE_IDLE) {
+        _droppedFrames++;
+        TRACE_ABORT_FRAME();
+        return false;
+    }
+
+    size_t frameSize = _frame.encode(dmxData, length);
+    if (frameSize == 0) {
         LOG_ERROR_TAG("RADIO", "Packet too large: %d bytes", length);
-        return;
+        return false;
     }
     
-    _serial->write(0xAA);    // Start Byte
-    _serial->write(length);  // Total channels
-    
-    uint8_t checksum = 0xAA;
+    TRACE_MARK(TRACE_RADIO_ENQUEUE);
+    _serial->write(_frame.data()[0]);    // Start Byte
+    TRACE_MARK(TRACE_FIRST_BYTE_OUT);
+    _serial->write(_frame.data() + 1, frameSize - 1);
+    _txPending = true;
     
-    // Send data for each LED (already multiplied by CHAN_PER_LED when called)
-    for (int i = 0; i < length; i++) {
-        _serial->write(dmxData[i]);
-        checksum ^= dmxData[i];
+    LOG_VERBOSE_TAG("RADIO", "Sent %d bytes via HC-12", (int)frameSize);
+    return true;
+}
+
+void RadioLink::poll() {
+    // Non-blocking check for the UART shifting out the last byte
+    if (_txPending && uart_wait_tx_done((uart_port_t)HC12_UART_NUM, 0) == ESP_OK) {
+        _txPending = false;
+        TRACE_MARK(TRACE_LAST_BYTE_OUT);
+        TRACE_END_FRAME();
     }
-    
-    _serial->write(checksum);
-    
-    LOG_VERBOSE_TAG("RADIO", "Sent %d bytes via HC-12", length + 3); // +3 for header, length, checksum
+
+    if (_retune != RETUNE_IDLE) _stepRetune();
+}
+
+void RadioLink::setChannel(uint8_t channel) {
+    if (channel == _requestedChannel) return;
+    _requestedChannel = channel;
+
+    // A retune already under way picks the new channel up when it finishes
+    if (_retune == RETUNE_IDLE) _retune = RETUNE_DRAIN;
+}
+
+void RadioLink::_stepRetune() {
+    unsigned long now = millis();
+
+    switch (_retune) {
+    case RETUNE_DRAIN:
+        // AT mode mid-frame would cut the frame short on air
+        if (_txPending) return;
+        digitalWrite(HC12_SET, LOW);
+        _retuneStepTime = now;
+        _retune = RETUNE_ENTER;
+        return;
+
+    case RETUNE_ENTER:
+        if (now - _retuneStepTime < HC12_AT_ENTER_MS) return;
+        _attemptChannel = _requestedChannel;
+        _replyLength = 0;
+        _retuneStepTime = now;
+        _retune = _sendChannelCommand(_attemptChannel) ? RETUNE_REPLY : RETUNE_EXIT;
+        if (_retune == RETUNE_EXIT) digitalWrite(HC12_SET, HIGH);
+        return;
+
+    case RETUNE_REPLY:
+        // Done as soon as a full "OK+Cnnn" is in, rather than after the timeout
+        _readReply();
+        if (_replyLength < strlen("OK+C000") && now - _retuneStepTime < HC12_AT_REPLY_MS) return;
+        _checkChannelReply(_attemptChannel);
+        digitalWrite(HC12_SET, HIGH);
+        _retuneStepTime = now;
+        _retune = RETUNE_EXIT;
+        return;
+
+    case RETUNE_EXIT:
+        if (now - _retuneStepTime < HC12_AT_EXIT_MS) return;
+        // Asked for another channel while this one was in progress
+        _retune = (_requestedChannel != _attemptChannel) ? RETUNE_DRAIN : RETUNE_IDLE;
+        return;
+
+    case RETUNE_IDLE:
+        return;
+    }
+}
+
+bool RadioLink::_sendChannel(uint8_t channel) {
+    if (!_sendChannelCommand(channel)) return false;
+    delay(HC12_AT_REPLY_MS);
+    _replyLength = 0;
+    _readReply();
+    return _checkChannelReply(channel);
+}
+
+bool RadioLink::_sendChannelCommand(uint8_t channel) {
+    if (channel < MIN_RADIO_CHANNEL || channel > MAX_RADIO_CHANNEL) {
+        LOG_ERROR_TAG("RADIO", "Invalid radio channel: %d", channel);
+        _channelFailures++;
+        return false;
+    }
+
+    char command[10];
+    snprintf(command, sizeof(command), "AT+C%03u", channel);
+    while (_serial->available()) _serial->read();
+    _serial->print(command);
+    return true;
+}
+
+void RadioLink::_readReply() {
+    while (_serial->available() && _replyLength < sizeof(_reply) - 1) {
+        _reply[_replyLength++] = (char)_serial->read();
+    }
+    _reply[_replyLength] = '\0';
+}
+
+bool RadioLink::_checkChannelReply(uint8_t channel) {
+    // Expected reply: "OK+Cnnn"
+    if (strncmp(_reply, "OK+C", 4) != 0) {
+        LOG_WARN_TAG("RADIO", "HC-12 did not acknowledge channel %d", channel);
+        _channelFailures++;
+        return false;
+    }
+    // The module echoes the channel it actually took; a garbled or clamped
+    // one would leave it off the receivers' channel
+    bool digits = true;
+    unsigned acked = 0;
+    for (int i = 4; i < 7; i++) {
+        digits = digits && _reply[i] >= '0' && _reply[i] <= '9';
+        acked = acked * 10 + (_reply[i] - '0');
+    }
+    if (!digits || acked != channel) {
+        LOG_WARN_TAG("RADIO", "HC-12 acknowledged %s for channel %d", _reply, channel);
+        _channelFailures++;
+        return false;
+    }
+    _channel = channel;
+    LOG_INFO_TAG("RADIO", "HC-12 on channel %d", channel);
+    return true;
 }
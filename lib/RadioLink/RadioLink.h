@@ -1,11 +1,56 @@
 #pragma once
 #include <Arduino.h>
 #include "Config.h"
+#include "RadioFrame.h"
 
 class RadioLink {
 public:
-    void begin();
-    void sendDmxPacket(uint8_t* dmxData, uint16_t length);
+    void begin(uint8_t channel);
+    // False if the frame did not go out: too large, or dropped mid-retune
+    bool sendDmxPacket(uint8_t* dmxData, uint16_t length);
+    // Call every loop iteration; completes the latency trace once the UART
+    // drains and steps a retune in progress
+    void poll();
+
+    // Retune the HC-12 (AT+Cnnn) without blocking: poll() waits out the
+    // frame in flight, then runs the AT exchange over the next ~220 ms.
+    // Frames sent meanwhile are dropped (they would be read as AT input),
+    // so the first frame on air after a switch is on the new channel.
+    // Each channel is attempted once; asking again for the channel last
+    // asked for is a no-op, acknowledged or not.
+    void setChannel(uint8_t channel);
+    uint8_t getChannel() const { return _channel; }
+    uint8_t getRequestedChannel() const { return _requestedChannel; }
+    bool isRetuning() const { return _retune != RETUNE_IDLE; }
+    uint32_t getChannelFailures() const { return _channelFailures; }
+    uint32_t getDroppedFrames() const { return _droppedFrames; }
 private:
+    enum RetuneState : uint8_t {
+        RETUNE_IDLE,
+        RETUNE_DRAIN,   // Frame in flight still shifting out
+        RETUNE_ENTER,   // SET low, module entering AT mode
+        RETUNE_REPLY,   // AT+Cnnn sent, collecting the reply
+        RETUNE_EXIT     // SET high, module returning to transparent mode
+    };
+
     HardwareSerial* _serial;
+    bool _txPending = false;
+    uint8_t _channel = 0;            // 0 = not confirmed by the module
+    uint8_t _requestedChannel = 0;   // Last channel asked for, confirmed or not
+    uint8_t _attemptChannel = 0;     // Channel of the AT+Cnnn in progress
+    volatile RetuneState _retune = RETUNE_IDLE;
+    unsigned long _retuneStepTime = 0;
+    char _reply[16];
+    uint8_t _replyLength = 0;
+    uint32_t _channelFailures = 0;
+    uint32_t _droppedFrames = 0;
+    alignas(HOT_BUFFER_ALIGN) RadioFrameEncoder<MAX_NUM_LEDS * CHAN_PER_LED> _frame;
+
+    void _stepRetune();
+    // Module must already be in AT mode. _sendChannel blocks for the reply;
+    // _sendChannelCommand only sends, _readReply/_checkChannelReply finish.
+    bool _sendChannel(uint8_t channel);
+    bool _sendChannelCommand(uint8_t channel);
+    void _readReply();
+    bool _checkChannelReply(uint8_t channel);
 };
\ No newline at end of file
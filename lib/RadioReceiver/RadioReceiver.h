@@ -0,0 +1,96 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "RadioFrame.h"
+
+#define RADIO_RX_GAP_MS 50          // Silence mid-frame that abandons the partial frame
+
+struct RadioReceiverStats {
+    uint32_t bytes;
+    uint32_t frames;                // Passed the checksum
+    uint32_t badChecksum;
+    uint32_t tooLong;               // Longer than the receiver's capacity
+    uint32_t stalled;               // Partial frames abandoned after RADIO_RX_GAP_MS
+};
+
+/*
+ * Reference receiver for the radio link: what a wristband runs on its HC-12
+ * UART. It decodes the byte stream with RadioFrameDecoder and keeps the last
+ * good frame in its own buffer, so the application can read it while the
+ * next frame is arriving. A frame cut short on air would otherwise swallow
+ * the start of the next one; a partial frame is dropped once the stream has
+ * been silent for RADIO_RX_GAP_MS.
+ *
+ * Header-only and allocation-free like RadioFrame.h. `Capacity` is the
+ * largest payload accepted (CHAN_PER_LED x LEDs driven).
+ */
+template <size_t Capacity = RADIO_FRAME_MAX_PAYLOAD>
+class RadioReceiver {
+public:
+    // Decode bytes received at `nowMs`. Returns true if a new frame completed.
+    bool receive(const uint8_t* data, size_t len, uint32_t nowMs) {
+        if (len == 0) return false;
+        if (_decoder.inFrame() && nowMs - _lastByteMs > RADIO_RX_GAP_MS) {
+            _decoder.reset();
+            _stats.stalled++;
+        }
+        _lastByteMs = nowMs;
+        _stats.bytes += len;
+
+        bool updated = false;
+        for (size_t i = 0; i < len; i++) {
+            switch (_decoder.feed(data[i])) {
+                case RADIO_FRAME_OK:
+                    _length = _decoder.length();
+                    memcpy(_frame, _decoder.payload(), _length);
+                    _lastFrameMs = nowMs;
+                    _stats.frames++;
+                    updated = true;
+                    break;
+                case RADIO_FRAME_BAD_CHECKSUM:
+                    _stats.badChecksum++;
+                    break;
+                case RADIO_FRAME_TOO_LONG:
+                    _stats.tooLong++;
+                    break;
+                case RADIO_FRAME_NONE:
+                default:
+                    break;
+            }
+        }
+        return updated;
+    }
+
+    // Drain everything `stream` has buffered (a HardwareSerial, or anything
+    // with available() and read()). Returns true if a new frame completed.
+    template <typename StreamT>
+    bool poll(StreamT& stream, uint32_t nowMs) {
+        uint8_t chunk[32];
+        bool updated = false;
+        while (stream.available() > 0) {
+            size_t n = 0;
+            while (n < sizeof(chunk) && stream.available() > 0) {
+                chunk[n++] = (uint8_t)stream.read();
+            }
+            updated |= receive(chunk, n, nowMs);
+        }
+        return updated;
+    }
+
+    // Last good frame; length() is 0 until the first one arrives
+    const uint8_t* frame() const { return _frame; }
+    uint16_t length() const { return _length; }
+    bool hasFrame() const { return _stats.frames > 0; }
+    uint32_t msSinceFrame(uint32_t nowMs) const { return nowMs - _lastFrameMs; }
+
+    const RadioReceiverStats& stats() const { return _stats; }
+
+private:
+    RadioFrameDecoder<Capacity> _decoder;
+    uint8_t _frame[Capacity] = {};
+    uint16_t _length = 0;
+    uint32_t _lastByteMs = 0;
+    uint32_t _lastFrameMs = 0;
+    RadioReceiverStats _stats = {};
+};
@@ -0,0 +1,144 @@
+#include "SacnLoad.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+static const uint8_t ACN_PACKET_ID[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+#define DMX_PRIORITY_START_CODE 0xDD
+
+// Layer lengths carry the PDU flags (0x7) in the top nibble
+static void putFlagsLength(uint8_t* p, size_t length) {
+    uint16_t value = 0x7000 | (uint16_t)length;
+    p[0] = value >> 8;
+    p[1] = value & 0xFF;
+}
+
+SacnLoadGenerator::SacnLoadGenerator(const SacnLoadConfig& config)
+    : _config(config), _rng(config.seed ? config.seed : 1) {
+    _config.sources = std::max<uint8_t>(1, std::min<uint8_t>(_config.sources, SACN_MAX_SOURCES));
+    _config.universes = std::max<uint16_t>(1, _config.universes);
+    _config.slots = std::min<uint16_t>(_config.slots, DMX_MAX_CHANNELS);
+    _config.burst = std::max<uint16_t>(1, _config.burst);
+    if (_config.priorities.empty()) _config.priorities.push_back(100);
+    if (_config.rate <= 0) _config.rate = 1;
+
+    for (uint8_t s = 0; s < _config.sources; s++) {
+        for (uint8_t i = 0; i < 16; i++) _cids[s][i] = (uint8_t)(_random() * 256);
+        _cids[s][15] = s;   // Distinct even if the generator repeats
+    }
+    _sequences.assign((size_t)_config.sources * _config.universes, 0);
+}
+
+float SacnLoadGenerator::_random() {
+    // xorshift32: identical sequences on every host
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 17;
+    _rng ^= _rng << 5;
+    return (_rng >> 8) * (1.0f / 16777216.0f);
+}
+
+float SacnLoadGenerator::offeredRate() const {
+    return _config.rate * _config.sources * _config.universes;
+}
+
+size_t SacnLoadGenerator::buildPacket(uint8_t* out, const uint8_t cid[16], uint8_t priority, uint8_t sequence,
+                                      uint16_t universe, uint16_t slots, uint32_t frame) {
+    size_t size = E131_HEADER_SIZE + slots;
+    memset(out, 0, E131_HEADER_SIZE);
+
+    // Root layer
+    out[1] = 0x10;
+    memcpy(out + E131_ACN_ID_OFFSET, ACN_PACKET_ID, sizeof(ACN_PACKET_ID));
+    putFlagsLength(out + 16, size - 16);
+    out[E131_ROOT_VECTOR_OFFSET + 3] = 0x04;
+    memcpy(out + E131_CID_OFFSET, cid, 16);
+
+    // Framing layer
+    putFlagsLength(out + 38, size - 38);
+    out[E131_FRAMING_VECTOR_OFFSET + 3] = 0x02;
+    snprintf((char*)out + 44, 64, "sacn_load %02X", cid[15]);
+    out[E131_PRIORITY_OFFSET] = priority;
+    out[E131_SEQUENCE_OFFSET] = sequence;
+    out[E131_UNIVERSE_OFFSET] = universe >> 8;
+    out[E131_UNIVERSE_OFFSET + 1] = universe & 0xFF;
+
+    // DMP layer: one property, address increment 1
+    putFlagsLength(out + 115, size - 115);
+    out[E131_DMP_VECTOR_OFFSET] = 0x02;
+    out[118] = 0xA1;
+    out[122] = 0x01;
+    uint16_t valueCount = slots + 1;
+    out[E131_LENGTH_OFFSET] = valueCount >> 8;
+    out[E131_LENGTH_OFFSET + 1] = valueCount & 0xFF;
+    out[E131_HEADER_SIZE - 1] = DMX_STARTCODE;
+
+    // A moving ramp, so consecutive frames differ
+    for (uint16_t i = 0; i < slots; i++) {
+        out[E131_HEADER_SIZE + i] = (uint8_t)(i + frame);
+    }
+    return size;
+}
+
+size_t SacnLoadGenerator::corrupt(uint8_t* packet, size_t size, SacnMalformed kind) {
+    switch (kind) {
+        case SACN_TRUNCATED:
+            return std::min<size_t>(size, E131_HEADER_SIZE / 2);
+        case SACN_BAD_ACN_ID:
+            packet[E131_ACN_ID_OFFSET] = 'X';
+            return size;
+        case SACN_BAD_START_CODE:
+            packet[E131_HEADER_SIZE - 1] = DMX_PRIORITY_START_CODE;
+            return size;
+        case SACN_ZERO_VALUE_COUNT:
+            packet[E131_LENGTH_OFFSET] = 0;
+            packet[E131_LENGTH_OFFSET + 1] = 0;
+            return size;
+        case SACN_OVERSIZE_VALUE_COUNT: {
+            uint16_t valueCount = DMX_MAX_CHANNELS + 1;
+            packet[E131_LENGTH_OFFSET] = valueCount >> 8;
+            packet[E131_LENGTH_OFFSET + 1] = valueCount & 0xFF;
+            // Drop half the slots the header still claims
+            return E131_HEADER_SIZE + (size - E131_HEADER_SIZE) / 2;
+        }
+        case SACN_WELL_FORMED:
+        default:
+            return size;
+    }
+}
+
+void SacnLoadGenerator::next(SacnPacket& packet) {
+    // Tick layout: burst x source x universe
+    uint32_t perTick = (uint32_t)_config.burst * _config.sources * _config.universes;
+    uint32_t slot = _slot;
+    uint16_t universeIndex = slot % _config.universes;
+    slot /= _config.universes;
+    uint8_t source = slot % _config.sources;
+    uint16_t burstIndex = slot / _config.sources;
+
+    uint64_t tickUs = (uint64_t)(1000000.0 * _config.burst / _config.rate);
+    packet.dueUs = _tick * tickUs;
+    packet.universe = _config.firstUniverse + universeIndex;
+    packet.source = source;
+
+    packet.kind = SACN_WELL_FORMED;
+    if (_config.malformedRate > 0 && _random() < _config.malformedRate) {
+        packet.kind = (SacnMalformed)(1 + (uint32_t)(_random() * (SACN_MALFORMED_KINDS - 1)));
+        _malformed++;
+    }
+
+    // Only packets that still pass the header checks take a sequence number
+    uint8_t& sequence = _sequences[(size_t)source * _config.universes + universeIndex];
+    if (packet.kind == SACN_WELL_FORMED || packet.kind == SACN_OVERSIZE_VALUE_COUNT) sequence++;
+    packet.sequence = sequence;
+
+    uint8_t priority = _config.priorities[std::min<size_t>(source, _config.priorities.size() - 1)];
+    uint32_t frame = (uint32_t)(_tick * _config.burst + burstIndex);
+    packet.size = buildPacket(packet.data, _cids[source], priority, sequence, packet.universe, _config.slots, frame);
+    packet.size = corrupt(packet.data, packet.size, packet.kind);
+
+    _generated++;
+    if (++_slot == perTick) {
+        _slot = 0;
+        _tick++;
+    }
+}
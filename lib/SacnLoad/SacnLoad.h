@@ -0,0 +1,82 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "Config.h"
+
+#define SACN_MAX_SOURCES 16
+
+// Deliberately broken packets in the mix, each hitting one receive-path check
+enum SacnMalformed : uint8_t {
+    SACN_WELL_FORMED,
+    SACN_TRUNCATED,                 // Shorter than the header
+    SACN_BAD_ACN_ID,                // Not an E1.31 packet at all
+    SACN_BAD_START_CODE,            // 0xDD (per-slot priority) instead of DMX
+    SACN_ZERO_VALUE_COUNT,
+    SACN_OVERSIZE_VALUE_COUNT,      // Claims more slots than it holds (clamped, still accepted)
+    SACN_MALFORMED_KINDS
+};
+
+struct SacnLoadConfig {
+    uint16_t firstUniverse = DEFAULT_UNIVERSE;
+    uint16_t universes = 1;         // Consecutive universes from firstUniverse
+    uint8_t sources = 1;            // Senders, each with its own CID and sequence
+    std::vector<uint8_t> priorities = {100};    // Per source, the last one repeats
+    float rate = 30;                // Packets per second per source and universe
+    uint16_t slots = DMX_MAX_CHANNELS;
+    float malformedRate = 0;        // Fraction of packets from the malformed kinds
+    uint16_t burst = 1;             // Frames sent back to back per tick, same average rate
+    uint32_t seed = 1;
+};
+
+struct SacnPacket {
+    uint64_t dueUs;                 // Send time from the start of the run
+    uint16_t universe;
+    uint8_t source;
+    uint8_t sequence;
+    SacnMalformed kind;
+    size_t size;
+    uint8_t data[E131_MAX_PACKET_SIZE];
+};
+
+/*
+ * Host-only sACN traffic source for stress-testing the receive path: any mix
+ * of universes, sources, priorities and malformed packets, sent smoothly or
+ * in bursts. It only decides what to send and when; tools/sacn_load puts the
+ * packets on a socket and the tests inject them into the fake W5500.
+ *
+ * Every tick, each source sends `burst` frames for each universe back to
+ * back, as a lighting console does at its frame time. Sequence numbers are
+ * kept per source and universe; a malformed packet the receiver rejects
+ * reuses the last one, so its loss counter only sees real losses.
+ */
+class SacnLoadGenerator {
+public:
+    explicit SacnLoadGenerator(const SacnLoadConfig& config);
+
+    // The next packet in send order
+    void next(SacnPacket& packet);
+
+    uint64_t generated() const { return _generated; }
+    uint64_t malformed() const { return _malformed; }
+    // Aggregate offered load in packets per second
+    float offeredRate() const;
+
+    // A well-formed data packet with `slots` values. Returns its size.
+    static size_t buildPacket(uint8_t* out, const uint8_t cid[16], uint8_t priority, uint8_t sequence,
+                              uint16_t universe, uint16_t slots, uint32_t frame);
+    // Break a packet from buildPacket() in the given way. Returns the new size.
+    static size_t corrupt(uint8_t* packet, size_t size, SacnMalformed kind);
+
+private:
+    SacnLoadConfig _config;
+    uint8_t _cids[SACN_MAX_SOURCES][16];
+    std::vector<uint8_t> _sequences;    // Per source x universe
+    uint64_t _tick = 0;
+    uint32_t _slot = 0;                 // Position within the current tick
+    uint64_t _generated = 0;
+    uint64_t _malformed = 0;
+    uint32_t _rng;
+
+    float _random();
+};
@@ -0,0 +1,64 @@
+#include "SerialConsole.h"
+#include "Logger.h"
+
+SerialConsole::Command SerialConsole::_commands[CONSOLE_MAX_COMMANDS] = {};
+uint8_t SerialConsole::_commandCount = 0;
+char SerialConsole::_line[CONSOLE_LINE_LENGTH] = {};
+uint8_t SerialConsole::_lineLen = 0;
+
+void SerialConsole::begin() {
+    _lineLen = 0;
+    registerCommand("help", "List available commands", printHelp);
+    LOG_INFO_TAG("CONSOLE", "Serial console ready - type 'help'");
+}
+
+bool SerialConsole::registerCommand(const char* name, const char* help, ConsoleHandler handler) {
+    if (_commandCount >= CONSOLE_MAX_COMMANDS) {
+        LOG_ERROR_TAG("CONSOLE", "Command table full, dropping '%s'", name);
+        return false;
+    }
+    _commands[_commandCount++] = {name, help, handler};
+    return true;
+}
+
+void SerialConsole::poll() {
+    while (Serial.available()) {
+        char c = (char)Serial.read();
+
+        if (c == '\r' || c == '\n') {
+            if (_lineLen > 0) {
+                _line[_lineLen] = '\0';
+                dispatch(_line);
+                _lineLen = 0;
+            }
+        } else if (_lineLen < CONSOLE_LINE_LENGTH - 1) {
+            _line[_lineLen++] = c;
+        }
+    }
+}
+
+void SerialConsole::dispatch(char* line) {
+    // Split "name args..." in place
+    char* args = line;
+    while (*args && *args != ' ') args++;
+    if (*args) {
+        *args++ = '\0';
+        while (*args == ' ') args++;
+    }
+
+    for (uint8_t i = 0; i < _commandCount; i++) {
+        if (strcmp(line, _commands[i].name) == 0) {
+            _commands[i].handler(args);
+            return;
+        }
+    }
+    Serial.printf("Unknown command '%s' - type 'help'\r\n", line);
+}
+
+void SerialConsole::printHelp(const char* args) {
+    Serial.println(F("\r\n=== COMMANDS ==="));
+    for (uint8_t i = 0; i < _commandCount; i++) {
+        Serial.printf("%-10s %s\r\n", _commands[i].name, _commands[i].help);
+    }
+    Serial.println(F("================\r\n"));
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+// Handler for a console command. `args` points at the text after the command
+// name (leading spaces stripped) and is never null.
+typedef void (*ConsoleHandler)(const char* args);
+
+class SerialConsole {
+public:
+    static void begin();
+
+    // Register a command before calling poll(). Returns false if the table is full.
+    static bool registerCommand(const char* name, const char* help, ConsoleHandler handler);
+
+    // Read pending characters from Serial and dispatch complete lines
+    static void poll();
+
+private:
+    struct Command {
+        const char* name;
+        const char* help;
+        ConsoleHandler handler;
+    };
+
+    static Command _commands[CONSOLE_MAX_COMMANDS];
+    static uint8_t _commandCount;
+    static char _line[CONSOLE_LINE_LENGTH];
+    static uint8_t _lineLen;
+
+    static void dispatch(char* line);
+    static void printHelp(const char* args);
+};
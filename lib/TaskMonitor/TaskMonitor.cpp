@@ -0,0 +1,250 @@
+#include "TaskMonitor.h"
+#include "Logger.h"
+#include <esp_freertos_hooks.h>
+#include <esp_timer.h>
+
+#define RUN_TIME_STATS (configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS)
+
+#if !configUSE_TRACE_FACILITY
+#include <freertos/task_snapshot.h>
+#endif
+
+TaskMonitor::TaskSample TaskMonitor::_tasks[TASK_MONITOR_MAX_TASKS] = {};
+uint8_t TaskMonitor::_taskCount = 0;
+TaskMonitor::Watched TaskMonitor::_watched[TASK_MONITOR_MAX_TASKS] = {};
+uint8_t TaskMonitor::_watchedCount = 0;
+bool TaskMonitor::_idleHooks = false;
+volatile uint32_t TaskMonitor::_idleTimeUs[portNUM_PROCESSORS] = {};
+uint32_t TaskMonitor::_lastIdleHookUs[portNUM_PROCESSORS] = {};
+volatile int8_t TaskMonitor::_coreLoad[portNUM_PROCESSORS] = {};
+bool TaskMonitor::_coreAlert[portNUM_PROCESSORS] = {};
+uint32_t TaskMonitor::_lastIdleTime[portNUM_PROCESSORS] = {};
+uint32_t TaskMonitor::_lastSampleUs = 0;
+uint32_t TaskMonitor::_lastTotalTime = 0;
+volatile uint32_t TaskMonitor::_minStackFree = UINT32_MAX;
+char TaskMonitor::_minStackTask[configMAX_TASK_NAME_LEN] = "-";
+portMUX_TYPE TaskMonitor::_minStackMux = portMUX_INITIALIZER_UNLOCKED;
+void (*TaskMonitor::_sampleCallback)() = nullptr;
+
+static TaskHandle_t monitorTaskHandle = nullptr;
+
+void TaskMonitor::begin() {
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        _coreLoad[core] = -1;
+    }
+
+    if (TASK_MONITOR_CORE_LOAD) {
+        _idleHooks = true;
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            if (esp_register_freertos_idle_hook_for_cpu(idleHook, core) != ESP_OK) _idleHooks = false;
+        }
+        if (!_idleHooks) {
+            LOG_WARN_TAG("TASKMON", "Idle hooks unavailable - CPU load unavailable");
+        }
+    }
+
+    xTaskCreatePinnedToCore(monitorLoop, "MonTask", MON_TASK_STACK, NULL, 1, &monitorTaskHandle, 1);
+    watch(monitorTaskHandle, MON_TASK_STACK);
+    LOG_INFO_TAG("TASKMON", "Task monitor started (%d ms period)", TASK_MONITOR_PERIOD_MS);
+}
+
+void TaskMonitor::setSampleCallback(void (*callback)()) {
+    _sampleCallback = callback;
+}
+
+void TaskMonitor::watch(TaskHandle_t handle, uint32_t stackSize) {
+    if (handle == nullptr || _watchedCount >= TASK_MONITOR_MAX_TASKS) return;
+    _watched[_watchedCount++] = {handle, stackSize};
+}
+
+int8_t TaskMonitor::getCoreLoad(uint8_t core) {
+    return core < portNUM_PROCESSORS ? _coreLoad[core] : -1;
+}
+
+uint32_t TaskMonitor::getMinStackFree() {
+    return _minStackFree;
+}
+
+void TaskMonitor::getMinStackTask(char* name, size_t size) {
+    portENTER_CRITICAL(&_minStackMux);
+    strlcpy(name, _minStackTask, size);
+    portEXIT_CRITICAL(&_minStackMux);
+}
+
+// Runs on every pass of a core's idle loop. A gap between passes longer
+// than TASK_MONITOR_IDLE_GAP_US means another task ran in between.
+bool IRAM_ATTR TaskMonitor::idleHook() {
+    BaseType_t core = xPortGetCoreID();
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    uint32_t gap = now - _lastIdleHookUs[core];
+    if (gap < TASK_MONITOR_IDLE_GAP_US) _idleTimeUs[core] += gap;
+    _lastIdleHookUs[core] = now;
+    return false;   // No WAITI: time asleep in it would read as busy
+}
+
+void TaskMonitor::monitorLoop(void* parameter) {
+    for (;;) {
+        sample();
+        if (_sampleCallback != nullptr) {
+            _sampleCallback();
+        }
+        vTaskDelay(pdMS_TO_TICKS(TASK_MONITOR_PERIOD_MS));
+    }
+}
+
+uint32_t TaskMonitor::watchedStackSize(TaskHandle_t handle) {
+    for (uint8_t i = 0; i < _watchedCount; i++) {
+        if (_watched[i].handle == handle) return _watched[i].stackSize;
+    }
+    return 0;
+}
+
+const TaskMonitor::TaskSample* TaskMonitor::previousSample(TaskHandle_t handle) {
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        if (_tasks[i].handle == handle) return &_tasks[i];
+    }
+    return nullptr;
+}
+
+void TaskMonitor::sample() {
+    sampleCoreLoad();
+    if (!sampleTasks()) return;
+
+    uint32_t minFree = UINT32_MAX;
+    const char* minTask = "-";
+
+    // Stack thresholds
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        TaskSample& s = _tasks[i];
+        bool alert = s.stackFree < TASK_MONITOR_STACK_WARN_BYTES;
+        if (alert && !s.stackAlert) {
+            LOG_WARN_TAG("TASKMON", "Task %s stack low: %lu bytes free", s.name, (unsigned long)s.stackFree);
+        }
+        s.stackAlert = alert;
+
+        if (s.stackFree < minFree) {
+            minFree = s.stackFree;
+            minTask = s.name;
+        }
+    }
+
+    portENTER_CRITICAL(&_minStackMux);
+    _minStackFree = minFree;
+    strlcpy(_minStackTask, minTask, sizeof(_minStackTask));
+    portEXIT_CRITICAL(&_minStackMux);
+}
+
+// Busy share of each core: the interval less the time its idle hook accounted for
+void TaskMonitor::sampleCoreLoad() {
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    uint32_t elapsed = now - _lastSampleUs;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        uint32_t idleTime = _idleTimeUs[core];
+        if (_idleHooks && _lastSampleUs != 0 && elapsed > 0) {
+            uint32_t idlePct = (uint64_t)(idleTime - _lastIdleTime[core]) * 100 / elapsed;
+            _coreLoad[core] = (int8_t)(100 - min<uint32_t>(100, idlePct));
+        }
+        _lastIdleTime[core] = idleTime;
+
+        bool alert = _coreLoad[core] >= TASK_MONITOR_CPU_WARN_PCT;
+        if (alert && !_coreAlert[core]) {
+            LOG_WARN_TAG("TASKMON", "Core %d saturated: %d%% load", core, _coreLoad[core]);
+        } else if (!alert && _coreAlert[core]) {
+            LOG_INFO_TAG("TASKMON", "Core %d load back to %d%%", core, _coreLoad[core]);
+        }
+        _coreAlert[core] = alert;
+    }
+    _lastSampleUs = now;
+}
+
+// Fills _tasks with every task; stackAlert carries over from the last sample
+bool TaskMonitor::sampleTasks() {
+    static TaskSample next[TASK_MONITOR_MAX_TASKS];
+    if (uxTaskGetNumberOfTasks() > TASK_MONITOR_MAX_TASKS) {
+        LOG_WARN_TAG("TASKMON", "More than %d tasks, raise TASK_MONITOR_MAX_TASKS", TASK_MONITOR_MAX_TASKS);
+        return false;
+    }
+
+#if configUSE_TRACE_FACILITY
+    // Fields are copied under the kernel lock, so a task deleted meanwhile is harmless
+    static TaskStatus_t status[TASK_MONITOR_MAX_TASKS];
+    uint32_t totalTime = 0;
+    UBaseType_t n = uxTaskGetSystemState(status, TASK_MONITOR_MAX_TASKS, &totalTime);
+    uint32_t totalDelta = totalTime - _lastTotalTime;
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        TaskSample& s = next[i];
+        s.handle = status[i].xHandle;
+        strlcpy(s.name, status[i].pcTaskName, sizeof(s.name));
+        s.core = (status[i].xCoreID == tskNO_AFFINITY) ? -1 : (int8_t)status[i].xCoreID;
+        s.priority = (uint8_t)status[i].uxCurrentPriority;
+        s.stackFree = status[i].usStackHighWaterMark;
+        s.stackAlert = false;
+        s.runTime = 0;
+        s.cpuPercent = 0;
+#if RUN_TIME_STATS
+        s.runTime = status[i].ulRunTimeCounter;
+#endif
+
+        // Per-task load over the interval, using the previous sample of the same task
+        const TaskSample* previous = previousSample(s.handle);
+        if (previous != nullptr) {
+            if (RUN_TIME_STATS && totalDelta > 0) {
+                s.cpuPercent = (uint8_t)min<uint32_t>(100, (uint64_t)(s.runTime - previous->runTime) * 100 / totalDelta);
+            }
+            s.stackAlert = previous->stackAlert;
+        }
+    }
+    _lastTotalTime = totalTime;
+#else
+    // Stack marks only. The snapshot is just the list of TCBs, so they are
+    // read with the scheduler suspended: no task can be deleted and freed
+    // between the snapshot and the reads.
+    static TaskSnapshot_t snapshot[TASK_MONITOR_MAX_TASKS];
+    UBaseType_t tcbSize;
+    vTaskSuspendAll();
+    UBaseType_t n = uxTaskGetSnapshotAll(snapshot, TASK_MONITOR_MAX_TASKS, &tcbSize);
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        TaskSample& s = next[i];
+        s.handle = (TaskHandle_t)snapshot[i].pxTCB;
+        strlcpy(s.name, pcTaskGetName(s.handle), sizeof(s.name));
+        BaseType_t core = xTaskGetAffinity(s.handle);
+        s.core = (core == tskNO_AFFINITY) ? -1 : (int8_t)core;
+        s.priority = (uint8_t)uxTaskPriorityGet(s.handle);
+        s.runTime = 0;
+        s.cpuPercent = 0;
+        s.stackFree = uxTaskGetStackHighWaterMark(s.handle);
+        const TaskSample* previous = previousSample(s.handle);
+        s.stackAlert = previous != nullptr && previous->stackAlert;
+    }
+    xTaskResumeAll();
+#endif
+
+    memcpy(_tasks, next, sizeof(TaskSample) * n);
+    _taskCount = n;
+    return true;
+}
+
+void TaskMonitor::printReport() {
+    Serial.println(F("\r\n=== TASKS ==="));
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (_coreLoad[core] < 0) {
+            Serial.printf("Core %d load: --\r\n", core);
+        } else {
+            Serial.printf("Core %d load: %d%%\r\n", core, _coreLoad[core]);
+        }
+    }
+    Serial.printf("%-16s %4s %4s %4s %8s %8s\r\n", "name", "core", "prio", "cpu%", "stk free", "stk size");
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        const TaskSample& s = _tasks[i];
+        uint32_t size = watchedStackSize(s.handle);
+        char cpu[5] = "-";
+        if (RUN_TIME_STATS) snprintf(cpu, sizeof(cpu), "%u", s.cpuPercent);
+        Serial.printf("%-16s %4d %4u %4s %8lu %8lu%s\r\n", s.name, s.core, s.priority, cpu,
+                      (unsigned long)s.stackFree, (unsigned long)size,
+                      s.stackAlert ? " LOW" : "");
+    }
+    Serial.println(F("=============\r\n"));
+}
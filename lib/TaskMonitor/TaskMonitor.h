@@ -0,0 +1,87 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "Config.h"
+
+/*
+ * Periodic FreeRTOS task monitor.
+ *
+ * Per-core load comes from idle hooks, which the stock Arduino sdkconfig
+ * supports: each core's hook adds up the time its idle loop runs, and every
+ * TASK_MONITOR_PERIOD_MS the monitor turns that into the core's busy share.
+ * The hooks keep the idle loop spinning instead of waiting for an
+ * interrupt, so the cores never clock-gate while idle; they are only
+ * installed when TASK_MONITOR_CORE_LOAD is set. Otherwise load reads -1.
+ *
+ * Every task is walked each period for its stack high-water mark
+ * (uxTaskGetSystemState, or uxTaskGetSnapshotAll without the trace
+ * facility). Per-task CPU load also needs run-time stats
+ * (configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS); without
+ * them that column is empty. A warning is logged when a stack or a core
+ * crosses its threshold. On ESP-IDF stack sizes and high-water marks are
+ * in bytes.
+ */
+class TaskMonitor {
+public:
+    // Start the sampling task
+    static void begin();
+
+    // Tasks created by the application, with the stack size they were given,
+    // so the report can show how much of each stack is actually used
+    static void watch(TaskHandle_t handle, uint32_t stackSize);
+
+    // Called from the monitor task after every sample
+    static void setSampleCallback(void (*callback)());
+
+    // CPU load of a core over the last interval, 0-100 (or -1 if unavailable)
+    static int8_t getCoreLoad(uint8_t core);
+    // Smallest stack headroom among all tasks, in bytes
+    static uint32_t getMinStackFree();
+    // Copies the name of the task with the least headroom ("-" before the first sample)
+    static void getMinStackTask(char* name, size_t size);
+
+    static void printReport();
+
+private:
+    struct TaskSample {
+        TaskHandle_t handle;
+        char name[configMAX_TASK_NAME_LEN];     // Copied: the TCB goes away with the task
+        int8_t core;
+        uint8_t priority;
+        uint8_t cpuPercent;
+        uint32_t runTime;
+        uint32_t stackFree;
+        bool stackAlert;
+    };
+
+    struct Watched {
+        TaskHandle_t handle;
+        uint32_t stackSize;
+    };
+
+    static TaskSample _tasks[TASK_MONITOR_MAX_TASKS];
+    static uint8_t _taskCount;
+    static Watched _watched[TASK_MONITOR_MAX_TASKS];
+    static uint8_t _watchedCount;
+    static bool _idleHooks;
+    static volatile uint32_t _idleTimeUs[portNUM_PROCESSORS];   // Written by the core's own idle hook
+    static uint32_t _lastIdleHookUs[portNUM_PROCESSORS];
+    static volatile int8_t _coreLoad[portNUM_PROCESSORS];
+    static bool _coreAlert[portNUM_PROCESSORS];
+    static uint32_t _lastIdleTime[portNUM_PROCESSORS];
+    static uint32_t _lastSampleUs;
+    static uint32_t _lastTotalTime;
+    static volatile uint32_t _minStackFree;
+    static char _minStackTask[configMAX_TASK_NAME_LEN];
+    static portMUX_TYPE _minStackMux;   // _minStackTask is rewritten every sample
+    static void (*_sampleCallback)();
+
+    static bool idleHook();
+    static void monitorLoop(void* parameter);
+    static void sample();
+    static void sampleCoreLoad();
+    static bool sampleTasks();
+    static const TaskSample* previousSample(TaskHandle_t handle);
+    static uint32_t watchedStackSize(TaskHandle_t handle);
+};
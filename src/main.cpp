@@ -1,67 +1,278 @@
 #include <Arduino.h>
 #include <nvs_flash.h>
+#include <esp_task_wdt.h>
 #include "Config.h"
 #include "ConfigData.h"
 #include "Logger.h"
 #include "ConfigManager.h"
+#include "ConfigService.h"
 #include "E131Handler.h"
 #include "RadioLink.h"
 #include "DisplayMgr.h"
+#include "LatencyTrace.h"
+#include "SerialConsole.h"
+#include "TaskMonitor.h"
+#include "EthBus.h"
+#include "LiveFrame.h"
+#include "ButtonInput.h"
+#include "Pipeline.h"
+#include "ProfileStore.h"
+#include "Bench.h"
+#include "HeapGuard.h"
+#include "MemPlacement.h"
+#include "FrameHistory.h"
+#include "HotPath.h"
 
 // Objects
 ConfigManager configMgr;
+ConfigService configSvc(configMgr);
 DisplayMgr displayMgr; 
 E131Handler eth;
 RadioLink radio;
 
-// Shared Data
-DeviceConfig deviceConfig;
+// Shared Data (live config is owned by configSvc)
 volatile bool packetReceived = false;
-unsigned long lastPacketTime = 0;
-uint8_t sharedDmxData[512];
+volatile unsigned long lastPacketTime = 0;
+
+// Network task frame buffers: internal RAM, cache-line aligned (HotPath.h)
+static uint8_t localDmxBuffer[DMX_MAX_CHANNELS] HOT_BUFFER_ATTR;
+static uint8_t radioBuffer[PIPELINE_MAX_PAYLOAD] HOT_BUFFER_ATTR;
 
 // Tasks
 TaskHandle_t NetworkTaskHandle;
 TaskHandle_t DisplayTaskHandle;
 TaskHandle_t InputTaskHandle;
 
-// Callback
+// Wake the display task; it only renders when something changed
+void notifyDisplay(uint32_t events) {
+    if (DisplayTaskHandle != NULL) {
+        xTaskNotify(DisplayTaskHandle, events, eSetBits);
+    }
+}
+
+// Callbacks
 void saveConfigCallback(const DeviceConfig& cfg) {
-    configMgr.saveConfig(cfg);
-    // Update live settings
-    eth.setUniverse(cfg.universe);
+    // Publishes immediately; the NVS commit happens after a quiet period
+    configSvc.stage(cfg);
+    configSvc.publish();
+}
+
+void applyConfigCallback(const DeviceConfig& cfg) {
+    // Derive the hot-path snapshot here; the network task picks it up
+    // (universe included) at its next loop iteration
+    Pipeline::rebuild(cfg);
+    notifyDisplay(DISPLAY_EVT_CONFIG);
+}
+
+// Console: "profile", "profile <n>", "profile save <n> <name> [channel]",
+// "profile erase <n>". Slots are 1-based.
+void profileCommand(const char* args) {
+    int slot = 0;
+    int channel = 0;
+    char name[32];
+
+    if (args[0] == '\0') {
+        ProfileStore::printList();
+    } else if (sscanf(args, "save %d %31s %d", &slot, name, &channel) >= 2) {
+        DeviceConfig config = configSvc.get();
+        if (channel != 0) config.radioChannel = (uint8_t)constrain(channel, MIN_RADIO_CHANNEL, MAX_RADIO_CHANNEL);
+        Serial.println(ProfileStore::save(slot - 1, name, config) ? F("Saved") : F("Save failed"));
+        notifyDisplay(DISPLAY_EVT_CONFIG);   // The profile list may be showing
+    } else if (sscanf(args, "erase %d", &slot) == 1) {
+        Serial.println(ProfileStore::erase(slot - 1) ? F("Erased") : F("Erase failed"));
+        notifyDisplay(DISPLAY_EVT_CONFIG);
+    } else if (sscanf(args, "%d", &slot) == 1) {
+        Serial.println(ProfileStore::activate(slot - 1) ? F("Switched") : F("No such profile"));
+    } else {
+        Serial.println(F("Usage: profile [<n> | save <n> <name> [channel] | erase <n>]"));
+    }
+}
+
+// Console: "bench [json] [filter]". Runs the hot-path microbenchmarks in the
+// console task; the network task keeps running, so expect some noise.
+void benchCommand(const char* args) {
+    bool json = strncmp(args, "json", 4) == 0 && (args[4] == '\0' || args[4] == ' ');
+    if (json) {
+        args += 4;
+        while (*args == ' ') args++;
+    }
+
+    Serial.println(F("Running benchmarks..."));
+    Bench::addCoreCases();
+    Bench::addMemoryCases();
+    Bench::addHotPathCases();
+    if (Bench::run(args) == 0) {
+        Serial.println(F("No matching benchmark"));
+    } else if (json) {
+        Bench::printJson(Serial, "esp32s3");
+    } else {
+        Bench::printReport();
+    }
+}
+
+// Console: "netstats" prints the receive counters, "netstats reset" starts
+// a new measurement window
+void netstatsCommand(const char* args) {
+    if (strcmp(args, "reset") == 0) {
+        eth.resetRxStats();
+        Serial.println(F("Receive counters reset"));
+    } else {
+        eth.printRxStats();
+    }
+}
+
+// Console: "heap" prints the heap watermarks and allocations since boot,
+// "heap reset" clears the counts, "heap assert on|off" toggles aborting on
+// an allocation from a watched task
+void heapCommand(const char* args) {
+    if (strcmp(args, "reset") == 0) {
+        HeapGuard::reset();
+        Serial.println(F("Heap counters reset"));
+    } else if (strcmp(args, "assert on") == 0 || strcmp(args, "assert off") == 0) {
+        HeapGuard::setAssert(strcmp(args, "assert on") == 0);
+        Serial.printf("Heap assert %s\r\n", HeapGuard::getAssert() ? "on" : "off");
+    } else {
+        HeapGuard::printReport();
+        MemPlacement::printReport();
+    }
+}
+
+// Console: "history" prints the frame history, "history <n>" dumps the frame
+// n frames back, "history replay <seconds>" sends the last seconds to the
+// radio again and "history stop" ends a replay
+void historyCommand(const char* args) {
+    unsigned long value = 0;
+    if (args[0] == '\0') {
+        FrameHistory::printStatus();
+    } else if (sscanf(args, "replay %lu", &value) == 1) {
+        Serial.println(FrameHistory::startReplay(value) ? F("Replaying") : F("Nothing to replay"));
+    } else if (strcmp(args, "stop") == 0) {
+        FrameHistory::stopReplay();
+        Serial.println(F("Stopped"));
+    } else if (sscanf(args, "%lu", &value) == 1) {
+        FrameHistory::printFrame(value);
+    } else {
+        Serial.println(F("Usage: history [<n> | replay <seconds> | stop]"));
+    }
+}
+
+// Control socket: "PROFILE <n>" switches profile and is answered with
+// "OK <n>" or "ERR". "STATS" answers with the receive counters as key=value
+// pairs and "STATS RESET" clears them (tools/sacn_load reads these). Runs in
+// the network task.
+void handleControlCommand(const char* command) {
+    int slot = 0;
+    if (sscanf(command, "PROFILE %d", &slot) == 1 && ProfileStore::activate(slot - 1)) {
+        char reply[16];
+        snprintf(reply, sizeof(reply), "OK %d", slot);
+        eth.replyControl(reply);
+    } else if (strcmp(command, "STATS RESET") == 0) {
+        eth.resetRxStats();
+        eth.replyControl("OK");
+    } else if (strcmp(command, "STATS") == 0) {
+        const E131RxStats& stats = eth.getRxStats();
+        char reply[256];
+        snprintf(reply, sizeof(reply),
+                 "STATS ms=%lu datagrams=%lu frames=%lu lost=%lu late=%lu short=%lu notdata=%lu "
+                 "universe=%lu startcode=%lu count=%lu sources=%lu",
+                 millis() - stats.sinceMs, (unsigned long)stats.datagrams, (unsigned long)stats.frames,
+                 (unsigned long)stats.sequenceLost, (unsigned long)stats.outOfOrder,
+                 (unsigned long)stats.tooShort, (unsigned long)stats.notData,
+                 (unsigned long)stats.otherUniverse, (unsigned long)stats.badStartCode,
+                 (unsigned long)stats.badValueCount, (unsigned long)stats.sources);
+        eth.replyControl(reply);
+    } else {
+        LOG_WARN_TAG("NET", "Rejected control command: %s", command);
+        eth.replyControl("ERR");
+    }
 }
 
 // --- CORE 0: Network ---
 void networkLoop(void * parameter) {
-    uint8_t localDmxBuffer[DMX_MAX_CHANNELS]; 
+    char controlCommand[CONTROL_MAX_PACKET];
+    unsigned long lastControlPoll = 0;
     
     // Note: We use static MAC, but IP is loaded from config
     byte mac[] = DEFAULT_MAC;
-    IPAddress currentIP(deviceConfig.ipAddress);
+    DeviceConfig bootConfig = configSvc.get();
+    IPAddress currentIP(bootConfig.ipAddress);
 
+    // This task is the only expected user of the W5500
+    EthBus::setOwner(xTaskGetCurrentTaskHandle());
     eth.begin(mac, currentIP);
-    eth.setUniverse(deviceConfig.universe);
-    radio.begin();
+    radio.begin(bootConfig.radioChannel);
+
+    // The radio is driven from this task too, so the watchdog covers a
+    // blocked UART as well as a wedged W5500
+    esp_task_wdt_add(NULL);
+    bool lastLinkUp = false;
+    uint32_t pipelineGeneration = 0;
+
+    // Set-up done; from here on this task must not touch the heap
+    HeapGuard::watchCurrentTask();
 
     for(;;) {
-        if (eth.checkHardware()) {
+        esp_task_wdt_reset();
+
+        // One snapshot per iteration, so a config change lands on a frame boundary
+        const PipelineConfig* pipe = Pipeline::acquire();
+        if (pipe->generation != pipelineGeneration) {
+            pipelineGeneration = pipe->generation;
+            eth.setUniverse(pipe->universe);
+            // Retunes from radio.poll() without blocking this loop; frames
+            // are dropped until the module is back, so the first frame of
+            // the new profile on air is also the first on the new channel
+            radio.setChannel(pipe->radioChannel);
+        }
+
+        bool linkUp = eth.checkHardware();
+        if (linkUp != lastLinkUp) {
+            lastLinkUp = linkUp;
+            notifyDisplay(DISPLAY_EVT_STATUS);
+        }
+
+        if (linkUp) {
             int len = eth.parsePacket(localDmxBuffer);
             if (len > 0) {
-                // Determine LEDs to send based on Config
-                int bytesToSend = CHAN_PER_LED * deviceConfig.numLeds;
-                if (bytesToSend > len) bytesToSend = len; 
+                uint16_t bytesToSend = Pipeline::process(*pipe, localDmxBuffer, len, radioBuffer);
+                TRACE_MARK(TRACE_PROCESSED);
                 
-                radio.sendDmxPacket(localDmxBuffer, bytesToSend);
-
-                memcpy(sharedDmxData, localDmxBuffer, len);
-                lastPacketTime = millis();
+                // A replay owns the radio until it ends
+                if (FrameHistory::isReplaying()) {
+                    TRACE_ABORT_FRAME();
+                } else if (radio.sendDmxPacket(radioBuffer, bytesToSend)) {
+                    // Only frames that went on air; none during a retune
+                    FrameHistory::record(radioBuffer, bytesToSend, millis());
+                    LiveFrame::publish(radioBuffer, bytesToSend);
+                }
+                unsigned long now = millis();
+                if (lastPacketTime == 0 || now - lastPacketTime >= E131_ACTIVE_TIMEOUT_MS) {
+                    notifyDisplay(DISPLAY_EVT_STATUS);   // IDLE/CONNECTED -> ACTIVE
+                }
+                lastPacketTime = now;
                 packetReceived = true;
                 
                 neopixelWrite(NEOPIXEL, localDmxBuffer[0], localDmxBuffer[1], localDmxBuffer[2]);
             }
+            uint16_t replayLength = FrameHistory::replayNext(millis(), radioBuffer);
+            if (replayLength > 0 && radio.sendDmxPacket(radioBuffer, replayLength)) {
+                LiveFrame::publish(radioBuffer, replayLength);
+            }
+            radio.poll();
+            LiveFrame::tick(eth.getPacketCount());
+            Pipeline::release();
+
+            // A profile switch published here is picked up next iteration
+            if (millis() - lastControlPoll >= CONTROL_POLL_MS) {
+                lastControlPoll = millis();
+                if (eth.readControl(controlCommand, sizeof(controlCommand)) > 0) {
+                    handleControlCommand(controlCommand);
+                }
+            }
             vTaskDelay(1);
         } else {
+            Pipeline::release();
+            radio.poll();   // A retune still finishes, and SET goes back high
             vTaskDelay(100); 
         }        
     }
@@ -69,43 +280,57 @@ void networkLoop(void * parameter) {
 
 // --- CORE 1: Buttons ---
 void buttonInputLoop(void * parameter) {
-    int pins[] = {BTN_UP, BTN_DOWN, BTN_LEFT, BTN_RIGHT, BTN_SEL};
-    int lastState[] = {HIGH, HIGH, HIGH, HIGH, HIGH};
+    ButtonEvent event;
 
     for(;;) {
-        for(int i=0; i<5; i++) {
-            int read = digitalRead(pins[i]);
-            if(read == LOW && lastState[i] == HIGH) {
-                // Button Pressed
-                displayMgr.handleButtonPress(pins[i], deviceConfig, saveConfigCallback);
+        // Blocks until a debounced press or an auto-repeat
+        if (ButtonInput::waitForEvent(event)) {
+            // Edits apply to the staged copy; SEL publishes it via saveConfigCallback.
+            // The guard keeps a PROFILE from the network out until it's staged.
+            {
+                ConfigService::EditGuard guard(configSvc);
+                uint32_t generation;
+                DeviceConfig edit = configSvc.getStaged(&generation);
+                displayMgr.handleButtonPress(event.pin, event.step, edit, saveConfigCallback);
+                // A profile picked from the menu staged its own copy; keep it
+                configSvc.stageIf(edit, generation);
             }
-            lastState[i] = read;
+            notifyDisplay(DISPLAY_EVT_BUTTON);
+        } else {
+            vTaskDelay(1000);
         }
-        vTaskDelay(50); // Debounce
     }
 }
 
 // --- CORE 1: Display ---
+E131Status currentNetStatus() {
+    if (!eth.isLinkUp()) return STATUS_DISCONNECTED;
+    if (lastPacketTime == 0) return STATUS_CONNECTED;
+    if (millis() - lastPacketTime < E131_ACTIVE_TIMEOUT_MS) return STATUS_ACTIVE;
+    return STATUS_IDLE;
+}
+
 void displayLoop(void * parameter) {
+    HeapGuard::watchCurrentTask();
+
     for (;;) {
-        vTaskDelay(100); // 10 FPS
-
-        // Determine Status
-        E131Status status = STATUS_DISCONNECTED;
-        if (Ethernet.linkStatus() == LinkON) {
-            if (millis() - lastPacketTime < 2500) {
-                status = STATUS_ACTIVE;
-            } else if (lastPacketTime > 0) { 
-                status = STATUS_IDLE; 
-            } else {
-                status = STATUS_CONNECTED;
-            }
-        } else {
-            status = STATUS_DISCONNECTED;
-        }
+        E131Status status = currentNetStatus();
+        // Edit screens show the staged values; published and staged only
+        // differ while an edit is in progress
+        DeviceConfig config = configSvc.getStaged();
+        IPAddress currentIP(configSvc.get().ipAddress);
+        displayMgr.render(config, currentIP, status);
 
-        IPAddress currentIP(deviceConfig.ipAddress);
-        displayMgr.render(deviceConfig, currentIP, status);
+        // Sleep until an event arrives or a timed transition is due: the
+        // next slideshow page or preview refresh, or ACTIVE dropping to IDLE
+        uint32_t waitMs = displayMgr.msUntilNextUpdate();
+        if (status == STATUS_ACTIVE) {
+            uint32_t sincePacket = millis() - lastPacketTime;
+            uint32_t untilIdle = sincePacket < E131_ACTIVE_TIMEOUT_MS ? E131_ACTIVE_TIMEOUT_MS - sincePacket : 0;
+            waitMs = min(waitMs, untilIdle);
+        }
+        xTaskNotifyWait(0, UINT32_MAX, NULL,
+                        waitMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(waitMs) + 1);
     }
 }
 
@@ -124,28 +349,75 @@ void setup() {
     // 2. Config
     LOG_INFO_TAG("SYSTEM", "Initializing configuration...");
     configMgr.begin();
-    configMgr.loadConfig(deviceConfig);
+    DeviceConfig loadedConfig;
+    configMgr.loadConfig(loadedConfig);
+    configSvc.begin(loadedConfig);
+    configSvc.setApplyCallback(applyConfigCallback);
+    Pipeline::rebuild(loadedConfig);
+    ProfileStore::begin(configMgr, configSvc);
 
     // 3. Buttons
-    pinMode(BTN_UP, INPUT_PULLUP);
-    pinMode(BTN_DOWN, INPUT_PULLUP);
-    pinMode(BTN_LEFT, INPUT_PULLUP);
-    pinMode(BTN_RIGHT, INPUT_PULLUP);
-    pinMode(BTN_SEL, INPUT_PULLUP);
+    ButtonInput::begin();
 
     // 4. Display
     LOG_INFO_TAG("SYSTEM", "Initializing display...");
     displayMgr.begin();
 
-    // 5. Tasks
+    // 5. Frame history (PSRAM)
+    FrameHistory::begin();
+
+    // 6. Serial console
+    SerialConsole::begin();
+    SerialConsole::registerCommand("latency", "Frame latency percentiles", [](const char*) { LatencyTrace::dumpPercentiles(); });
+    SerialConsole::registerCommand("latreset", "Clear latency trace ring", [](const char*) { LatencyTrace::reset(); });
+    SerialConsole::registerCommand("tasks", "Per-task CPU and stack usage", [](const char*) { TaskMonitor::printReport(); });
+    SerialConsole::registerCommand("recovery", "W5500 recovery events", [](const char*) { eth.printRecoveryLog(); });
+    SerialConsole::registerCommand("netstats", "E1.31 receive counters [reset]", netstatsCommand);
+    SerialConsole::registerCommand("ethbus", "W5500 bus contention counters", [](const char*) {
+        Serial.printf("EthBus contention: %lu, foreign access: %lu\r\n",
+                      (unsigned long)EthBus::getContentionCount(), (unsigned long)EthBus::getForeignAccessCount());
+    });
+    SerialConsole::registerCommand("radio", "HC-12 channel and retune counters", [](const char*) {
+        Serial.printf("HC-12 channel: %u (requested %u%s), channel failures: %lu, frames dropped retuning: %lu\r\n",
+                      radio.getChannel(), radio.getRequestedChannel(), radio.isRetuning() ? ", retuning" : "",
+                      (unsigned long)radio.getChannelFailures(), (unsigned long)radio.getDroppedFrames());
+    });
+    SerialConsole::registerCommand("display", "OLED render statistics", [](const char*) { displayMgr.printStats(); });
+    SerialConsole::registerCommand("cfgsave", "Commit pending config to flash now", [](const char*) {
+        configSvc.flush();
+        Serial.printf("Config commits: %lu, skipped (unchanged): %lu, failed: %lu\r\n",
+                      (unsigned long)configSvc.getCommitCount(), (unsigned long)configSvc.getSkippedCount(),
+                      (unsigned long)configSvc.getFailedCount());
+    });
+    SerialConsole::registerCommand("profile", "List/switch/save show profiles", profileCommand);
+    SerialConsole::registerCommand("logstats", "Logger statistics", [](const char*) { Logger::printStats(); });
+    SerialConsole::registerCommand("errors", "Recent errors/warnings", [](const char*) { Logger::dumpRecentErrors(); });
+    SerialConsole::registerCommand("bench", "Hot-path benchmarks [json] [filter]", benchCommand);
+    SerialConsole::registerCommand("heap", "Heap watermarks and allocations [reset|assert on|off]", heapCommand);
+    SerialConsole::registerCommand("history", "Frame history [<n>|replay <s>|stop]", historyCommand);
+
+    // 7. Tasks
     LOG_INFO_TAG("SYSTEM", "Creating FreeRTOS tasks...");
-    xTaskCreatePinnedToCore(networkLoop, "NetTask", 10000, NULL, 1, &NetworkTaskHandle, 0);
+    esp_task_wdt_init(NET_WDT_TIMEOUT_S, true);
+    xTaskCreatePinnedToCore(networkLoop, "NetTask", NET_TASK_STACK, NULL, 1, &NetworkTaskHandle, 0);
     LOG_INFO_TAG("SYSTEM", "Network task created on Core 0");
-    xTaskCreatePinnedToCore(displayLoop, "DispTask", 10000, NULL, 1, &DisplayTaskHandle, 1);
+    xTaskCreatePinnedToCore(displayLoop, "DispTask", DISP_TASK_STACK, NULL, 1, &DisplayTaskHandle, 1);
     LOG_INFO_TAG("SYSTEM", "Display task created on Core 1");
-    xTaskCreatePinnedToCore(buttonInputLoop, "InTask", 4096, NULL, 1, &InputTaskHandle, 1);
+    xTaskCreatePinnedToCore(buttonInputLoop, "InTask", INPUT_TASK_STACK, NULL, 1, &InputTaskHandle, 1);
     LOG_INFO_TAG("SYSTEM", "Input task created on Core 1");
+
+    TaskMonitor::watch(NetworkTaskHandle, NET_TASK_STACK);
+    TaskMonitor::watch(DisplayTaskHandle, DISP_TASK_STACK);
+    TaskMonitor::watch(InputTaskHandle, INPUT_TASK_STACK);
+    TaskMonitor::setSampleCallback([]() { notifyDisplay(DISPLAY_EVT_METRICS); });
+    TaskMonitor::begin();
+
+    // Everything is allocated; count what the steady state still allocates
+    HeapGuard::arm();
     LOG_INFO_TAG("SYSTEM", "=== System Ready ===");
 }
 
-void loop() {}
+void loop() {
+    SerialConsole::poll();
+    vTaskDelay(20);
+}
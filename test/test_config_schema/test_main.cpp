@@ -0,0 +1,234 @@
+#include <unity.h>
+#include <string.h>
+#include "ConfigSchema.h"
+
+// Host-side tests for the versioned config record: round trip, integrity
+// checks, and upgrade from every prior schema version.
+
+static DeviceConfig makeConfig() {
+    DeviceConfig config;
+    ConfigSchema::applyDefaults(config);
+    config.universe = 4242;
+    config.numLeds = 37;
+    config.ipAddress = ConfigSchema::packIp(10, 0, 0, 7);
+    config.useDhcp = true;
+    config.radioChannel = 12;
+    return config;
+}
+
+static size_t encodeRecord(const DeviceConfig& config, uint8_t* out) {
+    size_t size = ConfigSchema::encode(config, out, CONFIG_RECORD_MAX_SIZE);
+    TEST_ASSERT_GREATER_THAN(0, size);
+    return size;
+}
+
+// Build a record around an arbitrary payload, as an older firmware would have
+static size_t buildRecord(uint16_t version, const void* payload, uint16_t length, uint8_t* out) {
+    ConfigRecordHeader header;
+    header.magic = CONFIG_RECORD_MAGIC;
+    header.version = version;
+    header.length = length;
+    header.crc = ConfigSchema::crc32((const uint8_t*)payload, length);
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), payload, length);
+    return sizeof(header) + length;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_defaults_fill_every_field(void) {
+    DeviceConfig config;
+    memset(&config, 0xA5, sizeof(config));
+    ConfigSchema::applyDefaults(config);
+
+    TEST_ASSERT_EQUAL_UINT16(DEFAULT_UNIVERSE, config.universe);
+    TEST_ASSERT_EQUAL_UINT16(DEFAULT_NUM_LEDS, config.numLeds);
+    TEST_ASSERT_EQUAL_UINT32(ConfigSchema::packIp(DEFAULT_IP), config.ipAddress);
+    TEST_ASSERT_EQUAL(DEFAULT_DHCP_STATUS, config.useDhcp);
+    TEST_ASSERT_EQUAL_UINT8(DEFAULT_RADIO_CHANNEL, config.radioChannel);
+}
+
+void test_equal_ignores_padding(void) {
+    DeviceConfig a;
+    DeviceConfig b;
+    memset(&a, 0x00, sizeof(a));
+    memset(&b, 0xFF, sizeof(b));
+    ConfigSchema::applyDefaults(a);
+    b.universe = a.universe;
+    b.numLeds = a.numLeds;
+    b.ipAddress = a.ipAddress;
+    b.useDhcp = a.useDhcp;
+    b.radioChannel = a.radioChannel;
+    TEST_ASSERT_TRUE(ConfigSchema::equal(a, b));
+
+    b.radioChannel++;
+    TEST_ASSERT_FALSE(ConfigSchema::equal(a, b));
+}
+
+void test_crc32_matches_reference_vector(void) {
+    const char* check = "123456789";
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926u, ConfigSchema::crc32((const uint8_t*)check, 9));
+}
+
+void test_current_version_round_trip(void) {
+    DeviceConfig in = makeConfig();
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = encodeRecord(in, record);
+
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_OK, ConfigSchema::decode(record, size, out));
+    TEST_ASSERT_EQUAL_MEMORY(&in, &out, sizeof(DeviceConfig));
+}
+
+void test_encode_rejects_small_buffer(void) {
+    DeviceConfig config = makeConfig();
+    uint8_t record[sizeof(ConfigRecordHeader)];
+    TEST_ASSERT_EQUAL(0, ConfigSchema::encode(config, record, sizeof(record)));
+}
+
+void test_corrupt_payload_fails_crc(void) {
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = encodeRecord(makeConfig(), record);
+    record[size - 1] ^= 0x01;
+
+    DeviceConfig out = makeConfig();
+    out.universe = 1;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_BAD_CRC, ConfigSchema::decode(record, size, out));
+    TEST_ASSERT_EQUAL_UINT16(1, out.universe);   // Untouched on failure
+}
+
+void test_bad_magic_rejected(void) {
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = encodeRecord(makeConfig(), record);
+    record[0] ^= 0xFF;
+
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_BAD_MAGIC, ConfigSchema::decode(record, size, out));
+}
+
+void test_truncated_record_rejected(void) {
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = encodeRecord(makeConfig(), record);
+
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_BAD_LENGTH, ConfigSchema::decode(record, size - 1, out));
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_BAD_LENGTH, ConfigSchema::decode(record, sizeof(ConfigRecordHeader) - 1, out));
+}
+
+void test_future_version_rejected(void) {
+    DeviceConfig config = makeConfig();
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = buildRecord(CONFIG_SCHEMA_VERSION + 1, &config, sizeof(config), record);
+
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_UNSUPPORTED_VERSION, ConfigSchema::decode(record, size, out));
+}
+
+// A newer firmware's record must read as unsupported, not corrupt, even when
+// its payload has grown, so the loader knows to keep it
+void test_future_version_not_reported_corrupt(void) {
+    uint8_t payload[CONFIG_RECORD_MAX_PAYLOAD];
+    memset(payload, 0x5A, sizeof(payload));
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = buildRecord(CONFIG_SCHEMA_VERSION + 1, payload, sizeof(payload), record);
+
+    DeviceConfig out;
+    ConfigLoadStatus status = ConfigSchema::decode(record, size, out);
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_UNSUPPORTED_VERSION, status);
+    TEST_ASSERT_NOT_EQUAL(CONFIG_LOAD_BAD_LENGTH, status);
+    TEST_ASSERT_NOT_EQUAL(CONFIG_LOAD_BAD_CRC, status);
+}
+
+void test_version_zero_rejected(void) {
+    DeviceConfig config = makeConfig();
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = buildRecord(0, &config, sizeof(config), record);
+
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_UNSUPPORTED_VERSION, ConfigSchema::decode(record, size, out));
+}
+
+// --- Upgrades from every prior version ---
+
+static DeviceConfigV1 makeV1() {
+    DeviceConfigV1 v1;
+    memset(&v1, 0, sizeof(v1));
+    v1.universe = 129;
+    v1.numLeds = 25;
+    v1.ipAddress = ConfigSchema::packIp(192, 168, 1, 50);
+    v1.useDhcp = false;
+    return v1;
+}
+
+void test_upgrade_from_v1_legacy_blob(void) {
+    DeviceConfigV1 v1 = makeV1();
+
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_MIGRATED, ConfigSchema::decodeLegacy((const uint8_t*)&v1, sizeof(v1), out));
+    TEST_ASSERT_EQUAL_UINT16(129, out.universe);
+    TEST_ASSERT_EQUAL_UINT16(25, out.numLeds);
+    TEST_ASSERT_EQUAL_UINT32(v1.ipAddress, out.ipAddress);
+    TEST_ASSERT_FALSE(out.useDhcp);
+    TEST_ASSERT_EQUAL_UINT8(DEFAULT_RADIO_CHANNEL, out.radioChannel);
+}
+
+void test_upgrade_from_v1_record(void) {
+    DeviceConfigV1 v1 = makeV1();
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    size_t size = buildRecord(1, &v1, sizeof(v1), record);
+
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_MIGRATED, ConfigSchema::decode(record, size, out));
+    TEST_ASSERT_EQUAL_UINT16(129, out.universe);
+    TEST_ASSERT_EQUAL_UINT8(DEFAULT_RADIO_CHANNEL, out.radioChannel);
+}
+
+void test_upgrade_sanitizes_out_of_range_v1(void) {
+    // Old firmware never set numLeds, so legacy blobs can hold garbage
+    DeviceConfigV1 v1 = makeV1();
+    v1.numLeds = 0xBEEF;
+    v1.universe = 0;
+
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_MIGRATED, ConfigSchema::decodeLegacy((const uint8_t*)&v1, sizeof(v1), out));
+    TEST_ASSERT_EQUAL_UINT16(MAX_NUM_LEDS, out.numLeds);
+    TEST_ASSERT_EQUAL_UINT16(MIN_UNIVERSE, out.universe);
+}
+
+void test_legacy_blob_wrong_size_rejected(void) {
+    DeviceConfigV1 v1 = makeV1();
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_BAD_LENGTH, ConfigSchema::decodeLegacy((const uint8_t*)&v1, sizeof(v1) - 1, out));
+}
+
+void test_v1_record_with_wrong_payload_size_rejected(void) {
+    uint8_t payload[sizeof(DeviceConfigV1) + 4] = {};
+    uint8_t record[CONFIG_RECORD_MAX_SIZE];
+    // Claims v1 but carries a longer payload
+    size_t size = buildRecord(1, payload, sizeof(payload), record);
+
+    DeviceConfig out;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_BAD_LENGTH, ConfigSchema::decode(record, size, out));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_defaults_fill_every_field);
+    RUN_TEST(test_equal_ignores_padding);
+    RUN_TEST(test_crc32_matches_reference_vector);
+    RUN_TEST(test_current_version_round_trip);
+    RUN_TEST(test_encode_rejects_small_buffer);
+    RUN_TEST(test_corrupt_payload_fails_crc);
+    RUN_TEST(test_bad_magic_rejected);
+    RUN_TEST(test_truncated_record_rejected);
+    RUN_TEST(test_future_version_rejected);
+    RUN_TEST(test_future_version_not_reported_corrupt);
+    RUN_TEST(test_version_zero_rejected);
+    RUN_TEST(test_upgrade_from_v1_legacy_blob);
+    RUN_TEST(test_upgrade_from_v1_record);
+    RUN_TEST(test_upgrade_sanitizes_out_of_range_v1);
+    RUN_TEST(test_legacy_blob_wrong_size_rejected);
+    RUN_TEST(test_v1_record_with_wrong_payload_size_rejected);
+    return UNITY_END();
+}
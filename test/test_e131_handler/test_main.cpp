@@ -0,0 +1,483 @@
+#include <unity.h>
+#include <string.h>
+#include <HostShims.h>
+#include "E131Handler.h"
+
+// E131Handler::parsePacket() against the fake W5500: valid frames, each
+// malformed header field, lengths that disagree with the datagram, universe
+// filtering, and the receive counters.
+
+#define TEST_UNIVERSE 7
+#define GUARD_BYTE 0xEE
+
+static E131Handler* eth;
+static uint8_t dmx[DMX_MAX_CHANNELS + 16];
+
+// A well-formed E1.31 data packet carrying `slots` DMX values (i + 1)
+static size_t buildPacket(uint8_t* out, uint16_t universe, uint16_t slots) {
+    static const uint8_t acnId[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+    size_t size = E131_HEADER_SIZE + slots;
+    memset(out, 0, size);
+
+    // Root layer
+    out[1] = 0x10;
+    memcpy(out + E131_ACN_ID_OFFSET, acnId, sizeof(acnId));
+    uint16_t rootLength = 0x7000 | (size - 16);
+    out[16] = rootLength >> 8;
+    out[17] = rootLength & 0xFF;
+    out[E131_ROOT_VECTOR_OFFSET + 3] = 0x04;
+
+    // Framing layer
+    uint16_t framingLength = 0x7000 | (size - 38);
+    out[38] = framingLength >> 8;
+    out[39] = framingLength & 0xFF;
+    out[E131_FRAMING_VECTOR_OFFSET + 3] = 0x02;
+    strcpy((char*)out + 44, "unit test");
+    out[108] = 100;
+    out[E131_UNIVERSE_OFFSET] = universe >> 8;
+    out[E131_UNIVERSE_OFFSET + 1] = universe & 0xFF;
+
+    // DMP layer
+    uint16_t dmpLength = 0x7000 | (size - 115);
+    out[115] = dmpLength >> 8;
+    out[116] = dmpLength & 0xFF;
+    out[E131_DMP_VECTOR_OFFSET] = 0x02;
+    out[118] = 0xA1;
+    out[122] = 0x01;
+    uint16_t valueCount = slots + 1;
+    out[E131_LENGTH_OFFSET] = valueCount >> 8;
+    out[E131_LENGTH_OFFSET + 1] = valueCount & 0xFF;
+    out[E131_HEADER_SIZE - 1] = DMX_STARTCODE;
+
+    for (uint16_t i = 0; i < slots; i++) {
+        out[E131_HEADER_SIZE + i] = (uint8_t)(i + 1);
+    }
+    return size;
+}
+
+static void setValueCount(uint8_t* packet, uint16_t count) {
+    packet[E131_LENGTH_OFFSET] = count >> 8;
+    packet[E131_LENGTH_OFFSET + 1] = count & 0xFF;
+}
+
+static void inject(const uint8_t* packet, size_t size) {
+    TEST_ASSERT_TRUE(HostNet::inject(E131_PORT, packet, size));
+}
+
+// Inject and parse one frame from source `cid` with `sequence`
+static void receiveSequence(uint8_t cid, uint8_t sequence) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 4);
+    packet[E131_CID_OFFSET + 15] = cid;
+    packet[E131_SEQUENCE_OFFSET] = sequence;
+    inject(packet, size);
+    TEST_ASSERT_EQUAL_INT(4, eth->parsePacket(dmx));
+}
+
+// Nothing past `len` may be written
+static void assertUntouchedFrom(size_t len) {
+    for (size_t i = len; i < sizeof(dmx); i++) {
+        TEST_ASSERT_EQUAL_HEX8(GUARD_BYTE, dmx[i]);
+    }
+}
+
+void setUp(void) {
+    HostNet::reset();
+    memset(dmx, GUARD_BYTE, sizeof(dmx));
+
+    static byte mac[] = DEFAULT_MAC;
+    eth = new E131Handler();
+    eth->begin(mac, IPAddress(DEFAULT_IP));
+    eth->setUniverse(TEST_UNIVERSE);
+}
+
+void tearDown(void) {
+    delete eth;
+    eth = nullptr;
+}
+
+void test_no_packet_returns_zero(void) {
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getPacketCount());
+}
+
+void test_valid_frame_copies_payload(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    inject(packet, buildPacket(packet, TEST_UNIVERSE, 30));
+
+    TEST_ASSERT_EQUAL_INT(30, eth->parsePacket(dmx));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(packet + E131_HEADER_SIZE, dmx, 30);
+    assertUntouchedFrom(30);
+}
+
+void test_full_universe(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    inject(packet, buildPacket(packet, TEST_UNIVERSE, DMX_MAX_CHANNELS));
+
+    TEST_ASSERT_EQUAL_INT(DMX_MAX_CHANNELS, eth->parsePacket(dmx));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(packet + E131_HEADER_SIZE, dmx, DMX_MAX_CHANNELS);
+    assertUntouchedFrom(DMX_MAX_CHANNELS);
+}
+
+void test_consecutive_frames_are_independent(void) {
+    uint8_t first[E131_MAX_PACKET_SIZE];
+    uint8_t second[E131_MAX_PACKET_SIZE];
+    inject(first, buildPacket(first, TEST_UNIVERSE, 100));
+    size_t size = buildPacket(second, TEST_UNIVERSE, 10);
+    memset(second + E131_HEADER_SIZE, 0x55, 10);
+    inject(second, size);
+
+    TEST_ASSERT_EQUAL_INT(100, eth->parsePacket(dmx));
+    TEST_ASSERT_EQUAL_INT(10, eth->parsePacket(dmx));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(second + E131_HEADER_SIZE, dmx, 10);
+    TEST_ASSERT_EQUAL_UINT32(2, eth->getPacketCount());
+}
+
+void test_other_universe_is_filtered(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    inject(packet, buildPacket(packet, TEST_UNIVERSE + 1, 30));
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+    assertUntouchedFrom(0);
+    // Counted even though it was filtered
+    TEST_ASSERT_EQUAL_UINT32(1, eth->getPacketCount());
+}
+
+void test_set_universe_changes_filter(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, 300, 8);
+    inject(packet, size);
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+
+    eth->setUniverse(300);
+    inject(packet, size);
+    TEST_ASSERT_EQUAL_INT(8, eth->parsePacket(dmx));
+}
+
+void test_packet_shorter_than_header(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    buildPacket(packet, TEST_UNIVERSE, 0);
+    inject(packet, E131_HEADER_SIZE - 1);
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+    assertUntouchedFrom(0);
+}
+
+void test_bad_acn_identifier(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 30);
+    packet[E131_ACN_ID_OFFSET] = 'X';
+    inject(packet, size);
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+    assertUntouchedFrom(0);
+}
+
+void test_bad_root_vector(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 30);
+    packet[E131_ROOT_VECTOR_OFFSET + 3] = 0x08;   // Extended (sync/discovery)
+    inject(packet, size);
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+}
+
+void test_bad_framing_vector(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 30);
+    packet[E131_FRAMING_VECTOR_OFFSET + 3] = 0x01;
+    inject(packet, size);
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+}
+
+void test_bad_dmp_vector(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 30);
+    packet[E131_DMP_VECTOR_OFFSET] = 0x01;
+    inject(packet, size);
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+}
+
+void test_non_zero_start_code(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 30);
+    packet[E131_HEADER_SIZE - 1] = 0xDD;   // Per-address priority
+    inject(packet, size);
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+    assertUntouchedFrom(0);
+}
+
+void test_value_count_zero_does_not_underflow(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 30);
+    setValueCount(packet, 0);
+    inject(packet, size);
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+    assertUntouchedFrom(0);
+}
+
+void test_value_count_one_is_empty_frame(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    inject(packet, buildPacket(packet, TEST_UNIVERSE, 0));
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+    assertUntouchedFrom(0);
+}
+
+void test_value_count_beyond_datagram_is_clamped(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 20);
+    setValueCount(packet, 201);
+    inject(packet, size);
+
+    TEST_ASSERT_EQUAL_INT(20, eth->parsePacket(dmx));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(packet + E131_HEADER_SIZE, dmx, 20);
+    assertUntouchedFrom(20);
+}
+
+void test_value_count_beyond_universe_is_clamped(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE + 8];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, DMX_MAX_CHANNELS);
+    packet[size] = 0xAB;   // Junk trailing the universe
+    setValueCount(packet, 0xFFFF);
+    inject(packet, size + 1);
+
+    TEST_ASSERT_EQUAL_INT(DMX_MAX_CHANNELS, eth->parsePacket(dmx));
+    assertUntouchedFrom(DMX_MAX_CHANNELS);
+}
+
+void test_header_only_datagram_with_claimed_payload(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    buildPacket(packet, TEST_UNIVERSE, DMX_MAX_CHANNELS);
+    inject(packet, E131_HEADER_SIZE);
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+    assertUntouchedFrom(0);
+}
+
+void test_shorter_value_count_ignores_trailing_bytes(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 50);
+    setValueCount(packet, 11);
+    inject(packet, size);
+
+    TEST_ASSERT_EQUAL_INT(10, eth->parsePacket(dmx));
+    assertUntouchedFrom(10);
+}
+
+void test_link_down_drops_traffic(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    HostNet::setLink(false);
+    TEST_ASSERT_FALSE(HostNet::inject(E131_PORT, packet, buildPacket(packet, TEST_UNIVERSE, 4)));
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+}
+
+void test_rx_stats_count_each_outcome(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, 8);
+    inject(packet, size);
+    eth->parsePacket(dmx);
+    inject(packet, E131_HEADER_SIZE - 1);
+    eth->parsePacket(dmx);
+
+    buildPacket(packet, TEST_UNIVERSE + 1, 8);
+    inject(packet, size);
+    eth->parsePacket(dmx);
+
+    buildPacket(packet, TEST_UNIVERSE, 8);
+    packet[E131_HEADER_SIZE - 1] = 0xDD;
+    inject(packet, size);
+    eth->parsePacket(dmx);
+
+    buildPacket(packet, TEST_UNIVERSE, 8);
+    setValueCount(packet, 0);
+    inject(packet, size);
+    eth->parsePacket(dmx);
+
+    buildPacket(packet, TEST_UNIVERSE, 8);
+    packet[E131_ACN_ID_OFFSET] = 'X';
+    inject(packet, size);
+    eth->parsePacket(dmx);
+
+    const E131RxStats& stats = eth->getRxStats();
+    TEST_ASSERT_EQUAL_UINT32(6, stats.datagrams);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.frames);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.tooShort);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.otherUniverse);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.badStartCode);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.badValueCount);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.notData);
+}
+
+void test_sequence_gap_counts_lost_frames(void) {
+    receiveSequence(1, 10);
+    receiveSequence(1, 11);
+    receiveSequence(1, 14);
+
+    TEST_ASSERT_EQUAL_UINT32(3, eth->getRxStats().frames);
+    TEST_ASSERT_EQUAL_UINT32(2, eth->getRxStats().sequenceLost);
+    TEST_ASSERT_EQUAL_UINT32(1, eth->getRxStats().sources);
+}
+
+void test_sequence_wraps_without_loss(void) {
+    receiveSequence(1, 254);
+    receiveSequence(1, 255);
+    receiveSequence(1, 0);
+    receiveSequence(1, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRxStats().sequenceLost);
+}
+
+void test_late_and_duplicate_frames_are_not_loss(void) {
+    receiveSequence(1, 10);
+    receiveSequence(1, 12);     // 11 lost...
+    receiveSequence(1, 11);     // ...or only late
+    receiveSequence(1, 12);     // Duplicate
+    receiveSequence(1, 13);
+
+    TEST_ASSERT_EQUAL_UINT32(1, eth->getRxStats().sequenceLost);
+    TEST_ASSERT_EQUAL_UINT32(2, eth->getRxStats().outOfOrder);
+}
+
+void test_restarted_source_is_not_loss(void) {
+    receiveSequence(1, 100);
+    receiveSequence(1, 0);      // Far behind: the sender restarted
+    receiveSequence(1, 1);
+
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRxStats().sequenceLost);
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRxStats().outOfOrder);
+}
+
+void test_sources_are_tracked_separately(void) {
+    for (uint8_t seq = 0; seq < 10; seq++) {
+        receiveSequence(1, seq);
+        receiveSequence(2, 100 + seq);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, eth->getRxStats().sources);
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRxStats().sequenceLost);
+
+    // More sources than slots: the least recently heard one is forgotten
+    for (uint8_t cid = 3; cid < 3 + E131_STATS_SOURCES; cid++) receiveSequence(cid, 0);
+    receiveSequence(1, 50);
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRxStats().sequenceLost);
+}
+
+void test_rx_stats_reset_at_next_parse(void) {
+    receiveSequence(1, 1);
+    receiveSequence(1, 5);
+    eth->resetRxStats();
+    TEST_ASSERT_EQUAL_UINT32(3, eth->getRxStats().sequenceLost);
+
+    TEST_ASSERT_EQUAL_INT(0, eth->parsePacket(dmx));
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRxStats().datagrams);
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRxStats().sequenceLost);
+    // Sequence history goes too, so the next frame is not a gap
+    receiveSequence(1, 9);
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRxStats().sequenceLost);
+}
+
+void test_full_socket_buffer_drops_datagrams(void) {
+    uint8_t packet[E131_MAX_PACKET_SIZE];
+    size_t size = buildPacket(packet, TEST_UNIVERSE, DMX_MAX_CHANNELS);
+
+    // Three full universes fit in the 2 KB buffer, a fourth does not
+    for (uint8_t i = 0; i < 3; i++) inject(packet, size);
+    TEST_ASSERT_FALSE(HostNet::inject(E131_PORT, packet, size));
+    TEST_ASSERT_EQUAL_size_t(3, HostNet::pending(E131_PORT));
+}
+
+// checkHardware() polls the chip again once the poll interval and the
+// recovery backoff have passed
+static bool pollHardwareAfter(uint32_t ms) {
+    HostClock::advance(ms);
+    return eth->checkHardware();
+}
+
+void test_dead_chip_triggers_no_hardware_recovery(void) {
+    TEST_ASSERT_TRUE(pollHardwareAfter(E131_RECOVERY_BACKOFF_MS));
+
+    // The library's cached status still claims a chip; the register read-back must not
+    HostNet::setHardwarePresent(false);
+    TEST_ASSERT_EQUAL(EthernetW5500, Ethernet.hardwareStatus());
+    TEST_ASSERT_FALSE(pollHardwareAfter(E131_RECOVERY_BACKOFF_MS));
+    TEST_ASSERT_FALSE(eth->status().hardwareOk);
+    TEST_ASSERT_EQUAL_UINT32(1, eth->getRecoveryCount());
+
+    // Power returns with the config lost; the next retry restores it
+    HostNet::setHardwarePresent(true);
+    TEST_ASSERT_TRUE(pollHardwareAfter(E131_RECOVERY_BACKOFF_MS));
+    TEST_ASSERT_TRUE(eth->status().hardwareOk);
+    TEST_ASSERT_EQUAL_UINT32(2, eth->getRecoveryCount());
+    TEST_ASSERT_EQUAL(IPAddress(DEFAULT_IP), Ethernet.localIP());
+    receiveSequence(1, 1);
+}
+
+void test_silence_on_healthy_chip_is_not_reset(void) {
+    receiveSequence(1, 1);
+    TEST_ASSERT_TRUE(pollHardwareAfter(E131_RX_STALL_MS));
+    TEST_ASSERT_TRUE(pollHardwareAfter(E131_RX_STALL_MS));
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRecoveryCount());
+    receiveSequence(1, 2);
+}
+
+void test_silence_with_socket_lost_triggers_recovery(void) {
+    receiveSequence(1, 1);
+    HostNet::closeSocket(E131_PORT);
+    TEST_ASSERT_TRUE(pollHardwareAfter(E131_RX_STALL_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, eth->getRecoveryCount());
+
+    // Disarmed until the next packet
+    TEST_ASSERT_TRUE(pollHardwareAfter(E131_RX_STALL_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, eth->getRecoveryCount());
+    receiveSequence(1, 2);
+}
+
+void test_link_down_is_not_a_stall(void) {
+    receiveSequence(1, 1);
+    HostNet::setLink(false);
+    TEST_ASSERT_FALSE(pollHardwareAfter(E131_RX_STALL_MS));
+    TEST_ASSERT_TRUE(eth->status().hardwareOk);
+    TEST_ASSERT_EQUAL_UINT32(0, eth->getRecoveryCount());
+}
+
+int main(int argc, char** argv) {
+    // Keep the log quiet; failures are reported by Unity
+    HostSerial::setEcho(0, false);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_no_packet_returns_zero);
+    RUN_TEST(test_valid_frame_copies_payload);
+    RUN_TEST(test_full_universe);
+    RUN_TEST(test_consecutive_frames_are_independent);
+    RUN_TEST(test_other_universe_is_filtered);
+    RUN_TEST(test_set_universe_changes_filter);
+    RUN_TEST(test_packet_shorter_than_header);
+    RUN_TEST(test_bad_acn_identifier);
+    RUN_TEST(test_bad_root_vector);
+    RUN_TEST(test_bad_framing_vector);
+    RUN_TEST(test_bad_dmp_vector);
+    RUN_TEST(test_non_zero_start_code);
+    RUN_TEST(test_value_count_zero_does_not_underflow);
+    RUN_TEST(test_value_count_one_is_empty_frame);
+    RUN_TEST(test_value_count_beyond_datagram_is_clamped);
+    RUN_TEST(test_value_count_beyond_universe_is_clamped);
+    RUN_TEST(test_header_only_datagram_with_claimed_payload);
+    RUN_TEST(test_shorter_value_count_ignores_trailing_bytes);
+    RUN_TEST(test_link_down_drops_traffic);
+    RUN_TEST(test_rx_stats_count_each_outcome);
+    RUN_TEST(test_sequence_gap_counts_lost_frames);
+    RUN_TEST(test_sequence_wraps_without_loss);
+    RUN_TEST(test_late_and_duplicate_frames_are_not_loss);
+    RUN_TEST(test_restarted_source_is_not_loss);
+    RUN_TEST(test_sources_are_tracked_separately);
+    RUN_TEST(test_rx_stats_reset_at_next_parse);
+    RUN_TEST(test_full_socket_buffer_drops_datagrams);
+    RUN_TEST(test_dead_chip_triggers_no_hardware_recovery);
+    RUN_TEST(test_silence_on_healthy_chip_is_not_reset);
+    RUN_TEST(test_silence_with_socket_lost_triggers_recovery);
+    RUN_TEST(test_link_down_is_not_a_stall);
+    return UNITY_END();
+}
@@ -0,0 +1,98 @@
+#include <unity.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <HostShims.h>
+#include <Ethernet.h>
+#include "EthBus.h"
+
+// The fake W5500's overlap detector: two threads hitting the chip without
+// EthBus are counted (and abort by default); the same accesses under
+// EthBus::Guard never overlap.
+
+#define HAMMER_ACCESSES 20000
+#define OVERLAP_TIMEOUT_MS 2000
+
+// Register reads on the fake chip from two threads, until `stop` or
+// `accesses` each
+static void hammer(bool guarded, uint32_t accesses, std::atomic<bool>& stop) {
+    auto body = [&]() {
+        for (uint32_t i = 0; i < accesses && !stop; i++) {
+            if (guarded) {
+                EthBus::Guard bus;
+                Ethernet.linkStatus();
+            } else {
+                Ethernet.linkStatus();
+            }
+        }
+    };
+    std::thread a(body);
+    std::thread b(body);
+    a.join();
+    b.join();
+}
+
+// Unguarded until the first overlap, or the timeout
+static void hammerUntilOverlap() {
+    std::atomic<bool> stop{false};
+    std::thread watchdog([&]() {
+        unsigned long start = millis();
+        while (HostNet::concurrentAccessCount() == 0 && millis() - start < OVERLAP_TIMEOUT_MS) delay(1);
+        stop = true;
+    });
+    hammer(false, UINT32_MAX, stop);
+    watchdog.join();
+}
+
+void setUp(void) {
+    HostNet::reset();
+    HostNet::setAbortOnConcurrentAccess(false);
+    EthBus::begin();
+}
+
+void tearDown(void) {
+    HostNet::setAbortOnConcurrentAccess(true);
+}
+
+void test_unguarded_overlap_is_counted(void) {
+    hammerUntilOverlap();
+    TEST_ASSERT_TRUE(HostNet::concurrentAccessCount() > 0);
+}
+
+void test_unguarded_overlap_aborts(void) {
+    fflush(stdout);
+    pid_t child = fork();
+    TEST_ASSERT_TRUE(child >= 0);
+    if (child == 0) {
+        // Keep the expected abort message out of the test output
+        freopen("/dev/null", "w", stderr);
+        HostNet::setAbortOnConcurrentAccess(true);
+        hammerUntilOverlap();
+        _exit(0);
+    }
+
+    int status = 0;
+    TEST_ASSERT_EQUAL(child, waitpid(child, &status, 0));
+    TEST_ASSERT_TRUE(WIFSIGNALED(status));
+    TEST_ASSERT_EQUAL_INT(SIGABRT, WTERMSIG(status));
+}
+
+void test_guarded_accesses_never_overlap(void) {
+    std::atomic<bool> stop{false};
+    hammer(true, HAMMER_ACCESSES, stop);
+    TEST_ASSERT_EQUAL_UINT32(2 * HAMMER_ACCESSES, HostNet::accessCount());
+    TEST_ASSERT_EQUAL_UINT32(0, HostNet::concurrentAccessCount());
+}
+
+int main(int argc, char** argv) {
+    // Keep the log quiet; failures are reported by Unity
+    HostSerial::setEcho(0, false);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_unguarded_overlap_is_counted);
+    RUN_TEST(test_unguarded_overlap_aborts);
+    RUN_TEST(test_guarded_accesses_never_overlap);
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+#include <unity.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <HostShims.h>
+#include "FrameHistory.h"
+#include "MemPlacement.h"
+
+// The frame history ring and its replay, on the host's stand-in PSRAM.
+// History state persists across tests, so each works relative to what the
+// previous ones recorded and uses timestamps later than theirs.
+
+#define FRAME_LENGTH 30
+
+static uint32_t clockMs = 1000;
+
+static void recordFrame(uint8_t tag, uint32_t ms) {
+    uint8_t data[FRAME_LENGTH];
+    memset(data, tag, sizeof(data));
+    FrameHistory::record(data, sizeof(data), ms);
+}
+
+// Record `count` frames `intervalMs` apart, tagged first, first+1, ...
+static void recordRun(uint8_t first, uint32_t count, uint32_t intervalMs) {
+    for (uint32_t i = 0; i < count; i++) {
+        clockMs += intervalMs;
+        recordFrame((uint8_t)(first + i), clockMs);
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_nothing_to_replay_before_recording(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, FrameHistory::getCount());
+    TEST_ASSERT_FALSE(FrameHistory::startReplay(5));
+    TEST_ASSERT_FALSE(FrameHistory::isReplaying());
+}
+
+void test_history_is_placed_in_psram(void) {
+    TEST_ASSERT_TRUE(FrameHistory::begin());
+    TEST_ASSERT_EQUAL_UINT32(FRAME_HISTORY_FRAMES, FrameHistory::getCapacity());
+    TEST_ASSERT_TRUE(MemPlacement::hasPsram());
+
+    void* hot = MemPlacement::allocate("test hot", 256, MEM_HOT);
+    TEST_ASSERT_NOT_NULL(hot);
+    TEST_ASSERT_FALSE(MemPlacement::inPsram(hot));
+}
+
+void test_get_returns_frames_newest_first(void) {
+    recordRun(10, 3, 25);
+    uint8_t out[MAX_NUM_LEDS * CHAN_PER_LED];
+    uint32_t ms = 0;
+
+    TEST_ASSERT_EQUAL_UINT16(FRAME_LENGTH, FrameHistory::get(0, out, &ms));
+    TEST_ASSERT_EQUAL_UINT8(12, out[0]);
+    TEST_ASSERT_EQUAL_UINT32(clockMs, ms);
+    TEST_ASSERT_EQUAL_UINT16(FRAME_LENGTH, FrameHistory::get(2, out, &ms));
+    TEST_ASSERT_EQUAL_UINT8(10, out[FRAME_LENGTH - 1]);
+    TEST_ASSERT_EQUAL_UINT32(clockMs - 50, ms);
+    TEST_ASSERT_EQUAL_UINT32(50, FrameHistory::getSpanMs());
+    TEST_ASSERT_EQUAL_UINT16(0, FrameHistory::get(FrameHistory::getCount(), out));
+}
+
+void test_oversized_frame_is_clipped(void) {
+    uint8_t big[MAX_NUM_LEDS * CHAN_PER_LED + 20];
+    memset(big, 0x5A, sizeof(big));
+    clockMs += 25;
+    FrameHistory::record(big, sizeof(big), clockMs);
+
+    uint8_t out[MAX_NUM_LEDS * CHAN_PER_LED];
+    TEST_ASSERT_EQUAL_UINT16(sizeof(out), FrameHistory::get(0, out));
+}
+
+void test_ring_keeps_the_last_capacity_frames(void) {
+    recordRun(0, FrameHistory::getCapacity() + 5, 23);
+    TEST_ASSERT_EQUAL_UINT32(FrameHistory::getCapacity(), FrameHistory::getCount());
+
+    uint8_t out[MAX_NUM_LEDS * CHAN_PER_LED];
+    uint32_t ms = 0;
+    TEST_ASSERT_EQUAL_UINT16(FRAME_LENGTH, FrameHistory::get(FrameHistory::getCapacity() - 1, out, &ms));
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)5, out[0]);
+    TEST_ASSERT_EQUAL_UINT32((FrameHistory::getCapacity() - 1) * 23, FrameHistory::getSpanMs());
+}
+
+void test_replay_plays_last_seconds_with_original_timing(void) {
+    recordRun(100, 40, 50);     // 2 s at 20 fps, tags 100..139
+    uint8_t out[MAX_NUM_LEDS * CHAN_PER_LED];
+
+    TEST_ASSERT_TRUE(FrameHistory::startReplay(1));
+    TEST_ASSERT_TRUE(FrameHistory::isReplaying());
+
+    // The last second: tags 119..139, the first one due at once
+    uint32_t start = clockMs + 10000;
+    TEST_ASSERT_EQUAL_UINT16(FRAME_LENGTH, FrameHistory::replayNext(start, out));
+    TEST_ASSERT_EQUAL_UINT8(119, out[0]);
+    TEST_ASSERT_EQUAL_UINT16(0, FrameHistory::replayNext(start + 49, out));
+    TEST_ASSERT_EQUAL_UINT16(FRAME_LENGTH, FrameHistory::replayNext(start + 50, out));
+    TEST_ASSERT_EQUAL_UINT8(120, out[0]);
+
+    uint8_t last = 0;
+    for (uint32_t t = start + 51; t <= start + 1000; t++) {
+        if (FrameHistory::replayNext(t, out) > 0) last = out[0];
+    }
+    TEST_ASSERT_EQUAL_UINT8(139, last);
+    TEST_ASSERT_FALSE(FrameHistory::isReplaying());
+    TEST_ASSERT_EQUAL_UINT16(0, FrameHistory::replayNext(start + 2000, out));
+}
+
+void test_replay_can_be_stopped(void) {
+    uint8_t out[MAX_NUM_LEDS * CHAN_PER_LED];
+    TEST_ASSERT_TRUE(FrameHistory::startReplay(2));
+    TEST_ASSERT_TRUE(FrameHistory::replayNext(clockMs, out) > 0);
+
+    FrameHistory::stopReplay();
+    TEST_ASSERT_EQUAL_UINT16(0, FrameHistory::replayNext(clockMs + 5000, out));
+    TEST_ASSERT_FALSE(FrameHistory::isReplaying());
+}
+
+void test_replay_longer_than_history_starts_at_oldest(void) {
+    uint8_t out[MAX_NUM_LEDS * CHAN_PER_LED];
+    uint32_t oldestMs = 0;
+    FrameHistory::get(FrameHistory::getCount() - 1, out, &oldestMs);
+    uint8_t oldestTag = out[0];
+
+    TEST_ASSERT_TRUE(FrameHistory::startReplay(FRAME_HISTORY_SECONDS * 10));
+    TEST_ASSERT_EQUAL_UINT16(FRAME_LENGTH, FrameHistory::replayNext(clockMs, out));
+    TEST_ASSERT_EQUAL_UINT8(oldestTag, out[0]);
+    FrameHistory::stopReplay();
+    FrameHistory::replayNext(clockMs, out);
+}
+
+// Readers copy without a lock while the network task records. Every frame is
+// filled with the low byte of its timestamp, so a copy that overlapped a
+// rewrite of its slot shows up as mixed bytes.
+void test_get_never_returns_a_torn_frame(void) {
+    const uint32_t frames = FrameHistory::getCapacity() * 3;
+    const uint32_t base = clockMs + 1000;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> torn{0};
+    std::atomic<uint32_t> copies{0};
+
+    std::thread reader([&]() {
+        uint8_t out[MAX_NUM_LEDS * CHAN_PER_LED];
+        while (!done) {
+            uint32_t ms = 0;
+            uint16_t length = FrameHistory::get(FrameHistory::getCount() - 1, out, &ms);
+            if (length == 0) continue;
+            copies++;
+            for (uint16_t i = 0; i < length; i++) {
+                if (out[i] != out[0]) torn++;
+            }
+            if (ms >= base && out[0] != (uint8_t)ms) torn++;
+        }
+    });
+
+    // At least three laps of the ring, and until the reader has had its turn
+    uint8_t data[MAX_NUM_LEDS * CHAN_PER_LED];
+    uint32_t i = 0;
+    for (; i < frames || (copies < 1000 && i < frames * 100); i++) {
+        memset(data, (uint8_t)(base + i), sizeof(data));
+        FrameHistory::record(data, sizeof(data), base + i);
+    }
+    done = true;
+    reader.join();
+    clockMs = base + i;
+
+    TEST_ASSERT_TRUE(copies > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+}
+
+int main(int argc, char** argv) {
+    HostSerial::setEcho(0, false);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_to_replay_before_recording);
+    RUN_TEST(test_history_is_placed_in_psram);
+    RUN_TEST(test_get_returns_frames_newest_first);
+    RUN_TEST(test_oversized_frame_is_clipped);
+    RUN_TEST(test_ring_keeps_the_last_capacity_frames);
+    RUN_TEST(test_replay_plays_last_seconds_with_original_timing);
+    RUN_TEST(test_replay_can_be_stopped);
+    RUN_TEST(test_replay_longer_than_history_starts_at_oldest);
+    RUN_TEST(test_get_never_returns_a_torn_frame);
+    return UNITY_END();
+}
@@ -0,0 +1,228 @@
+#include <unity.h>
+#include <string.h>
+#include <vector>
+#include "Hc12Sim.h"
+#include "RadioFrame.h"
+
+// Simulated HC-12 link: UART pacing, buffering, error injection and the
+// reference frame decoder, plus end-to-end scenario figures.
+
+#define FAR_FUTURE_US 100000000ULL
+
+static std::vector<uint8_t> pattern(size_t len) {
+    std::vector<uint8_t> data(len);
+    for (size_t i = 0; i < len; i++) data[i] = (uint8_t)(i * 37 + 11);
+    return data;
+}
+
+static std::vector<uint8_t> readAll(Hc12Link& link, uint64_t nowUs) {
+    std::vector<uint8_t> out(4096);
+    out.resize(link.read(nowUs, out.data(), out.size()));
+    return out;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_uart_paces_bytes_at_baud_rate(void) {
+    Hc12Link link;
+    std::vector<uint8_t> data = pattern(100);
+    link.write(0, data.data(), data.size());
+
+    // 8N1 at 9600 baud
+    TEST_ASSERT_EQUAL_UINT32(1042, link.byteTimeUs());
+    TEST_ASSERT_EQUAL_UINT64(100 * 1042, link.txIdleAt());
+
+    // A later write queues behind the first
+    link.write(1000, data.data(), 1);
+    TEST_ASSERT_EQUAL_UINT64(101 * 1042, link.txIdleAt());
+}
+
+void test_clean_link_delivers_every_byte_in_order(void) {
+    Hc12Link link;
+    std::vector<uint8_t> data = pattern(500);
+    link.write(0, data.data(), data.size());
+
+    std::vector<uint8_t> out = readAll(link, FAR_FUTURE_US);
+    TEST_ASSERT_EQUAL_size_t(data.size(), out.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data.data(), out.data(), data.size());
+    TEST_ASSERT_EQUAL_UINT32(9, link.stats().airPackets);   // ceil(500 / 60)
+}
+
+void test_nothing_arrives_before_air_time(void) {
+    Hc12Link link;
+    uint8_t byte = 0x42;
+    link.write(0, &byte, 1);
+
+    // UART in, idle gap, air packet, UART out
+    const Hc12LinkConfig& c = link.config();
+    uint64_t earliest = link.byteTimeUs() * (1 + c.idleGapBytes) + c.airOverheadUs +
+        8 * 1000000ULL / c.airBaud + link.byteTimeUs();
+    uint8_t out;
+    TEST_ASSERT_EQUAL_size_t(0, link.read(earliest - 1, &out, 1));
+    uint64_t when;
+    TEST_ASSERT_EQUAL_size_t(1, link.read(earliest, &out, 1, &when));
+    TEST_ASSERT_EQUAL_HEX8(0x42, out);
+    TEST_ASSERT_EQUAL_UINT64(earliest, when);
+}
+
+void test_slow_air_overflows_buffer(void) {
+    Hc12LinkConfig config;
+    config.uartBaud = 115200;
+    config.airBaud = 5000;
+    config.bufferBytes = 64;
+    Hc12Link link(config);
+    std::vector<uint8_t> data = pattern(1000);
+    link.write(0, data.data(), data.size());
+
+    std::vector<uint8_t> out = readAll(link, FAR_FUTURE_US);
+    TEST_ASSERT_TRUE(link.stats().bytesOverflowed > 0);
+    TEST_ASSERT_EQUAL_UINT64(data.size() - link.stats().bytesOverflowed, out.size());
+}
+
+void test_dropped_packets_deliver_nothing(void) {
+    Hc12LinkConfig config;
+    config.packetDropRate = 1;
+    Hc12Link link(config);
+    std::vector<uint8_t> data = pattern(200);
+    link.write(0, data.data(), data.size());
+
+    TEST_ASSERT_EQUAL_size_t(0, readAll(link, FAR_FUTURE_US).size());
+    TEST_ASSERT_EQUAL_UINT32(link.stats().airPackets, link.stats().airPacketsDropped);
+}
+
+void test_bit_errors_flip_exactly_the_counted_bits(void) {
+    Hc12LinkConfig config;
+    config.bitErrorRate = 0.01f;
+    Hc12Link link(config);
+    std::vector<uint8_t> data = pattern(1000);
+    link.write(0, data.data(), data.size());
+
+    std::vector<uint8_t> out = readAll(link, FAR_FUTURE_US);
+    TEST_ASSERT_EQUAL_size_t(data.size(), out.size());
+    uint32_t flipped = 0;
+    for (size_t i = 0; i < data.size(); i++) flipped += __builtin_popcount(data[i] ^ out[i]);
+    TEST_ASSERT_TRUE(flipped > 0);
+    TEST_ASSERT_EQUAL_UINT32(link.stats().bitErrors, flipped);
+}
+
+void test_same_seed_same_errors(void) {
+    Hc12LinkConfig config;
+    config.bitErrorRate = 0.001f;
+    config.packetDropRate = 0.1f;
+    config.seed = 1234;
+    std::vector<uint8_t> data = pattern(2000);
+
+    Hc12Link a(config);
+    Hc12Link b(config);
+    a.write(0, data.data(), data.size());
+    b.write(0, data.data(), data.size());
+    std::vector<uint8_t> outA = readAll(a, FAR_FUTURE_US);
+    std::vector<uint8_t> outB = readAll(b, FAR_FUTURE_US);
+    TEST_ASSERT_EQUAL_size_t(outA.size(), outB.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(outA.data(), outB.data(), outA.size());
+}
+
+void test_burst_state_uses_burst_rates(void) {
+    Hc12LinkConfig config;
+    config.burstEnterRate = 1;
+    config.burstExitRate = 0;
+    config.burstDropRate = 1;
+    Hc12Link link(config);
+    std::vector<uint8_t> data = pattern(300);
+    link.write(0, data.data(), data.size());
+
+    TEST_ASSERT_EQUAL_size_t(0, readAll(link, FAR_FUTURE_US).size());
+    TEST_ASSERT_EQUAL_UINT32(link.stats().airPackets, link.stats().burstPackets);
+}
+
+void test_decoder_resyncs_after_noise(void) {
+    uint8_t payload[] = {1, 2, 3, 4, 5};
+    uint8_t frame[16];
+    size_t size = RadioFrame::encode(payload, sizeof(payload), frame, sizeof(frame));
+
+    RadioFrameDecoder<> decoder;
+    const uint8_t noise[] = {0x00, 0x13, 0x77};
+    for (uint8_t b : noise) TEST_ASSERT_EQUAL_INT(RADIO_FRAME_NONE, decoder.feed(b));
+
+    RadioFrameResult result = RADIO_FRAME_NONE;
+    for (size_t i = 0; i < size; i++) result = decoder.feed(frame[i]);
+    TEST_ASSERT_EQUAL_INT(RADIO_FRAME_OK, result);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(payload), decoder.length());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, decoder.payload(), sizeof(payload));
+}
+
+void test_decoder_rejects_bad_checksum(void) {
+    uint8_t payload[] = {9, 8, 7};
+    uint8_t frame[16];
+    size_t size = RadioFrame::encode(payload, sizeof(payload), frame, sizeof(frame));
+    frame[3] ^= 0x01;
+
+    RadioFrameDecoder<> decoder;
+    RadioFrameResult result = RADIO_FRAME_NONE;
+    for (size_t i = 0; i < size; i++) result = decoder.feed(frame[i]);
+    TEST_ASSERT_EQUAL_INT(RADIO_FRAME_BAD_CHECKSUM, result);
+}
+
+void test_default_link_limits_frame_rate(void) {
+    Hc12Scenario scenario;   // 50 RGB LEDs at 30 fps
+    Hc12Report report = Hc12Sim::run(Hc12LinkConfig::forMode(HC12_FU3, 9600), scenario);
+
+    // 153-byte frames at 960 bytes/s cap the rate near 6.3 fps
+    TEST_ASSERT_TRUE(report.achievedFps > 5.0f);
+    TEST_ASSERT_TRUE(report.achievedFps < 6.3f);
+    TEST_ASSERT_TRUE(report.framesSkipped > 0);
+    TEST_ASSERT_EQUAL_UINT32(report.framesSent, report.framesDelivered);
+    TEST_ASSERT_TRUE(report.latencyP50Us > 153 * 1042);
+}
+
+void test_fast_link_keeps_up(void) {
+    Hc12Scenario scenario;
+    Hc12Report report = Hc12Sim::run(Hc12LinkConfig::forMode(HC12_FU3, 115200), scenario);
+
+    TEST_ASSERT_EQUAL_UINT32(0, report.framesSkipped);
+    TEST_ASSERT_EQUAL_UINT32(report.framesOffered, report.framesDelivered);
+    TEST_ASSERT_EQUAL_UINT32(report.latencyP50Us, report.latencyMaxUs);
+}
+
+void test_queued_frames_build_latency(void) {
+    Hc12Scenario scenario;
+    scenario.skipWhenBusy = false;
+    scenario.durationMs = 3000;
+    Hc12Report report = Hc12Sim::run(Hc12LinkConfig::forMode(HC12_FU3, 9600), scenario);
+
+    // 90 frames offered, about 6 per second drained: the last waits ~12 s
+    TEST_ASSERT_EQUAL_UINT32(report.framesOffered, report.framesDelivered);
+    TEST_ASSERT_EQUAL_UINT32(0, report.framesSkipped);
+    TEST_ASSERT_TRUE(report.latencyMaxUs > 10000000);
+}
+
+void test_errors_reduce_delivery(void) {
+    Hc12LinkConfig config = Hc12LinkConfig::forMode(HC12_FU3, 9600);
+    config.bitErrorRate = 1e-3f;
+    Hc12Report report = Hc12Sim::run(config, Hc12Scenario());
+
+    TEST_ASSERT_TRUE(report.framesCorrupt > 0);
+    TEST_ASSERT_TRUE(report.deliveryRate < 1.0f);
+    TEST_ASSERT_TRUE(report.framesDelivered + report.framesCorrupt + report.framesUndetected <= report.framesSent);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_uart_paces_bytes_at_baud_rate);
+    RUN_TEST(test_clean_link_delivers_every_byte_in_order);
+    RUN_TEST(test_nothing_arrives_before_air_time);
+    RUN_TEST(test_slow_air_overflows_buffer);
+    RUN_TEST(test_dropped_packets_deliver_nothing);
+    RUN_TEST(test_bit_errors_flip_exactly_the_counted_bits);
+    RUN_TEST(test_same_seed_same_errors);
+    RUN_TEST(test_burst_state_uses_burst_rates);
+    RUN_TEST(test_decoder_resyncs_after_noise);
+    RUN_TEST(test_decoder_rejects_bad_checksum);
+    RUN_TEST(test_default_link_limits_frame_rate);
+    RUN_TEST(test_fast_link_keeps_up);
+    RUN_TEST(test_queued_frames_build_latency);
+    RUN_TEST(test_errors_reduce_delivery);
+    return UNITY_END();
+}
@@ -0,0 +1,101 @@
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <HostShims.h>
+#include <esp_heap_caps.h>
+#include "HeapGuard.h"
+#include "Logger.h"
+#include "RadioLink.h"
+
+// HeapGuard's bookkeeping, driven through its hooks directly (this build
+// does not wrap the allocator), and the paths made allocation-free for it.
+
+static void* const CALLER = (void*)0x1234;
+
+static std::string takeConsole() {
+    std::vector<uint8_t> bytes = HostSerial::takeOutput(0);
+    return std::string(bytes.begin(), bytes.end());
+}
+
+void setUp(void) {
+    HeapGuard::setAssert(false);
+    HeapGuard::reset();
+    takeConsole();
+}
+
+void tearDown(void) {}
+
+void test_watched_allocation_is_recorded(void) {
+    HeapGuard::onAllocate(48, CALLER);
+    HeapGuard::onAllocate(100, CALLER);
+    TEST_ASSERT_EQUAL_UINT32(2, HeapGuard::getViolationCount());
+
+    HeapGuard::printReport();
+    std::string report = takeConsole();
+    TEST_ASSERT_TRUE(report.find("=== HEAP ===") != std::string::npos);
+    TEST_ASSERT_TRUE(report.find("Largest block") != std::string::npos);
+}
+
+void test_other_tasks_are_not_violations(void) {
+    std::thread other([]() { HeapGuard::onAllocate(64, CALLER); });
+    other.join();
+    TEST_ASSERT_EQUAL_UINT32(0, HeapGuard::getViolationCount());
+}
+
+void test_reset_clears_counts(void) {
+    HeapGuard::onAllocate(16, CALLER);
+    HeapGuard::onFree();
+    HeapGuard::reset();
+    TEST_ASSERT_EQUAL_UINT32(0, HeapGuard::getViolationCount());
+}
+
+void test_heap_watermarks_are_consistent(void) {
+    size_t free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_TRUE(free > 0);
+    TEST_ASSERT_TRUE(heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL) <= free);
+    TEST_ASSERT_TRUE(heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL) <= HOST_HEAP_BYTES);
+}
+
+void test_long_log_line_is_truncated_with_line_end(void) {
+    // A full message buffer plus an oversized tag overflows the line
+    char message[LOG_BUFFER_SIZE];
+    memset(message, 'x', sizeof(message) - 1);
+    message[sizeof(message) - 1] = '\0';
+    std::string tag(LOG_LINE_SIZE - LOG_BUFFER_SIZE, 'T');
+    LOG_WARN_TAG(tag.c_str(), "%s", message);
+
+    std::string line = takeConsole();
+    TEST_ASSERT_EQUAL_UINT32(LOG_LINE_SIZE - 1, line.size());
+    TEST_ASSERT_EQUAL_STRING("\r\n", line.c_str() + line.size() - 2);
+}
+
+void test_radio_begin_logs_module_reply(void) {
+    const char* reply = "OK+B9600OK+RC001OK+RP:+20dBmOK+FU3";   // Longer than the reply buffer
+    HostSerial::feedInput(HC12_UART_NUM, (const uint8_t*)reply, strlen(reply));
+    Logger::setLevel(LOG_LEVEL_DEBUG);
+    RadioLink radio;
+    radio.begin(DEFAULT_RADIO_CHANNEL);
+
+    std::string log = takeConsole();
+    TEST_ASSERT_TRUE(log.find("HC-12 response: OK+B9600OK+RC001OK+RP:+20dBm") != std::string::npos);
+    TEST_ASSERT_EQUAL(0, Serial2.available());
+}
+
+int main(int argc, char** argv) {
+    HostSerial::setEcho(0, false);
+    HostSerial::setCapture(0, true);
+    Logger::begin();
+    HeapGuard::watchCurrentTask();
+    HeapGuard::arm();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_watched_allocation_is_recorded);
+    RUN_TEST(test_other_tasks_are_not_violations);
+    RUN_TEST(test_reset_clears_counts);
+    RUN_TEST(test_heap_watermarks_are_consistent);
+    RUN_TEST(test_long_log_line_is_truncated_with_line_end);
+    RUN_TEST(test_radio_begin_logs_module_reply);
+    return UNITY_END();
+}
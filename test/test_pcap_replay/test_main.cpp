@@ -0,0 +1,144 @@
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include <HostShims.h>
+#include "PcapReplay.h"
+#include "RadioFrame.h"
+
+// Golden-output regression for the host pipeline: replaying the captures in
+// data/ must reproduce data/show.golden byte for byte. The captures come
+// from tools/pcap_replay/make_test_capture.py, which also explains how to
+// regenerate the golden file after an intended output change.
+
+static std::string dataPath(const char* name) {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.find_last_of('/') + 1);
+    return dir + "data/" + name;
+}
+
+static std::vector<uint8_t> readFile(FILE* f) {
+    std::vector<uint8_t> bytes;
+    rewind(f);
+    int c;
+    while ((c = fgetc(f)) != EOF) bytes.push_back((uint8_t)c);
+    return bytes;
+}
+
+static std::vector<uint8_t> readPath(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    TEST_ASSERT_NOT_NULL_MESSAGE(f, path.c_str());
+    std::vector<uint8_t> bytes = readFile(f);
+    fclose(f);
+    return bytes;
+}
+
+static ReplayOptions showOptions(const std::string& capture) {
+    static std::string path;
+    path = capture;
+    ReplayOptions options;
+    options.capturePath = path.c_str();
+    options.universe = 1;
+    options.numLeds = 50;
+    return options;
+}
+
+static std::vector<uint8_t> replay(const ReplayOptions& options, bool expectOk, ReplayStats& stats) {
+    FILE* out = tmpfile();
+    TEST_ASSERT_NOT_NULL(out);
+    bool ok = PcapReplay::run(options, out, stats);
+    TEST_ASSERT_EQUAL_MESSAGE(expectOk, ok, PcapReplay::error());
+    std::vector<uint8_t> bytes = readFile(out);
+    fclose(out);
+    return bytes;
+}
+
+static void assertGolden(const std::vector<uint8_t>& bytes) {
+    std::vector<uint8_t> golden = readPath(dataPath("show.golden"));
+    TEST_ASSERT_EQUAL_size_t(golden.size(), bytes.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(golden.data(), bytes.data(), golden.size());
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_pcap_matches_golden(void) {
+    ReplayStats stats;
+    assertGolden(replay(showOptions(dataPath("show.pcap")), true, stats));
+}
+
+void test_pcapng_matches_golden(void) {
+    ReplayStats stats;
+    assertGolden(replay(showOptions(dataPath("show.pcapng")), true, stats));
+}
+
+void test_stats_account_for_dropped_traffic(void) {
+    ReplayStats stats;
+    replay(showOptions(dataPath("show.pcap")), true, stats);
+
+    TEST_ASSERT_EQUAL_UINT32(67, stats.captureFrames);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.skippedFrames);     // ARP, IP fragment
+    TEST_ASSERT_EQUAL_UINT32(64, stats.datagrams);        // Art-Net is not replayed
+    TEST_ASSERT_EQUAL_UINT32(32, stats.radioFrames);      // Universe 1 data only
+    TEST_ASSERT_EQUAL_UINT64(31 * (150 + RADIO_FRAME_OVERHEAD) + 10 + RADIO_FRAME_OVERHEAD,
+                             stats.radioBytes);
+    TEST_ASSERT_EQUAL_UINT64(775000, stats.captureSpanUs);
+}
+
+void test_other_universe_sends_nothing(void) {
+    ReplayOptions options = showOptions(dataPath("show.pcap"));
+    options.universe = 3;
+    ReplayStats stats;
+    std::vector<uint8_t> bytes = replay(options, true, stats);
+
+    TEST_ASSERT_EQUAL_UINT32(64, stats.datagrams);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.radioFrames);
+    TEST_ASSERT_EQUAL_size_t(0, bytes.size());
+}
+
+void test_truncated_capture_keeps_replayed_prefix(void) {
+    std::vector<uint8_t> capture = readPath(dataPath("show.pcap"));
+    char path[] = "/tmp/replay_truncated_XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_INT((int)(capture.size() / 2), (int)write(fd, capture.data(), capture.size() / 2));
+    close(fd);
+
+    ReplayStats stats;
+    std::vector<uint8_t> bytes = replay(showOptions(path), false, stats);
+    unlink(path);
+
+    std::vector<uint8_t> golden = readPath(dataPath("show.golden"));
+    TEST_ASSERT_TRUE(stats.radioFrames > 0);
+    TEST_ASSERT_TRUE(bytes.size() < golden.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(golden.data(), bytes.data(), bytes.size());
+}
+
+void test_missing_file_fails(void) {
+    ReplayStats stats;
+    replay(showOptions(dataPath("missing.pcap")), false, stats);
+    TEST_ASSERT_EQUAL_STRING("cannot open file", PcapReplay::error());
+}
+
+void test_non_capture_file_fails(void) {
+    ReplayStats stats;
+    replay(showOptions(dataPath("show.golden")), false, stats);
+    TEST_ASSERT_EQUAL_STRING("not a pcap or pcapng file", PcapReplay::error());
+}
+
+int main(int argc, char** argv) {
+    HostSerial::setEcho(0, false);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_pcap_matches_golden);
+    RUN_TEST(test_pcapng_matches_golden);
+    RUN_TEST(test_stats_account_for_dropped_traffic);
+    RUN_TEST(test_other_universe_sends_nothing);
+    RUN_TEST(test_truncated_capture_keeps_replayed_prefix);
+    RUN_TEST(test_missing_file_fails);
+    RUN_TEST(test_non_capture_file_fails);
+    return UNITY_END();
+}
@@ -0,0 +1,259 @@
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <HostShims.h>
+#include "RadioFrame.h"
+#include "RadioLink.h"
+#include "RadioReceiver.h"
+
+// The radio codec from both ends: frames the transmitter's RadioLink puts on
+// Serial2 must come out of the reference RadioReceiver unchanged, and the
+// header-only encoder/decoder must hold their framing guarantees at every
+// payload capacity.
+
+#define RX_PORT 1   // Serial1 stands in for the wristband's UART
+
+static RadioLink radio;
+
+static void fillPayload(uint8_t* payload, uint16_t length, uint8_t seed) {
+    for (uint16_t i = 0; i < length; i++) payload[i] = (uint8_t)(i * 7 + seed);
+}
+
+// Send through the transmitter and hand the bytes to the receiving UART
+static std::vector<uint8_t> transmit(uint8_t* payload, uint16_t length) {
+    radio.sendDmxPacket(payload, length);
+    std::vector<uint8_t> bytes = HostSerial::takeOutput(HC12_UART_NUM);
+    if (!bytes.empty()) HostSerial::feedInput(RX_PORT, bytes.data(), bytes.size());
+    return bytes;
+}
+
+// Step the radio through `ms` of fake time, collecting what it wrote
+static std::string pollFor(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        HostClock::advance(1);
+        radio.poll();
+    }
+    std::vector<uint8_t> bytes = HostSerial::takeOutput(HC12_UART_NUM);
+    return std::string(bytes.begin(), bytes.end());
+}
+
+template <size_t Capacity>
+static RadioFrameResult feedAll(RadioFrameDecoder<Capacity>& decoder, const uint8_t* data, size_t len) {
+    RadioFrameResult result = RADIO_FRAME_NONE;
+    for (size_t i = 0; i < len; i++) result = decoder.feed(data[i]);
+    return result;
+}
+
+void setUp(void) {
+    HostSerial::takeOutput(HC12_UART_NUM);
+    while (Serial1.available()) Serial1.read();
+}
+
+void tearDown(void) {}
+
+void test_transmitter_frames_reach_receiver(void) {
+    RadioReceiver<MAX_NUM_LEDS * CHAN_PER_LED> receiver;
+    uint8_t payload[MAX_NUM_LEDS * CHAN_PER_LED];
+    fillPayload(payload, sizeof(payload), 3);
+
+    std::vector<uint8_t> bytes = transmit(payload, sizeof(payload));
+    TEST_ASSERT_EQUAL_size_t(sizeof(payload) + RADIO_FRAME_OVERHEAD, bytes.size());
+
+    TEST_ASSERT_TRUE(receiver.poll(Serial1, 0));
+    TEST_ASSERT_EQUAL_UINT16(sizeof(payload), receiver.length());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, receiver.frame(), sizeof(payload));
+    TEST_ASSERT_EQUAL_UINT32(1, receiver.stats().frames);
+    TEST_ASSERT_EQUAL_UINT32(0, receiver.stats().badChecksum);
+}
+
+void test_receiver_keeps_latest_of_several_frames(void) {
+    RadioReceiver<MAX_NUM_LEDS * CHAN_PER_LED> receiver;
+    uint8_t payload[30];
+    for (uint8_t seed = 0; seed < 5; seed++) {
+        fillPayload(payload, sizeof(payload), seed);
+        transmit(payload, sizeof(payload));
+    }
+
+    TEST_ASSERT_TRUE(receiver.poll(Serial1, 0));
+    TEST_ASSERT_EQUAL_UINT32(5, receiver.stats().frames);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, receiver.frame(), sizeof(payload));
+}
+
+void test_transmitter_rejects_oversized_payload(void) {
+    uint8_t payload[MAX_NUM_LEDS * CHAN_PER_LED + 1] = {};
+    TEST_ASSERT_EQUAL_size_t(0, transmit(payload, sizeof(payload)).size());
+}
+
+void test_frame_split_across_reads(void) {
+    RadioReceiver<64> receiver;
+    uint8_t payload[40];
+    fillPayload(payload, sizeof(payload), 9);
+    uint8_t frame[64];
+    size_t size = RadioFrame::encode(payload, sizeof(payload), frame, sizeof(frame));
+
+    for (size_t i = 0; i + 1 < size; i++) TEST_ASSERT_FALSE(receiver.receive(&frame[i], 1, i));
+    TEST_ASSERT_TRUE(receiver.receive(&frame[size - 1], 1, size));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, receiver.frame(), sizeof(payload));
+}
+
+void test_every_length_round_trips(void) {
+    RadioFrameEncoder<> encoder;
+    RadioFrameDecoder<> decoder;
+    uint8_t payload[RADIO_FRAME_MAX_PAYLOAD];
+    uint8_t decoded[RADIO_FRAME_MAX_PAYLOAD];
+
+    for (uint16_t length = 0; length <= RADIO_FRAME_MAX_PAYLOAD; length++) {
+        fillPayload(payload, length, (uint8_t)length);
+        size_t size = encoder.encode(payload, length);
+        TEST_ASSERT_EQUAL_size_t(length + RADIO_FRAME_OVERHEAD, size);
+
+        // Whole-frame and streaming decoders agree
+        TEST_ASSERT_EQUAL_INT(length, RadioFrame::decode(encoder.data(), size, decoded, sizeof(decoded)));
+        TEST_ASSERT_EQUAL_INT(RADIO_FRAME_OK, feedAll(decoder, encoder.data(), size));
+        TEST_ASSERT_EQUAL_UINT8(length, decoder.length());
+        if (length > 0) {
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, decoded, length);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, decoder.payload(), length);
+        }
+    }
+}
+
+void test_encoder_enforces_capacity(void) {
+    RadioFrameEncoder<8> encoder;
+    uint8_t payload[9] = {};
+    TEST_ASSERT_EQUAL_size_t(8 + RADIO_FRAME_OVERHEAD, encoder.encode(payload, 8));
+    TEST_ASSERT_EQUAL_size_t(0, encoder.encode(payload, 9));
+    TEST_ASSERT_EQUAL_size_t(0, encoder.size());
+}
+
+void test_small_decoder_skips_long_frame_whole(void) {
+    // The long frame's data is full of start bytes; a decoder that gave up
+    // at the length byte would sync on them
+    uint8_t longPayload[40];
+    memset(longPayload, RADIO_FRAME_START, sizeof(longPayload));
+    uint8_t shortPayload[4] = {1, 2, 3, 4};
+    uint8_t stream[64];
+    size_t size = RadioFrame::encode(longPayload, sizeof(longPayload), stream, sizeof(stream));
+    size_t second = RadioFrame::encode(shortPayload, sizeof(shortPayload), stream + size, sizeof(stream) - size);
+
+    RadioFrameDecoder<8> decoder;
+    TEST_ASSERT_EQUAL_INT(RADIO_FRAME_TOO_LONG, feedAll(decoder, stream, size));
+    TEST_ASSERT_EQUAL_INT(RADIO_FRAME_OK, feedAll(decoder, stream + size, second));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(shortPayload, decoder.payload(), sizeof(shortPayload));
+}
+
+void test_receiver_survives_noise_and_corruption(void) {
+    RadioReceiver<16> receiver;
+    uint8_t good[3] = {10, 20, 30};
+    uint8_t bad[3] = {40, 50, 60};
+    uint8_t stream[32];
+    size_t n = 0;
+    stream[n++] = 0x00;
+    stream[n++] = 0x55;
+    n += RadioFrame::encode(good, sizeof(good), stream + n, sizeof(stream) - n);
+    size_t badAt = n;
+    n += RadioFrame::encode(bad, sizeof(bad), stream + n, sizeof(stream) - n);
+    stream[badAt + 3] ^= 0x10;
+
+    TEST_ASSERT_TRUE(receiver.receive(stream, n, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, receiver.stats().frames);
+    TEST_ASSERT_EQUAL_UINT32(1, receiver.stats().badChecksum);
+    // The corrupt frame did not replace the good one
+    TEST_ASSERT_EQUAL_UINT16(sizeof(good), receiver.length());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(good, receiver.frame(), sizeof(good));
+}
+
+void test_receiver_drops_stalled_partial_frame(void) {
+    RadioReceiver<16> receiver;
+    uint8_t payload[8];
+    fillPayload(payload, sizeof(payload), 1);
+    uint8_t frame[16];
+    size_t size = RadioFrame::encode(payload, sizeof(payload), frame, sizeof(frame));
+
+    // A frame cut short on air, then silence, then a complete frame. Without
+    // the gap the new frame's bytes would be read as the old one's data.
+    TEST_ASSERT_FALSE(receiver.receive(frame, 5, 1000));
+    TEST_ASSERT_TRUE(receiver.receive(frame, size, 1000 + RADIO_RX_GAP_MS + 1));
+    TEST_ASSERT_EQUAL_UINT32(1, receiver.stats().stalled);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, receiver.frame(), sizeof(payload));
+    TEST_ASSERT_EQUAL_UINT32(0, receiver.msSinceFrame(1000 + RADIO_RX_GAP_MS + 1));
+}
+
+void test_retune_runs_from_poll_and_drops_frames(void) {
+    uint8_t payload[8];
+    fillPayload(payload, sizeof(payload), 5);
+    uint32_t dropped = radio.getDroppedFrames();
+
+    radio.setChannel(5);
+    TEST_ASSERT_TRUE(radio.isRetuning());
+    // Nothing reaches the UART while the module may be in AT mode
+    TEST_ASSERT_FALSE(radio.sendDmxPacket(payload, sizeof(payload)));
+    TEST_ASSERT_TRUE(HostSerial::takeOutput(HC12_UART_NUM).empty());
+    TEST_ASSERT_EQUAL_UINT32(dropped + 1, radio.getDroppedFrames());
+
+    TEST_ASSERT_EQUAL_STRING("AT+C005", pollFor(HC12_AT_ENTER_MS + 1).c_str());
+    const char* reply = "OK+C005";
+    HostSerial::feedInput(HC12_UART_NUM, (const uint8_t*)reply, strlen(reply));
+    radio.poll();   // The full reply ends the wait early
+    TEST_ASSERT_EQUAL_UINT8(5, radio.getChannel());
+
+    pollFor(HC12_AT_EXIT_MS);
+    TEST_ASSERT_FALSE(radio.isRetuning());
+    TEST_ASSERT_EQUAL_size_t(sizeof(payload) + RADIO_FRAME_OVERHEAD, transmit(payload, sizeof(payload)).size());
+}
+
+void test_unacknowledged_channel_is_not_retried(void) {
+    uint8_t confirmed = radio.getChannel();
+    uint32_t failures = radio.getChannelFailures();
+
+    radio.setChannel(confirmed + 1);
+    std::string written = pollFor(HC12_AT_ENTER_MS + HC12_AT_REPLY_MS + HC12_AT_EXIT_MS + 2);
+    TEST_ASSERT_FALSE(radio.isRetuning());
+    TEST_ASSERT_EQUAL_UINT8(confirmed, radio.getChannel());
+    TEST_ASSERT_EQUAL_UINT32(failures + 1, radio.getChannelFailures());
+    TEST_ASSERT_FALSE(written.empty());
+
+    // Every later publish asks for the same channel again
+    radio.setChannel(confirmed + 1);
+    TEST_ASSERT_FALSE(radio.isRetuning());
+    TEST_ASSERT_TRUE(pollFor(HC12_AT_ENTER_MS + 1).empty());
+    TEST_ASSERT_EQUAL_UINT32(failures + 1, radio.getChannelFailures());
+}
+
+void test_channel_reply_mismatch_is_a_failure(void) {
+    uint8_t confirmed = radio.getChannel();
+    uint8_t requested = confirmed + 2;
+    uint32_t failures = radio.getChannelFailures();
+
+    radio.setChannel(requested);
+    pollFor(HC12_AT_ENTER_MS + 1);
+    char reply[8];
+    snprintf(reply, sizeof(reply), "OK+C%03u", requested + 1);
+    HostSerial::feedInput(HC12_UART_NUM, (const uint8_t*)reply, strlen(reply));
+    pollFor(HC12_AT_EXIT_MS + 1);
+
+    TEST_ASSERT_FALSE(radio.isRetuning());
+    TEST_ASSERT_EQUAL_UINT8(confirmed, radio.getChannel());
+    TEST_ASSERT_EQUAL_UINT32(failures + 1, radio.getChannelFailures());
+}
+
+int main(int argc, char** argv) {
+    HostSerial::setEcho(0, false);
+    radio.begin(DEFAULT_RADIO_CHANNEL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_transmitter_frames_reach_receiver);
+    RUN_TEST(test_receiver_keeps_latest_of_several_frames);
+    RUN_TEST(test_transmitter_rejects_oversized_payload);
+    RUN_TEST(test_frame_split_across_reads);
+    RUN_TEST(test_every_length_round_trips);
+    RUN_TEST(test_encoder_enforces_capacity);
+    RUN_TEST(test_small_decoder_skips_long_frame_whole);
+    RUN_TEST(test_receiver_survives_noise_and_corruption);
+    RUN_TEST(test_receiver_drops_stalled_partial_frame);
+    RUN_TEST(test_retune_runs_from_poll_and_drops_frames);
+    RUN_TEST(test_unacknowledged_channel_is_not_retried);
+    RUN_TEST(test_channel_reply_mismatch_is_a_failure);
+    return UNITY_END();
+}
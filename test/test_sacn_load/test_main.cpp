@@ -0,0 +1,208 @@
+#include <unity.h>
+#include <string.h>
+#include <HostShims.h>
+#include "E131Handler.h"
+#include "SacnLoad.h"
+
+// The load generator's packets and schedule, and its traffic driven through
+// E131Handler so the receive counters are checked against known input.
+
+#define TEST_UNIVERSE 7
+
+static E131Handler* eth;
+static SacnPacket packet;
+static uint8_t dmx[DMX_MAX_CHANNELS];
+
+static SacnLoadConfig testConfig() {
+    SacnLoadConfig config;
+    config.firstUniverse = TEST_UNIVERSE;
+    config.rate = 100;
+    return config;
+}
+
+static E131HeaderStatus check(const SacnPacket& p, uint16_t& slots) {
+    if (p.size < E131_HEADER_SIZE) return (E131HeaderStatus)-1;
+    return E131Handler::parseHeader(p.data, TEST_UNIVERSE, slots);
+}
+
+void setUp(void) {
+    HostNet::reset();
+    static byte mac[] = DEFAULT_MAC;
+    eth = new E131Handler();
+    eth->begin(mac, IPAddress(DEFAULT_IP));
+    eth->setUniverse(TEST_UNIVERSE);
+}
+
+void tearDown(void) {
+    delete eth;
+    eth = nullptr;
+}
+
+void test_well_formed_packet_passes_header_checks(void) {
+    SacnLoadConfig config = testConfig();
+    config.slots = 170;
+    config.priorities = {150};
+    SacnLoadGenerator generator(config);
+    generator.next(packet);
+
+    uint16_t slots = 0;
+    TEST_ASSERT_EQUAL_INT(E131_HEADER_OK, check(packet, slots));
+    TEST_ASSERT_EQUAL_UINT16(170, slots);
+    TEST_ASSERT_EQUAL_size_t(E131_HEADER_SIZE + 170, packet.size);
+    TEST_ASSERT_EQUAL_UINT8(150, packet.data[E131_PRIORITY_OFFSET]);
+    TEST_ASSERT_EQUAL_UINT8(1, packet.data[E131_SEQUENCE_OFFSET]);
+    TEST_ASSERT_EQUAL_UINT64(0, packet.dueUs);
+}
+
+void test_each_malformed_kind_hits_its_check(void) {
+    uint8_t cid[16] = {};
+    uint16_t slots = 0;
+    size_t size = SacnLoadGenerator::buildPacket(packet.data, cid, 100, 1, TEST_UNIVERSE, 100, 0);
+
+    TEST_ASSERT_TRUE(SacnLoadGenerator::corrupt(packet.data, size, SACN_TRUNCATED) < E131_HEADER_SIZE);
+
+    SacnLoadGenerator::buildPacket(packet.data, cid, 100, 1, TEST_UNIVERSE, 100, 0);
+    SacnLoadGenerator::corrupt(packet.data, size, SACN_BAD_ACN_ID);
+    TEST_ASSERT_EQUAL_INT(E131_HEADER_NOT_DATA, E131Handler::parseHeader(packet.data, TEST_UNIVERSE, slots));
+
+    SacnLoadGenerator::buildPacket(packet.data, cid, 100, 1, TEST_UNIVERSE, 100, 0);
+    SacnLoadGenerator::corrupt(packet.data, size, SACN_BAD_START_CODE);
+    TEST_ASSERT_EQUAL_INT(E131_HEADER_BAD_START_CODE, E131Handler::parseHeader(packet.data, TEST_UNIVERSE, slots));
+
+    SacnLoadGenerator::buildPacket(packet.data, cid, 100, 1, TEST_UNIVERSE, 100, 0);
+    SacnLoadGenerator::corrupt(packet.data, size, SACN_ZERO_VALUE_COUNT);
+    TEST_ASSERT_EQUAL_INT(E131_HEADER_BAD_VALUE_COUNT, E131Handler::parseHeader(packet.data, TEST_UNIVERSE, slots));
+
+    SacnLoadGenerator::buildPacket(packet.data, cid, 100, 1, TEST_UNIVERSE, 100, 0);
+    size_t shortSize = SacnLoadGenerator::corrupt(packet.data, size, SACN_OVERSIZE_VALUE_COUNT);
+    TEST_ASSERT_EQUAL_INT(E131_HEADER_OK, E131Handler::parseHeader(packet.data, TEST_UNIVERSE, slots));
+    TEST_ASSERT_TRUE(slots > shortSize - E131_HEADER_SIZE);
+}
+
+void test_schedule_covers_sources_and_universes(void) {
+    SacnLoadConfig config = testConfig();
+    config.sources = 2;
+    config.universes = 3;
+    SacnLoadGenerator generator(config);
+    TEST_ASSERT_EQUAL_FLOAT(600, generator.offeredRate());
+
+    // One tick: every source sends every universe at once
+    uint8_t seen[2][3] = {};
+    for (int i = 0; i < 6; i++) {
+        generator.next(packet);
+        TEST_ASSERT_EQUAL_UINT64(0, packet.dueUs);
+        seen[packet.source][packet.universe - TEST_UNIVERSE]++;
+        TEST_ASSERT_EQUAL_UINT8(1, packet.sequence);
+    }
+    for (int s = 0; s < 2; s++) {
+        for (int u = 0; u < 3; u++) TEST_ASSERT_EQUAL_UINT8(1, seen[s][u]);
+    }
+
+    generator.next(packet);
+    TEST_ASSERT_EQUAL_UINT64(10000, packet.dueUs);
+    TEST_ASSERT_EQUAL_UINT8(2, packet.sequence);
+
+    // Sources differ by CID
+    SacnLoadGenerator again(config);
+    SacnPacket other;
+    again.next(packet);
+    for (int i = 0; i < 3; i++) again.next(other);
+    TEST_ASSERT_EQUAL_UINT8(1, other.source);
+    TEST_ASSERT_TRUE(memcmp(packet.data + E131_CID_OFFSET, other.data + E131_CID_OFFSET, 16) != 0);
+}
+
+void test_burst_keeps_average_rate(void) {
+    SacnLoadConfig config = testConfig();
+    config.burst = 4;
+    SacnLoadGenerator generator(config);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        generator.next(packet);
+        TEST_ASSERT_EQUAL_UINT64(0, packet.dueUs);
+        TEST_ASSERT_EQUAL_UINT8(i + 1, packet.sequence);
+    }
+    generator.next(packet);
+    TEST_ASSERT_EQUAL_UINT64(40000, packet.dueUs);
+}
+
+void test_malformed_mix_follows_rate_and_keeps_sequence(void) {
+    SacnLoadConfig config = testConfig();
+    config.malformedRate = 0.25f;
+    SacnLoadGenerator generator(config);
+
+    uint8_t lastSequence = 0;
+    uint32_t malformed = 0;
+    for (int i = 0; i < 4000; i++) {
+        generator.next(packet);
+        uint16_t slots;
+        bool accepted = packet.size >= E131_HEADER_SIZE && check(packet, slots) == E131_HEADER_OK;
+        if (packet.kind != SACN_WELL_FORMED) malformed++;
+        if (accepted) {
+            // Every packet the receiver accepts is the next in sequence
+            TEST_ASSERT_EQUAL_UINT8((uint8_t)(lastSequence + 1), packet.sequence);
+            lastSequence = packet.sequence;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT64(malformed, generator.malformed());
+    TEST_ASSERT_TRUE(malformed > 800 && malformed < 1200);
+}
+
+void test_same_seed_same_traffic(void) {
+    SacnLoadConfig config = testConfig();
+    config.malformedRate = 0.5f;
+    config.seed = 42;
+    SacnLoadGenerator a(config);
+    SacnLoadGenerator b(config);
+    SacnPacket other;
+    for (int i = 0; i < 100; i++) {
+        a.next(packet);
+        b.next(other);
+        TEST_ASSERT_EQUAL_size_t(packet.size, other.size);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(packet.data, other.data, packet.size);
+    }
+}
+
+void test_receiver_counts_generated_traffic(void) {
+    SacnLoadConfig config = testConfig();
+    config.sources = 3;
+    config.universes = 2;
+    config.malformedRate = 0.1f;
+    SacnLoadGenerator generator(config);
+
+    // Every 7th datagram never arrives
+    uint32_t accepted = 0, skipped = 0;
+    for (int i = 0; i < 2000; i++) {
+        generator.next(packet);
+        uint16_t slots;
+        bool ours = packet.size >= E131_HEADER_SIZE && check(packet, slots) == E131_HEADER_OK;
+        if (i % 7 == 6) {
+            if (ours) skipped++;
+            continue;
+        }
+        TEST_ASSERT_TRUE(HostNet::inject(E131_PORT, packet.data, packet.size));
+        eth->parsePacket(dmx);
+        if (ours) accepted++;
+    }
+
+    const E131RxStats& stats = eth->getRxStats();
+    TEST_ASSERT_EQUAL_UINT32(accepted, stats.frames);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.sources);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.outOfOrder);
+    // A gap only shows once the source's next frame arrives
+    TEST_ASSERT_TRUE(stats.sequenceLost <= skipped);
+    TEST_ASSERT_TRUE(stats.sequenceLost + 3 >= skipped);
+}
+
+int main(int argc, char** argv) {
+    HostSerial::setEcho(0, false);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_well_formed_packet_passes_header_checks);
+    RUN_TEST(test_each_malformed_kind_hits_its_check);
+    RUN_TEST(test_schedule_covers_sources_and_universes);
+    RUN_TEST(test_burst_keeps_average_rate);
+    RUN_TEST(test_malformed_mix_follows_rate_and_keeps_sequence);
+    RUN_TEST(test_same_seed_same_traffic);
+    RUN_TEST(test_receiver_counts_generated_traffic);
+    return UNITY_END();
+}
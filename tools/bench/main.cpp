@@ -0,0 +1,180 @@
+/*
+ * bench: run the hot-path microbenchmarks (lib/Bench) on the host.
+ *
+ *   pio run -e bench
+ *   .pio/build/bench/program [options]
+ *
+ *   -f FILTER      only cases whose name contains FILTER
+ *   -o FILE        write JSON results to FILE ("-" = stdout)
+ *   -b FILE        compare against a baseline written by -o
+ *   -t PERCENT     with -b: exit 1 if any case is more than PERCENT slower
+ *   -c FILE        with -b: compare FILE instead of running the cases
+ *
+ * The checked-in baseline is tools/bench/baseline-native.json. Host numbers
+ * depend on the machine: regenerate the baseline on the machine that does
+ * the comparison before relying on a threshold. The same cases run on the
+ * device with the "bench" console command.
+ *
+ * -c compares two saved runs, e.g. "bench json packet" captured from a
+ * default build and from env:hotpath_baseline:
+ *   .pio/build/bench/program -b flash.json -c iram.json
+ */
+#include <Arduino.h>
+#include <HostShims.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "Logger.h"
+
+// Print adapter so Bench::printJson() can write to a file
+class FilePrint : public Print {
+public:
+    explicit FilePrint(FILE* file) : _file(file) {}
+    size_t write(uint8_t c) override { return fputc(c, _file) == EOF ? 0 : 1; }
+    size_t write(const uint8_t* buffer, size_t size) override { return fwrite(buffer, 1, size, _file); }
+private:
+    FILE* _file;
+};
+
+// Full log line with formatting, stats and the error ring; only the UART
+// write is discarded. Host only: on the device it would flood the console.
+static void benchLoggerEmit(uint32_t iterations) {
+    LogLevel saved = Logger::getLevel();
+    Logger::setLevel(LOG_LEVEL_INFO);
+    for (uint32_t i = 0; i < iterations; i++) {
+        Logger::log(LOG_LEVEL_INFO, "BENCH", "Packet received: %d channels", (int)i);
+    }
+    Logger::setLevel(saved);
+    Bench::consume(iterations);
+}
+
+typedef std::vector<std::pair<std::string, float>> Results;   // name, ns/op in run order
+
+// Results from a file written by Bench::printJson()
+static bool loadResults(const char* path, Results& results) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        char name[64];
+        float ns;
+        const char* entry = strstr(line, "{\"name\": \"");
+        if (entry && sscanf(entry, "{\"name\": \"%63[^\"]\", \"ns_per_op\": %f", name, &ns) == 2) {
+            results.emplace_back(name, ns);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+// Returns the worst slowdown in percent
+static float compare(const Results& baselineResults, const Results& now) {
+    std::map<std::string, float> baseline(baselineResults.begin(), baselineResults.end());
+    float worst = -100.0f;
+    printf("\n=== Baseline comparison ===\n");
+    printf("%-24s %12s %12s %9s\n", "Case", "baseline", "now", "change");
+    for (const auto& result : now) {
+        const char* name = result.first.c_str();
+        auto it = baseline.find(result.first);
+        if (it == baseline.end() || it->second <= 0) {
+            printf("%-24s %12s %12.1f %9s\n", name, "-", result.second, "new");
+            continue;
+        }
+        float change = (result.second - it->second) * 100.0f / it->second;
+        if (change > worst) worst = change;
+        printf("%-24s %12.1f %12.1f %+8.1f%%\n", name, it->second, result.second, change);
+    }
+    printf("===========================\n");
+    return worst;
+}
+
+// Exit status for a comparison: 1 if the worst case is past the threshold
+static int checkRegression(float worst, float threshold) {
+    if (threshold >= 0 && worst > threshold) {
+        fprintf(stderr, "bench: slowest case regressed %.1f%% (limit %.1f%%)\n", worst, threshold);
+        return 1;
+    }
+    return 0;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: bench [-f filter] [-o results.json] [-b baseline.json [-c results.json]] [-t percent]\n");
+    exit(2);
+}
+
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    const char* outputPath = nullptr;
+    const char* baselinePath = nullptr;
+    const char* comparePath = nullptr;
+    float threshold = -1.0f;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "f:o:b:c:t:")) != -1) {
+        switch (opt) {
+            case 'f': filter = optarg; break;
+            case 'o': outputPath = optarg; break;
+            case 'b': baselinePath = optarg; break;
+            case 'c': comparePath = optarg; break;
+            case 't': threshold = (float)atof(optarg); break;
+            default: usage();
+        }
+    }
+    if (optind != argc || (comparePath && !baselinePath)) usage();
+
+    Results baseline;
+    if (baselinePath && !loadResults(baselinePath, baseline)) {
+        fprintf(stderr, "bench: cannot read %s\n", baselinePath);
+        return 1;
+    }
+    if (comparePath) {
+        Results results;
+        if (!loadResults(comparePath, results)) {
+            fprintf(stderr, "bench: cannot read %s\n", comparePath);
+            return 1;
+        }
+        return checkRegression(compare(baseline, results), threshold);
+    }
+
+    // The table goes to stdout directly; Serial output is the firmware's
+    HostSerial::setEcho(0, false);
+    Logger::begin();
+
+    Bench::addCoreCases();
+    Bench::addMemoryCases();
+    Bench::addHotPathCases();
+    Bench::add("logger/emit", benchLoggerEmit);
+    if (Bench::run(filter) == 0) {
+        fprintf(stderr, "bench: no case matches '%s'\n", filter ? filter : "");
+        return 2;
+    }
+
+    HostSerial::setEcho(0, true);
+    Bench::printReport();
+    fflush(stdout);
+
+    if (outputPath) {
+        bool toStdout = strcmp(outputPath, "-") == 0;
+        FILE* f = toStdout ? stdout : fopen(outputPath, "w");
+        if (!f) {
+            fprintf(stderr, "bench: cannot write %s\n", outputPath);
+            return 1;
+        }
+        FilePrint out(f);
+        Bench::printJson(out, "native");
+        if (!toStdout) fclose(f);
+    }
+
+    if (baselinePath) {
+        Results now;
+        for (uint8_t i = 0; i < Bench::getResultCount(); i++) {
+            now.emplace_back(Bench::getResult(i).name, Bench::getResult(i).nsPerOp);
+        }
+        return checkRegression(compare(baseline, now), threshold);
+    }
+    return 0;
+}
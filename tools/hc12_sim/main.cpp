@@ -0,0 +1,85 @@
+/*
+ * hc12_sim: push a radio frame stream through the simulated HC-12 link
+ * (lib/Hc12Sim) and report frame rate, latency and delivery.
+ *
+ *   pio run -e hc12_sim
+ *   .pio/build/hc12_sim/program [options]
+ *
+ *   -m MODE        HC-12 mode 1-4 (FU1..FU4, default 3)
+ *   -b BAUD        UART baud (default HC12_BAUD)
+ *   -n BYTES       payload bytes per frame (default MAX_NUM_LEDS * CHAN_PER_LED)
+ *   -r FPS         frames offered per second (default 30)
+ *   -d SECONDS     simulated duration (default 10)
+ *   -q             queue frames while the UART is busy instead of skipping
+ *   -e RATE        bit error rate
+ *   -p RATE        air packet drop rate
+ *   -B E,X,BER,P   bursts: enter rate, exit rate, bit error and drop rate
+ *   -a BYTES       air packet size      -k BYTES   module buffer size
+ *   -o US          air packet overhead  -s SEED    random seed
+ *
+ * Example: 50 RGB LEDs over the default link with a bursty channel
+ *   program -r 10 -e 1e-5 -B 0.02,0.3,1e-3,0.2
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Hc12Sim.h"
+#include "RadioFrame.h"
+
+static void usage() {
+    fprintf(stderr, "usage: hc12_sim [-m mode] [-b baud] [-n bytes] [-r fps] [-d seconds] [-q] "
+                    "[-e ber] [-p drop] [-B enter,exit,ber,drop] [-a bytes] [-k bytes] [-o us] [-s seed]\n");
+    exit(2);
+}
+
+int main(int argc, char** argv) {
+    Hc12Mode mode = HC12_FU3;
+    uint32_t baud = HC12_BAUD;
+    Hc12Scenario scenario;
+    Hc12LinkConfig overrides;
+    bool setAirPacket = false, setBuffer = false, setOverhead = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:b:n:r:d:qe:p:B:a:k:o:s:")) != -1) {
+        switch (opt) {
+            case 'm': mode = (Hc12Mode)atoi(optarg); break;
+            case 'b': baud = (uint32_t)atol(optarg); break;
+            case 'n': scenario.payloadBytes = (uint16_t)atoi(optarg); break;
+            case 'r': scenario.frameRate = (float)atof(optarg); break;
+            case 'd': scenario.durationMs = (uint32_t)(atof(optarg) * 1000); break;
+            case 'q': scenario.skipWhenBusy = false; break;
+            case 'e': overrides.bitErrorRate = (float)atof(optarg); break;
+            case 'p': overrides.packetDropRate = (float)atof(optarg); break;
+            case 'B':
+                if (sscanf(optarg, "%f,%f,%f,%f", &overrides.burstEnterRate, &overrides.burstExitRate,
+                           &overrides.burstBitErrorRate, &overrides.burstDropRate) != 4) usage();
+                break;
+            case 'a': overrides.airPacketBytes = (uint16_t)atoi(optarg); setAirPacket = true; break;
+            case 'k': overrides.bufferBytes = (uint16_t)atoi(optarg); setBuffer = true; break;
+            case 'o': overrides.airOverheadUs = (uint32_t)atol(optarg); setOverhead = true; break;
+            case 's': overrides.seed = (uint32_t)atol(optarg); break;
+            default: usage();
+        }
+    }
+    if (optind != argc || mode < HC12_FU1 || mode > HC12_FU4 || baud == 0) usage();
+    if (scenario.payloadBytes > RADIO_FRAME_MAX_PAYLOAD) {
+        fprintf(stderr, "hc12_sim: payload is limited to %d bytes by the frame format\n", RADIO_FRAME_MAX_PAYLOAD);
+        return 2;
+    }
+
+    Hc12LinkConfig config = Hc12LinkConfig::forMode(mode, baud);
+    config.bitErrorRate = overrides.bitErrorRate;
+    config.packetDropRate = overrides.packetDropRate;
+    config.burstEnterRate = overrides.burstEnterRate;
+    config.burstExitRate = overrides.burstExitRate;
+    config.burstBitErrorRate = overrides.burstBitErrorRate;
+    config.burstDropRate = overrides.burstDropRate;
+    config.seed = overrides.seed;
+    if (setAirPacket) config.airPacketBytes = overrides.airPacketBytes;
+    if (setBuffer) config.bufferBytes = overrides.bufferBytes;
+    if (setOverhead) config.airOverheadUs = overrides.airOverheadUs;
+
+    Hc12Report report = Hc12Sim::run(config, scenario);
+    Hc12Sim::printReport(config, scenario, report);
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * pcap_replay: feed a pcap/pcapng capture of sACN traffic through the
+ * transmitter pipeline on the host and save the radio byte stream.
+ *
+ *   pio run -e pcap_replay
+ *   .pio/build/pcap_replay/program [options] capture.pcap
+ *
+ *   -o FILE        write the radio byte stream to FILE
+ *   -u UNIVERSE    universe to accept (default DEFAULT_UNIVERSE)
+ *   -n LEDS        LEDs per frame (default DEFAULT_NUM_LEDS)
+ *   -p PORT        UDP port to replay (default E131_PORT)
+ *   -r             keep the capture's timing instead of running flat out
+ *   -s SPEED       playback rate with -r (2 = twice as fast)
+ *   -v             show the firmware log
+ *
+ * Statistics go to stderr. The exit status is non-zero if the capture could
+ * not be read in full.
+ */
+#include <Arduino.h>
+#include <HostShims.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "PcapReplay.h"
+
+static void usage() {
+    fprintf(stderr, "usage: pcap_replay [-o out.bin] [-u universe] [-n leds] [-p port] "
+                    "[-r] [-s speed] [-v] capture.pcap\n");
+    exit(2);
+}
+
+int main(int argc, char** argv) {
+    ReplayOptions options;
+    const char* outputPath = nullptr;
+    bool verbose = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "o:u:n:p:rs:v")) != -1) {
+        switch (opt) {
+            case 'o': outputPath = optarg; break;
+            case 'u': options.universe = (uint16_t)atoi(optarg); break;
+            case 'n': options.numLeds = (uint16_t)atoi(optarg); break;
+            case 'p': options.port = (uint16_t)atoi(optarg); break;
+            case 'r': options.realtime = true; break;
+            case 's': options.speed = (float)atof(optarg); break;
+            case 'v': verbose = true; break;
+            default: usage();
+        }
+    }
+    if (optind != argc - 1) usage();
+    options.capturePath = argv[optind];
+
+    HostSerial::setEcho(0, verbose);
+
+    FILE* out = nullptr;
+    if (outputPath) {
+        out = fopen(outputPath, "wb");
+        if (!out) {
+            fprintf(stderr, "pcap_replay: cannot write %s\n", outputPath);
+            return 1;
+        }
+    }
+
+    ReplayStats stats;
+    bool ok = PcapReplay::run(options, out, stats);
+    if (out) fclose(out);
+
+    PcapReplay::printStats(stats, stderr);
+    if (!ok) {
+        fprintf(stderr, "pcap_replay: %s: %s\n", options.capturePath, PcapReplay::error());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+Write the captures used by test/test_pcap_replay:
+
+  show.pcap     classic pcap, microsecond timestamps, Ethernet
+  show.pcapng   the same traffic as pcapng with nanosecond timestamps,
+                plus blocks the reader has to skip
+
+Both hold 40 Hz sACN on universe 1 (50 RGB LEDs worth of chase), and
+traffic the pipeline has to drop: another universe, E1.31 sync, per-address
+priority, Art-Net, ARP and a trailing IP fragment. One frame is 802.1Q
+tagged, one carries only 10 slots.
+
+After changing this script, regenerate the golden radio stream:
+
+  .pio/build/pcap_replay/program -u 1 -n 50 -o test/test_pcap_replay/data/show.golden \\
+      test/test_pcap_replay/data/show.pcap
+"""
+import os
+import struct
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+sys.path.insert(0, os.path.join(ROOT, "fuzz"))
+from make_seeds import data_packet, sync_packet  # noqa: E402
+
+OUT = os.path.join(ROOT, "test", "test_pcap_replay", "data")
+SRC_MAC = bytes.fromhex("020000000001")
+DST_MAC = bytes.fromhex("01005e000001")   # sACN multicast for universe 1
+SRC_IP = bytes([192, 168, 0, 10])
+START_US = 1700000000 * 1000000
+
+
+def ip_checksum(header):
+    total = sum(struct.unpack(">10H", header))
+    total = (total & 0xFFFF) + (total >> 16)
+    return (~(total + (total >> 16))) & 0xFFFF
+
+
+def ipv4(payload, dst, protocol=17, fragment=0):
+    header = struct.pack(">BBHHHBBH4s4s", 0x45, 0, 20 + len(payload), 0x1234, fragment,
+                         64, protocol, 0, SRC_IP, bytes(dst))
+    header = header[:10] + struct.pack(">H", ip_checksum(header)) + header[12:]
+    return header + payload
+
+
+def udp_frame(payload, dst_port, universe=1, vlan=None):
+    dst = [239, 255, universe >> 8, universe & 0xFF]
+    udp = struct.pack(">HHHH", 54321, dst_port, 8 + len(payload), 0) + payload
+    tag = struct.pack(">HH", 0x8100, vlan) if vlan is not None else b""
+    return DST_MAC + SRC_MAC + tag + b"\x08\x00" + ipv4(udp, dst)
+
+
+def chase(step):
+    slots = []
+    for led in range(170):
+        level = 255 if led == step % 50 else (64 if led < 50 else 0)
+        slots += [level, (led * 5) & 0xFF, (step * 8) & 0xFF]
+    return slots[:512]
+
+
+def traffic():
+    """(timestamp_us, ethernet frame) in capture order"""
+    frames = []
+    arp = b"\xff" * 6 + SRC_MAC + b"\x08\x06" + bytes(28)
+    frames.append((START_US, arp))
+
+    for step in range(30):
+        t = START_US + 1000 + step * 25000
+        frames.append((t, udp_frame(data_packet(1, chase(step), sequence=step), 5568)))
+        frames.append((t + 300, udp_frame(data_packet(2, [step] * 512, sequence=step), 5568, universe=2)))
+        if step == 5:
+            frames.append((t + 600, udp_frame(sync_packet(7000, sequence=step), 5568)))
+        if step == 10:
+            frames.append((t + 600, udp_frame(data_packet(1, [200] * 512, start_code=0xDD), 5568)))
+        if step == 15:
+            frames.append((t + 600, udp_frame(b"Art-Net\x00" + bytes(10), 6454)))
+
+    t = START_US + 1000 + 30 * 25000
+    frames.append((t, udp_frame(data_packet(1, list(range(1, 11)), sequence=30), 5568)))
+    frames.append((t + 25000, udp_frame(data_packet(1, chase(31), sequence=31), 5568, vlan=7)))
+    fragment = DST_MAC + SRC_MAC + b"\x08\x00" + ipv4(bytes(64), [239, 255, 0, 1], fragment=185)
+    frames.append((t + 25500, fragment))
+    return frames
+
+
+def write_pcap(path, frames):
+    with open(path, "wb") as f:
+        f.write(struct.pack("<IHHiIII", 0xA1B2C3D4, 2, 4, 0, 0, 65535, 1))
+        for t, frame in frames:
+            f.write(struct.pack("<IIII", t // 1000000, t % 1000000, len(frame), len(frame)))
+            f.write(frame)
+
+
+def block(block_type, body):
+    body += b"\x00" * (-len(body) % 4)
+    length = 12 + len(body)
+    return struct.pack("<II", block_type, length) + body + struct.pack("<I", length)
+
+
+def write_pcapng(path, frames):
+    comment = b"CrowdLight replay test"
+    shb_options = struct.pack("<HH", 1, len(comment)) + comment + b"\x00" * (-len(comment) % 4) + bytes(4)
+    shb = struct.pack("<IHHq", 0x1A2B3C4D, 1, 0, -1) + shb_options
+    idb_options = struct.pack("<HHB3x", 9, 1, 9) + bytes(4)   # if_tsresol = 10^-9
+    with open(path, "wb") as f:
+        f.write(block(0x0A0D0D0A, shb))
+        f.write(block(0x00000001, struct.pack("<HHI", 1, 0, 65535) + idb_options))
+        for t, frame in frames:
+            ns = t * 1000
+            f.write(block(0x00000006, struct.pack("<IIIII", 0, ns >> 32, ns & 0xFFFFFFFF,
+                                                  len(frame), len(frame)) + frame))
+        # Interface statistics: skipped
+        f.write(block(0x00000005, struct.pack("<III", 0, 0, 0) + bytes(4)))
+
+
+def main():
+    os.makedirs(OUT, exist_ok=True)
+    frames = traffic()
+    write_pcap(os.path.join(OUT, "show.pcap"), frames)
+    write_pcapng(os.path.join(OUT, "show.pcapng"), frames)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,224 @@
+/*
+ * sacn_load: offer sACN traffic at increasing rates and read back what the
+ * transmitter's receive path made of it, to chart goodput and drop rate
+ * against offered load.
+ *
+ *   pio run -e sacn_load
+ *   .pio/build/sacn_load/program [options]
+ *
+ *   -t IP          target (default 127.0.0.1)
+ *   -p PORT        sACN port (default E131_PORT)
+ *   -u UNIVERSE    first universe (default DEFAULT_UNIVERSE)
+ *   -U COUNT       universes per source (default 1)
+ *   -s COUNT       sources, each with its own CID (default 1, max SACN_MAX_SOURCES)
+ *   -P P[,P...]    priority per source (default 100)
+ *   -r RATE        packets/s per source and universe, or FROM:TO:STEP to sweep
+ *   -d SECONDS     duration of each rate step (default 5)
+ *   -n SLOTS       DMX slots per packet (default 512)
+ *   -m FRACTION    share of malformed packets (default 0)
+ *   -b FRAMES      burst: frames sent back to back per tick (default 1)
+ *   -x SEED        random seed
+ *   -q             do not query the device counters
+ *
+ * Before each step the device counters are reset with "STATS RESET" on the
+ * control port (CONTROL_UDP_PORT); afterwards "STATS" is read back. One CSV
+ * row per step goes to stdout.
+ *
+ * Against the native build over loopback:
+ *   HOST_UDP_PORTS=5568,5570 .pio/build/native/program
+ *   .pio/build/sacn_load/program -r 100:2000:100 -d 3 > load.csv
+ * Against a transmitter on the network:
+ *   .pio/build/sacn_load/program -t 192.168.0.100 -r 30:600:30
+ */
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <string>
+#include "SacnLoad.h"
+
+#define SETTLE_MS 500               // Let the device drain its socket before reading the counters
+#define REPLY_TIMEOUT_MS 1000
+
+struct DeviceStats {
+    bool valid;
+    unsigned long ms, datagrams, frames, lost, late;
+};
+
+static void usage() {
+    fprintf(stderr, "usage: sacn_load [-t ip] [-p port] [-u universe] [-U count] [-s sources] [-P prio,...] "
+                    "[-r rate | -r from:to:step] [-d seconds] [-n slots] [-m fraction] [-b frames] [-x seed] [-q]\n");
+    exit(2);
+}
+
+static uint64_t nowUs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sleepUntilUs(uint64_t us) {
+    timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) != 0) {}
+}
+
+// Send a control command and wait for the reply. Returns false on timeout.
+static bool control(int fd, const sockaddr_in& to, const char* command, char* reply, size_t size) {
+    char stale[256];
+    while (recv(fd, stale, sizeof(stale), MSG_DONTWAIT) > 0) {}
+
+    sendto(fd, command, strlen(command), 0, (const sockaddr*)&to, sizeof(to));
+    pollfd pfd = {fd, POLLIN, 0};
+    if (poll(&pfd, 1, REPLY_TIMEOUT_MS) <= 0) return false;
+    ssize_t len = recv(fd, reply, size - 1, 0);
+    if (len <= 0) return false;
+    reply[len] = '\0';
+    return true;
+}
+
+static unsigned long field(const char* reply, const char* key) {
+    std::string pattern = std::string(" ") + key + "=";
+    const char* p = strstr(reply, pattern.c_str());
+    return p ? strtoul(p + pattern.size(), nullptr, 10) : 0;
+}
+
+static DeviceStats readDevice(int fd, const sockaddr_in& to) {
+    DeviceStats stats = {};
+    char reply[256];
+    if (!control(fd, to, "STATS", reply, sizeof(reply)) || strncmp(reply, "STATS ", 6) != 0) return stats;
+    stats.valid = true;
+    stats.ms = field(reply, "ms");
+    stats.datagrams = field(reply, "datagrams");
+    stats.frames = field(reply, "frames");
+    stats.lost = field(reply, "lost");
+    stats.late = field(reply, "late");
+    return stats;
+}
+
+int main(int argc, char** argv) {
+    SacnLoadConfig config;
+    const char* target = "127.0.0.1";
+    uint16_t port = E131_PORT;
+    float rateFrom = config.rate, rateTo = config.rate, rateStep = 1;
+    float seconds = 5;
+    bool query = true;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "t:p:u:U:s:P:r:d:n:m:b:x:q")) != -1) {
+        switch (opt) {
+            case 't': target = optarg; break;
+            case 'p': port = (uint16_t)atoi(optarg); break;
+            case 'u': config.firstUniverse = (uint16_t)atoi(optarg); break;
+            case 'U': config.universes = (uint16_t)atoi(optarg); break;
+            case 's': config.sources = (uint8_t)atoi(optarg); break;
+            case 'P': {
+                config.priorities.clear();
+                for (char* p = optarg; *p != '\0';) {
+                    config.priorities.push_back((uint8_t)strtoul(p, &p, 10));
+                    if (*p == ',') p++;
+                    else if (*p != '\0') usage();
+                }
+                break;
+            }
+            case 'r': {
+                int n = sscanf(optarg, "%f:%f:%f", &rateFrom, &rateTo, &rateStep);
+                if (n == 1) rateTo = rateFrom;
+                else if (n != 3 || rateStep <= 0) usage();
+                break;
+            }
+            case 'd': seconds = (float)atof(optarg); break;
+            case 'n': config.slots = (uint16_t)atoi(optarg); break;
+            case 'm': config.malformedRate = (float)atof(optarg); break;
+            case 'b': config.burst = (uint16_t)atoi(optarg); break;
+            case 'x': config.seed = (uint32_t)atol(optarg); break;
+            case 'q': query = false; break;
+            default: usage();
+        }
+    }
+    if (optind != argc || rateFrom <= 0 || rateTo < rateFrom || seconds <= 0) usage();
+    if (config.sources == 0 || config.sources > SACN_MAX_SOURCES) {
+        fprintf(stderr, "sacn_load: 1 to %d sources\n", SACN_MAX_SOURCES);
+        return 2;
+    }
+
+    sockaddr_in data = {};
+    data.sin_family = AF_INET;
+    data.sin_port = htons(port);
+    if (inet_pton(AF_INET, target, &data.sin_addr) != 1) {
+        fprintf(stderr, "sacn_load: bad target address %s\n", target);
+        return 2;
+    }
+    sockaddr_in controlAddr = data;
+    controlAddr.sin_port = htons(CONTROL_UDP_PORT);
+
+    int dataFd = socket(AF_INET, SOCK_DGRAM, 0);
+    int controlFd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (dataFd < 0 || controlFd < 0) {
+        perror("sacn_load: socket");
+        return 1;
+    }
+    int sendBuffer = 4 * 1024 * 1024;
+    setsockopt(dataFd, SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+
+    printf("rate_pps,offered_pps,sent_pps,sent,malformed,send_errors,"
+           "device_datagrams,device_frames,device_lost,device_late,missed,goodput_fps,drop_pct\n");
+
+    static SacnPacket packet;
+    for (float rate = rateFrom; rate <= rateTo + rateStep / 2; rate += rateStep) {
+        config.rate = rate;
+        SacnLoadGenerator generator(config);
+
+        char reply[64];
+        bool reset = query && control(controlFd, controlAddr, "STATS RESET", reply, sizeof(reply));
+        if (query && !reset) fprintf(stderr, "sacn_load: no reply on control port %d, counters unavailable\n", CONTROL_UDP_PORT);
+
+        uint64_t durationUs = (uint64_t)(seconds * 1e6f);
+        uint64_t start = nowUs();
+        uint64_t sent = 0, malformed = 0, sendErrors = 0;
+        for (;;) {
+            generator.next(packet);
+            if (packet.dueUs >= durationUs) break;
+            if (start + packet.dueUs > nowUs()) sleepUntilUs(start + packet.dueUs);
+            if (sendto(dataFd, packet.data, packet.size, 0, (const sockaddr*)&data, sizeof(data)) < 0) {
+                sendErrors++;
+            } else {
+                sent++;
+                if (packet.kind != SACN_WELL_FORMED) malformed++;
+            }
+        }
+        float elapsed = (nowUs() - start) / 1e6f;
+
+        DeviceStats device = {};
+        if (reset) {
+            usleep(SETTLE_MS * 1000);
+            device = readDevice(controlFd, controlAddr);
+        }
+
+        printf("%.1f,%.1f,%.1f,%llu,%llu,%llu,", rate, generator.offeredRate(), sent / elapsed,
+               (unsigned long long)sent, (unsigned long long)malformed, (unsigned long long)sendErrors);
+        if (device.valid) {
+            unsigned long expected = device.frames + device.lost;
+            printf("%lu,%lu,%lu,%lu,%lld,%.1f,%.2f\n", device.datagrams, device.frames, device.lost, device.late,
+                   (long long)sent - (long long)device.datagrams, device.frames / elapsed,
+                   expected ? 100.0 * device.lost / expected : 0.0);
+            fprintf(stderr, "%7.1f pps offered: %lu frames (%.1f fps), %lu lost, %lld never reached the socket\n",
+                    generator.offeredRate(), device.frames, device.frames / elapsed, device.lost,
+                    (long long)sent - (long long)device.datagrams);
+        } else {
+            printf(",,,,,,\n");
+            fprintf(stderr, "%7.1f pps offered: %llu sent\n", generator.offeredRate(), (unsigned long long)sent);
+        }
+        fflush(stdout);
+    }
+
+    close(dataFd);
+    close(controlFd);
+    return 0;
+}